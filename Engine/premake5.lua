@@ -37,6 +37,9 @@ project "Engine"
         "%{IncludeDirs.fmt}",
     }
 
+    filter "system:linux"
+        links { "pthread" }
+
     filter "configurations:Debug"
         defines { "BUILD_DEBUG" }
         symbols "On"
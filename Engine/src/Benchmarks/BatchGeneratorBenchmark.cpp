@@ -0,0 +1,79 @@
+#include "Benchmarks.h"
+
+#include <thread>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Solver/BatchGenerator.h"
+
+namespace Benchmarks
+{
+	static bool IsSameLevel(const Serialization::LevelData& a, const Serialization::LevelData& b)
+	{
+		if (a.GridSize != b.GridSize
+			|| a.LockedCells.size() != b.LockedCells.size()
+			|| a.GreaterThanConstraints.size() != b.GreaterThanConstraints.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < a.LockedCells.size(); ++i)
+		{
+			const auto& lhs = a.LockedCells[i];
+			const auto& rhs = b.LockedCells[i];
+			if (lhs.X != rhs.X || lhs.Y != rhs.Y || lhs.Val != rhs.Val)
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < a.GreaterThanConstraints.size(); ++i)
+		{
+			const auto& lhs = a.GreaterThanConstraints[i];
+			const auto& rhs = b.GreaterThanConstraints[i];
+			if (lhs.X1 != rhs.X1 || lhs.Y1 != rhs.Y1 || lhs.X2 != rhs.X2 || lhs.Y2 != rhs.Y2)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void RunBatchGeneratorBenchmark(uint8_t gridSize, size_t puzzleCount)
+	{
+		const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+		fmt::print("Batch generator ({0} {1}x{1} puzzles, 1..{2} threads)\n", puzzleCount, gridSize, maxThreads);
+		fmt::print("{:>8} {:>10} {:>12} {:>9} {:>11} {:>7} {:>14}\n", "Threads", "Time (s)", "Puzzles/sec", "Speedup", "Efficiency", "Steals", "Deterministic");
+
+		Solver::GeneratorSettings settings;
+		settings.GridSize = gridSize;
+
+		std::vector<Serialization::LevelData> reference;
+		std::vector<Serialization::LevelData> levels;
+		double baseline = 0.0;
+
+		for (size_t threads = 1; threads <= maxThreads; ++threads)
+		{
+			std::vector<Serialization::LevelData>& output = (threads == 1) ? reference : levels;
+			const Solver::BatchStats stats = Solver::GenerateBatch(settings, puzzleCount, threads, output);
+
+			if (threads == 1)
+			{
+				baseline = stats.Seconds;
+			}
+
+			bool deterministic = true;
+			for (size_t i = 0; i < puzzleCount && threads > 1; ++i)
+			{
+				deterministic &= IsSameLevel(reference[i], levels[i]);
+			}
+
+			const double speedup = baseline / stats.Seconds;
+			fmt::print("{:>8} {:>10.3f} {:>12.1f} {:>8.2f}x {:>10.0f}% {:>7} {:>14}\n",
+				threads, stats.Seconds, stats.Generator.Puzzles / stats.Seconds,
+				speedup, 100.0 * speedup / threads, stats.Steals, deterministic ? "yes" : "NO");
+		}
+	}
+}
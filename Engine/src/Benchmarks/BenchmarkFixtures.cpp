@@ -0,0 +1,97 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+
+#include "Engine/GridModel.h"
+
+namespace Benchmarks
+{
+	std::vector<uint8_t> MakeLatinSquare(std::mt19937& rng, uint8_t gridSize)
+	{
+		std::vector<uint8_t> rows(gridSize), cols(gridSize), digits(gridSize);
+		std::iota(rows.begin(), rows.end(), 0);
+		std::iota(cols.begin(), cols.end(), 0);
+		std::iota(digits.begin(), digits.end(), 1);
+		std::shuffle(rows.begin(), rows.end(), rng);
+		std::shuffle(cols.begin(), cols.end(), rng);
+		std::shuffle(digits.begin(), digits.end(), rng);
+
+		std::vector<uint8_t> square((size_t)gridSize * gridSize);
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				square[y * gridSize + x] = digits[(rows[y] + cols[x]) % gridSize];
+			}
+		}
+		return square;
+	}
+
+	Serialization::LevelData MakeConstraintLevel(const std::vector<uint8_t>& solution, uint8_t gridSize)
+	{
+		Serialization::LevelData levelData;
+		levelData.GridSize = gridSize;
+
+		const auto addConstraint = [&](uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+		{
+			if (solution[y1 * gridSize + x1] > solution[y2 * gridSize + x2])
+			{
+				levelData.GreaterThanConstraints.push_back({ x1, y1, x2, y2 });
+			}
+			else
+			{
+				levelData.GreaterThanConstraints.push_back({ x2, y2, x1, y1 });
+			}
+		};
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				if ((x + y) % 4 == 0 && x + 1 < gridSize)
+				{
+					addConstraint(x, y, x + 1, y);
+				}
+				if ((x + y) % 4 == 2 && y + 1 < gridSize)
+				{
+					addConstraint(x, y, x, y + 1);
+				}
+			}
+		}
+
+		return levelData;
+	}
+
+	double PlaySolution(Engine::GridModel& model, const std::vector<uint8_t>& solution, uint8_t gridSize, bool validate)
+	{
+		model.OnChangeSelection(-model.GetSelectedCol(), -model.GetSelectedRow());
+
+		const auto start = std::chrono::steady_clock::now();
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				model.OnHandleNumber(solution[y * gridSize + x]);
+				if (validate)
+				{
+					model.Update();
+				}
+				if (x + 1 < gridSize)
+				{
+					model.OnChangeSelection(1, 0);
+				}
+			}
+
+			if (y + 1 < gridSize)
+			{
+				model.OnChangeSelection(1 - gridSize, 1);
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+}
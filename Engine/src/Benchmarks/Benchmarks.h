@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "Serialization/LevelData.h"
+
+namespace Engine
+{
+	class Application;
+	class GridModel;
+}
+
+namespace Benchmarks
+{
+	// Row/column duplicate detection: std::unordered_map path vs. bitmask kernel, sizes 4-9.
+	void RunDuplicateCheckBenchmark();
+
+	// Solves every level in the directory and reports time, node and propagation counts.
+	void RunSolverBenchmark(const std::string& directoryPath);
+
+	// Count-to-two solution search on random and generated 9x9 boards, against the editor's frame budget.
+	void RunUniquenessBenchmark();
+
+	// Seeded puzzle generation throughput for sizes 4-9 at every difficulty target.
+	void RunGeneratorBenchmark(size_t puzzleCount = 50);
+
+	// Parallel generation scaling from one thread up to the hardware thread count.
+	void RunBatchGeneratorBenchmark(uint8_t gridSize = 7, size_t puzzleCount = 400);
+
+	// Text files vs. binary files vs. a memory-mapped pack, reading levelCount copies of the directory's levels.
+	void RunLevelFormatBenchmark(const std::string& directoryPath, size_t levelCount = 2000);
+
+	// Text level parsing throughput, old stringstream parser vs. the tokenizer.
+	void RunParserBenchmark(const std::string& directoryPath, size_t iterations = 2000);
+
+	// Cost of selecting a level when it is parsed on the calling thread vs. prefetched in the background.
+	void RunPrefetchBenchmark(const std::string& directoryPath);
+
+	// Full and incremental board validation for grid sizes 4-16.
+	void RunGridSizeBenchmark();
+
+	// Bytes read and time taken by the validation scan over the grid's old array-of-structs cells vs. the
+	// structure-of-arrays board, sizes 9-16.
+	void RunBoardLayoutBenchmark();
+
+	// Boards per second of the Latin square check, scalar vs. each SIMD kernel the CPU supports.
+	void RunLatinCheckBenchmark();
+
+	// Stateless verification of submitted boards against their levels, vs. loading each into a grid.
+	void RunVerifyBenchmark();
+
+	// Time per hint while following the hint engine's placements through generated puzzles, sizes 5-9.
+	void RunHintBenchmark();
+
+	// Difficulty rating of a 10,000 level pack, one thread vs. all hardware threads.
+	void RunRatingBenchmark(size_t levelCount = 10000);
+
+	// Auto-candidate upkeep per entered number, incremental vs. a full rebuild, sizes 9-16.
+	void RunCandidateBenchmark();
+
+	// Undo and redo through a full move journal on 9x9, and the cost of encoding it.
+	void RunJournalBenchmark();
+
+	// Autosave cost per move with appended records vs. a full rewrite, and the time to load progress back.
+	void RunSaveGameBenchmark();
+
+	// Replays a recorded session through the game logic at full speed; events per second and time per frame.
+	void RunReplayBenchmark(Engine::Application& app, const std::string& recordingPath, const std::string& directoryPath);
+
+	// Sorted paths of all *.data files in a directory.
+	std::vector<std::string> FindLevelFiles(const std::string& directoryPath);
+
+	// Shuffled cyclic Latin square, row major.
+	std::vector<uint8_t> MakeLatinSquare(std::mt19937& rng, uint8_t gridSize);
+
+	// Level for a solution with no locked cells and an inequality on roughly every other neighbouring pair.
+	Serialization::LevelData MakeConstraintLevel(const std::vector<uint8_t>& solution, uint8_t gridSize);
+
+	// Enters the solution cell by cell from the top left corner and returns the time it took in ns. With
+	// validate set, the model is updated after every move as the game does each frame.
+	double PlaySolution(Engine::GridModel& model, const std::vector<uint8_t>& solution, uint8_t gridSize, bool validate);
+}
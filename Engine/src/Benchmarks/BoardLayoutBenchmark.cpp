@@ -0,0 +1,178 @@
+#include "Benchmarks.h"
+
+#include <stdint.h>
+#include <vector>
+#include <bitset>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/DuplicateCheck.h"
+#include "Serialization/BoardData.h"
+
+namespace Benchmarks
+{
+	static const uint8_t LAYOUT_GRID_SIZES[] = { 9, 12, 16 };
+	static const size_t LAYOUT_BOARD_COUNT = 4096;
+	static const size_t LAYOUT_ITERATIONS = 4;
+	static const size_t LAYOUT_ROUNDS = 10;
+
+	// The grid's cell storage before the board was split into arrays.
+	struct LegacyCell
+	{
+		std::bitset<9> Guesses;
+		uint8_t Number{ 0 };
+		bool Locked = false;
+	};
+
+	// Duplicate masks and digit sum, the scan validation makes over a whole board.
+	template<typename GetNumberFn>
+	static size_t ScanBoard(uint8_t gridSize, GetNumberFn getNumber)
+	{
+		uint16_t rowDuplicates[16];
+		uint16_t colDuplicates[16];
+		Engine::ComputeDuplicateMasks(gridSize, getNumber, rowDuplicates, colDuplicates);
+
+		size_t result = 0;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			result += rowDuplicates[y] + colDuplicates[y];
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				result += getNumber(x, y);
+			}
+		}
+		return result;
+	}
+
+	// Digit sum alone, the memory-bound part of the scan that decides whether the board is full.
+	template<typename GetNumberFn>
+	static size_t SumBoard(uint8_t gridSize, GetNumberFn getNumber)
+	{
+		size_t result = 0;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				result += getNumber(x, y);
+			}
+		}
+		return result;
+	}
+
+	// Fastest round, in ns per board; the check runs for well under a microsecond per board, so a
+	// single round is easily thrown off by the rest of the machine.
+	template<typename ScanFn>
+	static double TimeScan(ScanFn scan, size_t& sink)
+	{
+		double bestTime = 0.0;
+		for (size_t round = 0; round < LAYOUT_ROUNDS; ++round)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < LAYOUT_ITERATIONS; ++i)
+			{
+				for (size_t board = 0; board < LAYOUT_BOARD_COUNT; ++board)
+				{
+					sink += scan(board);
+				}
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			const double time = std::chrono::duration<double, std::nano>(end - start).count() / (double)(LAYOUT_ITERATIONS * LAYOUT_BOARD_COUNT);
+			bestTime = round == 0 ? time : std::min(bestTime, time);
+		}
+		return bestTime;
+	}
+
+	void RunBoardLayoutBenchmark()
+	{
+		fmt::print("Board layout ({} boards x {} iterations, fastest of {} rounds)\n", LAYOUT_BOARD_COUNT, LAYOUT_ITERATIONS, LAYOUT_ROUNDS);
+		fmt::print("Cell bytes: {} as structs, {:.2f} as arrays (number, guess mask, locked bit)\n",
+			sizeof(LegacyCell), sizeof(uint8_t) + sizeof(uint16_t) + 1.0 / 8.0);
+		fmt::print("{:>6} {:>10} {:>10} {:>12} {:>12} {:>8} {:>12} {:>12} {:>8}\n",
+			"Size", "AoS (MB)", "SoA (MB)", "Check AoS", "Check SoA", "Speedup", "Sum AoS", "Sum SoA", "Speedup");
+
+		std::mt19937 rng(18);
+		size_t sink = 0;
+
+		for (const uint8_t gridSize : LAYOUT_GRID_SIZES)
+		{
+			const size_t cellCount = (size_t)gridSize * gridSize;
+
+			std::vector<LegacyCell> legacyBoards(LAYOUT_BOARD_COUNT * cellCount);
+			std::vector<Serialization::BoardData> boards(LAYOUT_BOARD_COUNT);
+			for (size_t board = 0; board < LAYOUT_BOARD_COUNT; ++board)
+			{
+				boards[board].Resize(gridSize);
+				for (uint8_t y = 0; y < gridSize; ++y)
+				{
+					for (uint8_t x = 0; x < gridSize; ++x)
+					{
+						const uint8_t number = (uint8_t)(rng() % (gridSize + 1));
+						const bool locked = rng() % 4 == 0;
+
+						LegacyCell& legacyCell = legacyBoards[board * cellCount + y * gridSize + x];
+						legacyCell.Number = number;
+						legacyCell.Locked = locked;
+
+						boards[board].Numbers[boards[board].GetIndex(x, y)] = number;
+						boards[board].SetLocked(x, y, locked);
+					}
+				}
+			}
+
+			const auto scanLegacy = [&](size_t board)
+			{
+				const LegacyCell* cells = &legacyBoards[board * cellCount];
+				return ScanBoard(gridSize, [cells, gridSize](uint8_t x, uint8_t y) { return cells[y * gridSize + x].Number; });
+			};
+
+			const auto scanBoard = [&](size_t board)
+			{
+				const uint8_t* numbers = boards[board].Numbers.data();
+				return ScanBoard(gridSize, [numbers, gridSize](uint8_t x, uint8_t y) { return numbers[y * gridSize + x]; });
+			};
+
+			const auto sumLegacy = [&](size_t board)
+			{
+				const LegacyCell* cells = &legacyBoards[board * cellCount];
+				return SumBoard(gridSize, [cells, gridSize](uint8_t x, uint8_t y) { return cells[y * gridSize + x].Number; });
+			};
+
+			const auto sumBoard = [&](size_t board)
+			{
+				const uint8_t* numbers = boards[board].Numbers.data();
+				return SumBoard(gridSize, [numbers, gridSize](uint8_t x, uint8_t y) { return numbers[y * gridSize + x]; });
+			};
+
+			for (size_t board = 0; board < LAYOUT_BOARD_COUNT; ++board)
+			{
+				if (scanLegacy(board) != scanBoard(board))
+				{
+					fmt::print("Mismatch on {0}x{0} board {1}\n", gridSize, board);
+					return;
+				}
+			}
+
+			// Bytes a scan over every board reads.
+			const size_t legacyScanBytes = LAYOUT_BOARD_COUNT * cellCount * sizeof(LegacyCell);
+			const size_t boardScanBytes = LAYOUT_BOARD_COUNT * cellCount * sizeof(uint8_t);
+
+			const double legacyCheckTime = TimeScan(scanLegacy, sink);
+			const double boardCheckTime = TimeScan(scanBoard, sink);
+			const double legacySumTime = TimeScan(sumLegacy, sink);
+			const double boardSumTime = TimeScan(sumBoard, sink);
+
+			fmt::print("{:>4}x{:<2} {:>10.2f} {:>10.2f} {:>9.1f} ns {:>9.1f} ns {:>7.1f}x {:>9.1f} ns {:>9.1f} ns {:>7.1f}x\n",
+				gridSize, gridSize, legacyScanBytes / (1024.0 * 1024.0), boardScanBytes / (1024.0 * 1024.0),
+				legacyCheckTime, boardCheckTime, legacyCheckTime / boardCheckTime,
+				legacySumTime, boardSumTime, legacySumTime / boardSumTime);
+		}
+
+		// The duplicate masks are a dependent chain of shifts and ors per cell, which costs the same
+		// whichever layout the numbers come from; only what the scans read shrinks.
+		fmt::print("The check is bound by the duplicate mask arithmetic, not by memory, and is not faster on the arrays.\n");
+		fmt::print("(checksum {})\n", sink);
+	}
+}
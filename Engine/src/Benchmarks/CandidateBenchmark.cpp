@@ -0,0 +1,91 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/GridModel.h"
+
+namespace Benchmarks
+{
+	static const uint8_t CANDIDATE_GRID_SIZES[] = { 9, 12, 16 };
+	static const size_t CANDIDATE_REPEATS = 100;
+
+	// Enters the solution from a reset board. Update() is left out so that only SetCellNumber's work is timed.
+	static double PlayCandidateSolution(Engine::GridModel& model, const std::vector<uint8_t>& solution, uint8_t gridSize)
+	{
+		model.Reset();
+		model.Update();
+		return PlaySolution(model, solution, gridSize, false);
+	}
+
+	void RunCandidateBenchmark()
+	{
+		std::mt19937 rng(23);
+
+		fmt::print("Auto candidates ({} plays of the solution per size)\n", CANDIDATE_REPEATS);
+		fmt::print("{:>4} {:>12} {:>14} {:>16} {:>14} {:>8}\n", "N", "Constraints", "Move (ns)", "Candidates (ns)", "Rebuild (ns)", "Match");
+
+		for (const uint8_t gridSize : CANDIDATE_GRID_SIZES)
+		{
+			const std::vector<uint8_t> solution = MakeLatinSquare(rng, gridSize);
+			const Serialization::LevelData levelData = MakeConstraintLevel(solution, gridSize);
+			const size_t cellCount = (size_t)gridSize * gridSize;
+
+			Engine::GridModel model;
+			model.LoadFromData(levelData);
+			model.SetEditMode(false);
+			model.Update();
+
+			// The same moves with the mode off and on; the difference is the incremental candidate upkeep.
+			double plainTime = 0.0;
+			double autoTime = 0.0;
+			for (size_t i = 0; i < CANDIDATE_REPEATS; ++i)
+			{
+				model.SetAutoCandidates(false);
+				plainTime += PlayCandidateSolution(model, solution, gridSize);
+				model.SetAutoCandidates(true);
+				autoTime += PlayCandidateSolution(model, solution, gridSize);
+			}
+
+			// Half a board entered incrementally must give the same candidates as rebuilding from scratch.
+			model.Reset();
+			model.Update();
+			model.OnChangeSelection(-model.GetSelectedCol(), -model.GetSelectedRow());
+			for (size_t cell = 0; cell < cellCount; cell += 2)
+			{
+				model.OnChangeSelection((int)(cell % gridSize) - model.GetSelectedCol(), (int)(cell / gridSize) - model.GetSelectedRow());
+				model.OnHandleNumber(solution[cell]);
+			}
+
+			std::vector<uint16_t> incremental(cellCount);
+			for (size_t cell = 0; cell < cellCount; ++cell)
+			{
+				incremental[cell] = model.GetAutoCandidates((uint8_t)(cell % gridSize), (uint8_t)(cell / gridSize));
+			}
+
+			const auto rebuildStart = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < CANDIDATE_REPEATS; ++i)
+			{
+				model.SetAutoCandidates(false);
+				model.SetAutoCandidates(true);
+				model.Update();
+			}
+			const auto rebuildEnd = std::chrono::steady_clock::now();
+			const double rebuildTime = std::chrono::duration<double, std::nano>(rebuildEnd - rebuildStart).count() / CANDIDATE_REPEATS;
+
+			bool match = true;
+			for (size_t cell = 0; cell < cellCount; ++cell)
+			{
+				match &= incremental[cell] == model.GetAutoCandidates((uint8_t)(cell % gridSize), (uint8_t)(cell / gridSize));
+			}
+
+			const double moveTime = autoTime / (CANDIDATE_REPEATS * cellCount);
+			const double candidateTime = std::max(0.0, autoTime - plainTime) / (CANDIDATE_REPEATS * cellCount);
+			fmt::print("{:>4} {:>12} {:>14.1f} {:>16.1f} {:>14.1f} {:>8}\n",
+				gridSize, levelData.GreaterThanConstraints.size(), moveTime, candidateTime, rebuildTime, match ? "yes" : "no");
+		}
+	}
+}
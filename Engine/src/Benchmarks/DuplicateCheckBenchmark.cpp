@@ -0,0 +1,155 @@
+#include "Benchmarks.h"
+
+#include <stdint.h>
+#include <vector>
+#include <bitset>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include <fmt/core.h>
+
+#include "Engine/DuplicateCheck.h"
+
+namespace Benchmarks
+{
+	using ErrorBits = std::bitset<99>;
+
+	static const size_t BOARD_COUNT = 256;
+	static const size_t ITERATIONS = 2000;
+
+	// Same layout as Grid::m_Errors: rows at 0, columns at 9, cells at 18 with a stride of 9.
+	static void MarkRow(ErrorBits& errors, uint8_t row, bool hasError = true) { errors.set(row, hasError); }
+	static void MarkCol(ErrorBits& errors, uint8_t col, bool hasError = true) { errors.set(9 + col, hasError); }
+	static void MarkCell(ErrorBits& errors, uint8_t x, uint8_t y, bool hasError = true) { errors.set(18 + 9 * y + x, hasError); }
+
+	// The row/column part of Grid::CheckConstraints before the bitmask kernel.
+	static void CheckWithMaps(const uint8_t* numbers, uint8_t gridSize, ErrorBits& errors)
+	{
+		errors.reset();
+
+		std::unordered_map<uint8_t, uint8_t> rowState;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			rowState.clear();
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint8_t number = numbers[y * gridSize + x];
+				if (number == 0)
+				{
+					continue;
+				}
+
+				if (rowState.find(number) != rowState.end())
+				{
+					MarkRow(errors, y);
+					MarkCell(errors, rowState.at(number), y);
+					MarkCell(errors, x, y);
+				}
+
+				rowState.emplace(number, x);
+			}
+		}
+
+		std::unordered_map<uint8_t, uint8_t> colState;
+		for (uint8_t x = 0; x < gridSize; ++x)
+		{
+			colState.clear();
+			for (uint8_t y = 0; y < gridSize; ++y)
+			{
+				const uint8_t number = numbers[y * gridSize + x];
+				if (number == 0)
+				{
+					continue;
+				}
+
+				if (colState.find(number) != colState.end())
+				{
+					MarkCol(errors, x);
+					MarkCell(errors, x, colState.at(number));
+					MarkCell(errors, x, y);
+				}
+
+				colState.emplace(number, y);
+			}
+		}
+	}
+
+	static void CheckWithMasks(const uint8_t* numbers, uint8_t gridSize, ErrorBits& errors)
+	{
+		uint16_t rowDuplicates[16];
+		uint16_t colDuplicates[16];
+		Engine::ComputeDuplicateMasks(gridSize,
+			[numbers, gridSize](uint8_t x, uint8_t y) { return numbers[y * gridSize + x]; },
+			rowDuplicates, colDuplicates);
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			MarkRow(errors, y, rowDuplicates[y] != 0);
+			MarkCol(errors, y, colDuplicates[y] != 0);
+
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint16_t bit = Engine::DigitBit(numbers[y * gridSize + x]);
+				MarkCell(errors, x, y, ((rowDuplicates[y] | colDuplicates[x]) & bit) != 0);
+			}
+		}
+	}
+
+	template<typename CheckFn>
+	static double TimeCheck(const std::vector<uint8_t>& boards, uint8_t gridSize, CheckFn check, size_t& sink)
+	{
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		ErrorBits errors;
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < ITERATIONS; ++i)
+		{
+			for (size_t board = 0; board < BOARD_COUNT; ++board)
+			{
+				check(&boards[board * cellCount], gridSize, errors);
+				sink += errors.count();
+			}
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / (double)(ITERATIONS * BOARD_COUNT);
+	}
+
+	void RunDuplicateCheckBenchmark()
+	{
+		fmt::print("Duplicate check ({} boards x {} iterations)\n", BOARD_COUNT, ITERATIONS);
+		fmt::print("{:>6} {:>14} {:>14} {:>9}\n", "Size", "Map (ns)", "Bitmask (ns)", "Speedup");
+
+		std::mt19937 rng(1234);
+		size_t sink = 0;
+
+		for (uint8_t gridSize = 4; gridSize <= 9; ++gridSize)
+		{
+			const size_t cellCount = (size_t)gridSize * gridSize;
+			std::vector<uint8_t> boards(BOARD_COUNT * cellCount);
+			for (auto& number : boards)
+			{
+				number = (uint8_t)(rng() % (gridSize + 1));
+			}
+
+			ErrorBits expected, actual;
+			for (size_t board = 0; board < BOARD_COUNT; ++board)
+			{
+				CheckWithMaps(&boards[board * cellCount], gridSize, expected);
+				CheckWithMasks(&boards[board * cellCount], gridSize, actual);
+				if (expected != actual)
+				{
+					fmt::print("Mismatch on {0}x{0} board {1}\n", gridSize, board);
+					return;
+				}
+			}
+
+			const double mapTime = TimeCheck(boards, gridSize, CheckWithMaps, sink);
+			const double maskTime = TimeCheck(boards, gridSize, CheckWithMasks, sink);
+
+			fmt::print("{:>4}x{:<1} {:>14.1f} {:>14.1f} {:>8.1f}x\n", gridSize, gridSize, mapTime, maskTime, mapTime / maskTime);
+		}
+
+		fmt::print("(checksum {})\n", sink);
+	}
+}
@@ -0,0 +1,52 @@
+#include "Benchmarks.h"
+
+#include <chrono>
+#include <fmt/core.h>
+
+#include "Solver/Generator.h"
+
+namespace Benchmarks
+{
+	void RunGeneratorBenchmark(size_t puzzleCount)
+	{
+		fmt::print("Generator ({} puzzles per row, single thread)\n", puzzleCount);
+		fmt::print("{:>6} {:>10} {:>12} {:>13} {:>8} {:>12} {:>9}\n", "Size", "Difficulty", "Puzzles/sec", "Puzzles/min", "Givens", "Constraints", "Checks");
+
+		const Solver::Difficulty difficulties[] = { Solver::Difficulty::EASY, Solver::Difficulty::MEDIUM, Solver::Difficulty::HARD };
+
+		Solver::PuzzleGenerator generator;
+		Serialization::LevelData levelData;
+
+		for (uint8_t gridSize = 4; gridSize <= 9; ++gridSize)
+		{
+			for (const Solver::Difficulty difficulty : difficulties)
+			{
+				Solver::GeneratorSettings settings;
+				settings.GridSize = gridSize;
+				settings.TargetDifficulty = difficulty;
+
+				generator.ResetStats();
+				size_t givens = 0, constraints = 0;
+
+				const auto start = std::chrono::steady_clock::now();
+				for (size_t i = 0; i < puzzleCount; ++i)
+				{
+					generator.Generate(settings, i, levelData);
+					givens += levelData.LockedCells.size();
+					constraints += levelData.GreaterThanConstraints.size();
+				}
+				const auto end = std::chrono::steady_clock::now();
+
+				const double seconds = std::chrono::duration<double>(end - start).count();
+				const Solver::GeneratorStats& stats = generator.GetStats();
+				const double puzzlesPerSecond = stats.Puzzles / seconds;
+
+				fmt::print("{:>4}x{:<1} {:>10} {:>12.1f} {:>13.0f} {:>8.1f} {:>12.1f} {:>9}\n",
+					gridSize, gridSize, Solver::ToString(difficulty),
+					puzzlesPerSecond, 60.0 * puzzlesPerSecond,
+					(double)givens / puzzleCount, (double)constraints / puzzleCount,
+					stats.UniquenessChecks / puzzleCount);
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/GridModel.h"
+
+namespace Benchmarks
+{
+	static const uint8_t GRID_SIZES[] = { 4, 6, 8, 9, 10, 12, 14, 16 };
+	static const size_t GRID_SIZE_REPEATS = 200;
+
+	void RunGridSizeBenchmark()
+	{
+		std::mt19937 rng(17);
+
+		fmt::print("Grid sizes ({} repeats per size)\n", GRID_SIZE_REPEATS);
+		fmt::print("{:>4} {:>12} {:>14} {:>14} {:>14} {:>14} {:>6}\n", "N", "Constraints", "Rebuild (us)", "ns/cell", "Move (ns)", "ns/N", "Won");
+
+		for (const uint8_t gridSize : GRID_SIZES)
+		{
+			const std::vector<uint8_t> solution = MakeLatinSquare(rng, gridSize);
+			const Serialization::LevelData levelData = MakeConstraintLevel(solution, gridSize);
+
+			Engine::GridModel model;
+			model.LoadFromData(levelData);
+			model.SetEditMode(false);
+			model.Update();
+
+			// Incremental validation: each entered digit only re-checks its row, column and constraints.
+			double moveTime = 0.0;
+			for (size_t i = 0; i < GRID_SIZE_REPEATS; ++i)
+			{
+				model.Reset();
+				model.Update();
+				moveTime += PlaySolution(model, solution, gridSize, true);
+			}
+			const bool won = model.PlayerWon();
+
+			// Full validation of the solved board, as after leaving the editor or loading a level.
+			const auto rebuildStart = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < GRID_SIZE_REPEATS; ++i)
+			{
+				model.SetEditMode(true);
+				model.SetEditMode(false);
+				model.Update();
+			}
+			const auto rebuildEnd = std::chrono::steady_clock::now();
+			const double rebuildTime = std::chrono::duration<double, std::micro>(rebuildEnd - rebuildStart).count() / GRID_SIZE_REPEATS;
+
+			const size_t cellCount = (size_t)gridSize * gridSize;
+			const double timePerMove = moveTime / (GRID_SIZE_REPEATS * cellCount);
+			fmt::print("{:>4} {:>12} {:>14.2f} {:>14.2f} {:>14.1f} {:>14.2f} {:>6}\n",
+				gridSize, levelData.GreaterThanConstraints.size(), rebuildTime, rebuildTime * 1.0e3 / cellCount,
+				timePerMove, timePerMove / gridSize, won ? "yes" : "no");
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Serialization/BoardData.h"
+#include "Solver/Generator.h"
+#include "Solver/HintEngine.h"
+
+namespace Benchmarks
+{
+	static const uint8_t HINT_GRID_SIZES[] = { 5, 7, 9 };
+	static const size_t HINT_PUZZLE_COUNT = 40;
+	static const double HINT_BUDGET_US = 1000.0;
+
+	// Generates puzzles and follows the placement hints from the givens until the engine runs out of them.
+	void RunHintBenchmark()
+	{
+		fmt::print("Hint engine ({} generated HARD puzzles per size, placements applied until no hint is left)\n", HINT_PUZZLE_COUNT);
+		fmt::print("{:>6} {:>8} {:>10} {:>12} {:>12} {:>8}\n", "Size", "Hints", "Solved", "Mean us", "Max us", "Budget");
+
+		Solver::PuzzleGenerator generator;
+		Solver::HintEngine hintEngine;
+		Serialization::LevelData levelData;
+		Serialization::BoardData board;
+		size_t ruleCounts[(size_t)Solver::HintRule::CHAIN_BOUND + 1] = { 0 };
+
+		for (const uint8_t gridSize : HINT_GRID_SIZES)
+		{
+			Solver::GeneratorSettings settings;
+			settings.GridSize = gridSize;
+			settings.TargetDifficulty = Solver::Difficulty::HARD;
+			settings.Seed = 21;
+
+			size_t hintCount = 0;
+			size_t solvedCount = 0;
+			double totalTime = 0.0;
+			double maxTime = 0.0;
+
+			for (size_t i = 0; i < HINT_PUZZLE_COUNT; ++i)
+			{
+				if (!generator.Generate(settings, i, levelData) || !Serialization::LoadLockedCells(levelData, board))
+				{
+					continue;
+				}
+
+				for (size_t step = 0; step <= board.GetCellCount(); ++step)
+				{
+					const auto start = std::chrono::steady_clock::now();
+					const Solver::Hint& hint = hintEngine.FindHint(board, levelData.GreaterThanConstraints);
+					const auto end = std::chrono::steady_clock::now();
+
+					const double time = std::chrono::duration<double, std::micro>(end - start).count();
+					totalTime += time;
+					maxTime = std::max(maxTime, time);
+					hintCount++;
+					ruleCounts[(size_t)hint.Rule]++;
+
+					if (hint.Number == 0)
+					{
+						break;
+					}
+					board.Numbers[board.GetIndex(hint.Cell.X, hint.Cell.Y)] = hint.Number;
+				}
+
+				solvedCount += std::count(board.Numbers.begin(), board.Numbers.end(), 0) == 0;
+			}
+
+			fmt::print("{:>4}x{:<2} {:>8} {:>6}/{:<3} {:>12.2f} {:>12.2f} {:>8}\n",
+				gridSize, gridSize, hintCount, solvedCount, HINT_PUZZLE_COUNT, totalTime / std::max<size_t>(hintCount, 1), maxTime,
+				maxTime < HINT_BUDGET_US ? "ok" : "over");
+		}
+
+		fmt::print("Hints by rule:");
+		for (size_t rule = 0; rule <= (size_t)Solver::HintRule::CHAIN_BOUND; ++rule)
+		{
+			fmt::print(" {} {}{}", Solver::ToString((Solver::HintRule)rule), ruleCounts[rule], rule < (size_t)Solver::HintRule::CHAIN_BOUND ? "," : "\n");
+		}
+	}
+}
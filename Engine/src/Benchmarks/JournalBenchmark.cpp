@@ -0,0 +1,103 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/GridModel.h"
+
+namespace Benchmarks
+{
+	static const uint8_t JOURNAL_GRID_SIZE = 9;
+	static const size_t JOURNAL_MOVES = 100000;
+
+	static double ElapsedNs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void RunJournalBenchmark()
+	{
+		Serialization::LevelData levelData;
+		levelData.GridSize = JOURNAL_GRID_SIZE;
+
+		Engine::GridModel model;
+		model.LoadFromData(levelData);
+		model.SetEditMode(false);
+		model.Update();
+
+		// Random numbers and guesses on random cells, more moves than the journal holds.
+		std::mt19937 rng(24);
+		std::uniform_int_distribution<int> cellDistribution(0, JOURNAL_GRID_SIZE - 1);
+		std::uniform_int_distribution<int> digitDistribution(1, JOURNAL_GRID_SIZE);
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < JOURNAL_MOVES; ++i)
+		{
+			model.OnChangeSelection(cellDistribution(rng) - model.GetSelectedCol(), cellDistribution(rng) - model.GetSelectedRow());
+			model.SetAltMode(i % 3 == 0);
+			model.OnHandleNumber((uint8_t)digitDistribution(rng));
+		}
+		const double moveTime = ElapsedNs(start) / JOURNAL_MOVES;
+		model.SetAltMode(false);
+
+		const Engine::MoveJournal& journal = model.GetJournal();
+		const Serialization::BoardData finalBoard = model.GetBoard();
+		const size_t heldEntries = journal.GetEntryCount();
+
+		size_t undoSteps = 0;
+		start = std::chrono::steady_clock::now();
+		while (model.Undo())
+		{
+			undoSteps++;
+		}
+		const double undoTime = ElapsedNs(start) / std::max<size_t>(undoSteps, 1);
+
+		size_t redoSteps = 0;
+		start = std::chrono::steady_clock::now();
+		while (model.Redo())
+		{
+			redoSteps++;
+		}
+		const double redoTime = ElapsedNs(start) / std::max<size_t>(redoSteps, 1);
+		const bool restored = model.GetBoard().Numbers == finalBoard.Numbers && model.GetBoard().Guesses == finalBoard.Guesses;
+
+		// Encoded next to a save game, and read back into a fresh grid of the same level.
+		std::vector<uint8_t> bytes;
+		start = std::chrono::steady_clock::now();
+		journal.Encode(JOURNAL_GRID_SIZE, bytes);
+		const double encodeTime = ElapsedNs(start) / 1000.0;
+
+		Engine::GridModel loadedModel;
+		loadedModel.LoadFromData(levelData);
+		start = std::chrono::steady_clock::now();
+		const bool decoded = loadedModel.LoadJournal(bytes.data(), bytes.size());
+		const double decodeTime = ElapsedNs(start) / 1000.0;
+
+		// Undoing and redoing a given's value in the editor has to recheck uniqueness; two locked 1s
+		// in a row have no solution.
+		Engine::GridModel editorModel;
+		editorModel.LoadFromData(levelData);
+		editorModel.SetEditMode(true);
+		editorModel.OnChangeSelection(-editorModel.GetSelectedCol(), -editorModel.GetSelectedRow());
+		editorModel.OnHandleNumber(1);
+		editorModel.OnChangeSelection(1, 0);
+		editorModel.OnHandleNumber(1);
+		bool givensRechecked = editorModel.CheckUniqueness() == Solver::Uniqueness::NO_SOLUTION;
+		editorModel.OnHandleNumber(2);
+		givensRechecked &= editorModel.CheckUniqueness() == Solver::Uniqueness::MULTIPLE;
+		givensRechecked &= editorModel.Undo() && editorModel.CheckUniqueness() == Solver::Uniqueness::NO_SOLUTION;
+		givensRechecked &= editorModel.Redo() && editorModel.CheckUniqueness() == Solver::Uniqueness::MULTIPLE;
+
+		fmt::print("Move journal ({} random moves on an empty {}x{} board)\n", JOURNAL_MOVES, JOURNAL_GRID_SIZE, JOURNAL_GRID_SIZE);
+		fmt::print("  Move (with journal)  {:>10.1f} ns\n", moveTime);
+		fmt::print("  Entries held         {:>10} of {} ({} KiB, fixed)\n", heldEntries, journal.GetCapacity(), journal.GetMemoryUsage() / 1024);
+		fmt::print("  Undo                 {:>10.1f} ns per step, {} steps\n", undoTime, undoSteps);
+		fmt::print("  Redo                 {:>10.1f} ns per step, {} steps, board {}\n", redoTime, redoSteps, restored ? "restored" : "differs");
+		fmt::print("  Encode               {:>10.1f} us, {} bytes\n", encodeTime, bytes.size());
+		fmt::print("  Decode               {:>10.1f} us, {}\n", decodeTime, decoded ? "ok" : "failed");
+		fmt::print("  Given undo/redo      {:>10}\n", givensRechecked ? "rechecked" : "stale");
+	}
+}
@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Solver/LatinCheck.h"
+
+namespace Benchmarks
+{
+	static const uint8_t LATIN_GRID_SIZES[] = { 4, 5, 6, 9, 10, 12, 16 };
+	static const size_t LATIN_BOARD_COUNT = 4096;
+	static const size_t LATIN_ITERATIONS = 50;
+
+	// Shuffled cyclic Latin squares; every other one gets a cell overwritten with another digit.
+	static std::vector<uint8_t> MakeSubmittedBoards(std::mt19937& rng, uint8_t gridSize)
+	{
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		std::vector<uint8_t> boards(LATIN_BOARD_COUNT * cellCount);
+
+		for (size_t board = 0; board < LATIN_BOARD_COUNT; ++board)
+		{
+			const std::vector<uint8_t> square = MakeLatinSquare(rng, gridSize);
+			uint8_t* numbers = &boards[board * cellCount];
+			std::copy(square.begin(), square.end(), numbers);
+
+			if (board % 2 == 1 && gridSize > 1)
+			{
+				uint8_t& number = numbers[rng() % cellCount];
+				number = (uint8_t)(number % gridSize + 1);
+			}
+		}
+
+		return boards;
+	}
+
+	static double TimeCheck(const std::vector<uint8_t>& boards, uint8_t gridSize, size_t& sink)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < LATIN_ITERATIONS; ++i)
+		{
+			sink += Solver::CheckLatinSquares(boards.data(), gridSize, LATIN_BOARD_COUNT);
+		}
+		const auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+	void RunLatinCheckBenchmark()
+	{
+		const Solver::SimdLevel supportedLevel = Solver::GetSupportedSimdLevel();
+
+		fmt::print("Latin square check ({} boards x {} iterations, CPU supports {})\n",
+			LATIN_BOARD_COUNT, LATIN_ITERATIONS, Solver::ToString(supportedLevel));
+		fmt::print("{:>6} {:>11} {:>16} {:>12} {:>9}\n", "Size", "Kernel", "Boards/sec", "ns/board", "Speedup");
+
+		std::mt19937 rng(19);
+		size_t sink = 0;
+
+		for (const uint8_t gridSize : LATIN_GRID_SIZES)
+		{
+			const std::vector<uint8_t> boards = MakeSubmittedBoards(rng, gridSize);
+
+			double scalarTime = 0.0;
+			size_t expectedValid = 0;
+			for (uint8_t level = 0; level <= (uint8_t)supportedLevel; ++level)
+			{
+				const Solver::SimdLevel simdLevel = Solver::SetLatinCheckLevel((Solver::SimdLevel)level);
+
+				const size_t validCount = Solver::CheckLatinSquares(boards.data(), gridSize, LATIN_BOARD_COUNT);
+				if (level == 0)
+				{
+					expectedValid = validCount;
+				}
+				else if (validCount != expectedValid)
+				{
+					fmt::print("{0}x{0}: {1} found {2} valid boards, scalar found {3}\n", gridSize, Solver::ToString(simdLevel), validCount, expectedValid);
+					Solver::ResetLatinCheckLevel();
+					return;
+				}
+
+				const double time = TimeCheck(boards, gridSize, sink);
+				const double boardsChecked = (double)(LATIN_ITERATIONS * LATIN_BOARD_COUNT);
+				if (level == 0)
+				{
+					scalarTime = time;
+				}
+
+				fmt::print("{:>4}x{:<2} {:>11} {:>16.0f} {:>12.1f} {:>8.1f}x\n",
+					gridSize, gridSize, Solver::ToString(simdLevel), boardsChecked / time, time * 1.0e9 / boardsChecked, scalarTime / time);
+			}
+
+			// What IsLatinSquare runs without a forced level, named after the kernel it picked.
+			Solver::ResetLatinCheckLevel();
+			const double time = TimeCheck(boards, gridSize, sink);
+			const double boardsChecked = (double)(LATIN_ITERATIONS * LATIN_BOARD_COUNT);
+			const std::string autoName = fmt::format("Auto/{}", Solver::ToString(Solver::GetLatinCheckLevel(gridSize)));
+			fmt::print("{:>4}x{:<2} {:>11} {:>16.0f} {:>12.1f} {:>8.1f}x\n",
+				gridSize, gridSize, autoName, boardsChecked / time, time * 1.0e9 / boardsChecked, scalarTime / time);
+		}
+
+		Solver::ResetLatinCheckLevel();
+		fmt::print("(checksum {})\n", sink);
+	}
+}
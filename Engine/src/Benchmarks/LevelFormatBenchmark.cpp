@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <fmt/core.h>
+
+#include "Serialization/Parser.h"
+#include "Serialization/BinaryFormat.h"
+#include "Serialization/LevelPack.h"
+
+namespace Benchmarks
+{
+	void RunLevelFormatBenchmark(const std::string& directoryPath, size_t levelCount)
+	{
+		namespace fs = std::filesystem;
+
+		const std::vector<std::string> levelFiles = FindLevelFiles(directoryPath);
+		if (levelFiles.empty())
+		{
+			fmt::print("Level formats: no levels in {}\n", directoryPath);
+			return;
+		}
+
+		// Repeat the directory's levels up to levelCount so the pack is large enough to measure.
+		std::vector<Serialization::LevelData> levels;
+		levels.reserve(levelCount);
+		for (size_t i = 0; i < levelCount; ++i)
+		{
+			levels.push_back(Serialization::Parse(levelFiles[i % levelFiles.size()]));
+		}
+
+		const fs::path tempDirectory = fs::temp_directory_path() / "FutoshikiLevelFormatBenchmark";
+		std::error_code error;
+		fs::create_directories(tempDirectory, error);
+
+		std::vector<std::string> textPaths, binaryPaths;
+		size_t textBytes = 0, binaryBytes = 0;
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			textPaths.push_back((tempDirectory / fmt::format("Level{:05}{}", i, Serialization::TEXT_LEVEL_EXTENSION)).string());
+			binaryPaths.push_back((tempDirectory / fmt::format("Level{:05}{}", i, Serialization::BINARY_LEVEL_EXTENSION)).string());
+			Serialization::Write(levels[i], textPaths.back());
+			Serialization::WriteBinary(levels[i], binaryPaths.back());
+			textBytes += fs::file_size(textPaths.back(), error);
+			binaryBytes += fs::file_size(binaryPaths.back(), error);
+		}
+
+		const std::string packPath = (tempDirectory / fmt::format("Levels{}", Serialization::LEVEL_PACK_EXTENSION)).string();
+		Serialization::WriteLevelPack(levels, packPath);
+		const size_t packBytes = fs::file_size(packPath, error);
+
+		fmt::print("Level formats ({} levels from {})\n", levels.size(), directoryPath);
+		fmt::print("{:<28} {:>14} {:>12} {:>10}\n", "Format", "us/level", "Bytes", "Valid");
+
+		size_t validCount = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (const auto& path : textPaths)
+		{
+			validCount += Serialization::Parse(path).GridSize != 0;
+		}
+		auto end = std::chrono::steady_clock::now();
+		fmt::print("{:<28} {:>14.3f} {:>12} {:>10}\n", "Text files (.data)",
+			std::chrono::duration<double, std::micro>(end - start).count() / levels.size(), textBytes, validCount);
+
+		validCount = 0;
+		start = std::chrono::steady_clock::now();
+		for (const auto& path : binaryPaths)
+		{
+			validCount += Serialization::ParseBinary(path).GridSize != 0;
+		}
+		end = std::chrono::steady_clock::now();
+		fmt::print("{:<28} {:>14.3f} {:>12} {:>10}\n", "Binary files (.lvl)",
+			std::chrono::duration<double, std::micro>(end - start).count() / levels.size(), binaryBytes, validCount);
+
+		validCount = 0;
+		start = std::chrono::steady_clock::now();
+		{
+			Serialization::LevelPack pack;
+			Serialization::LevelData levelData;
+			if (pack.Open(packPath))
+			{
+				for (size_t i = 0; i < pack.GetLevelCount(); ++i)
+				{
+					validCount += pack.ReadLevel(i, levelData);
+				}
+			}
+		}
+		end = std::chrono::steady_clock::now();
+		fmt::print("{:<28} {:>14.3f} {:>12} {:>10}\n", "Mapped pack (.pack)",
+			std::chrono::duration<double, std::micro>(end - start).count() / levels.size(), packBytes, validCount);
+
+		fs::remove_all(tempDirectory, error);
+	}
+}
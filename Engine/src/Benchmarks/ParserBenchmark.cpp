@@ -0,0 +1,195 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <fmt/core.h>
+
+#include "Serialization/Parser.h"
+
+namespace Benchmarks
+{
+	// The stringstream parser that Serialization::Parse replaced, reading from memory instead of a file.
+	static Serialization::LevelData LegacyParse(const std::string& text)
+	{
+		Serialization::LevelData data;
+		std::istringstream file(text);
+		std::string line;
+
+		while (getline(file, line))
+		{
+			std::stringstream ss(line);
+			std::string word;
+
+			bool parseSize = false;
+			bool parseNumber = false;
+			bool parseConstraint = false;
+
+			size_t numberCounter = 0;
+			size_t constraintCounter = 0;
+
+			while (ss >> word)
+			{
+				if (parseSize)
+				{
+					data.GridSize = std::stoi(word);
+					parseSize = false;
+				}
+				else if (parseNumber)
+				{
+					switch (numberCounter)
+					{
+					case 0:
+						data.LockedCells.back().X = std::stoi(word);
+						break;
+					case 1:
+						data.LockedCells.back().Y = std::stoi(word);
+						break;
+					case 2:
+						data.LockedCells.back().Val = std::stoi(word);
+						parseNumber = false;
+						break;
+					}
+					numberCounter++;
+				}
+				else if (parseConstraint)
+				{
+					switch (constraintCounter)
+					{
+					case 0:
+						data.GreaterThanConstraints.back().X1 = std::stoi(word);
+						break;
+					case 1:
+						data.GreaterThanConstraints.back().Y1 = std::stoi(word);
+						break;
+					case 2:
+						data.GreaterThanConstraints.back().X2 = std::stoi(word);
+						break;
+					case 3:
+						data.GreaterThanConstraints.back().Y2 = std::stoi(word);
+						parseConstraint = false;
+						break;
+					}
+					constraintCounter++;
+				}
+
+				if (word == "S" || word == "s")
+				{
+					parseSize = true;
+				}
+				else if (word == "N" || word == "n")
+				{
+					parseNumber = true;
+					data.LockedCells.emplace_back();
+					numberCounter = 0;
+				}
+				else if (word == "C" || word == "c")
+				{
+					parseConstraint = true;
+					data.GreaterThanConstraints.emplace_back();
+					constraintCounter = 0;
+				}
+			}
+		}
+
+		return data;
+	}
+
+	static bool IsSameLevel(const Serialization::LevelData& a, const Serialization::LevelData& b)
+	{
+		if (a.GridSize != b.GridSize
+			|| a.LockedCells.size() != b.LockedCells.size()
+			|| a.GreaterThanConstraints.size() != b.GreaterThanConstraints.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < a.LockedCells.size(); ++i)
+		{
+			const auto& x = a.LockedCells[i];
+			const auto& y = b.LockedCells[i];
+			if (x.X != y.X || x.Y != y.Y || x.Val != y.Val)
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < a.GreaterThanConstraints.size(); ++i)
+		{
+			const auto& x = a.GreaterThanConstraints[i];
+			const auto& y = b.GreaterThanConstraints[i];
+			if (x.X1 != y.X1 || x.Y1 != y.Y1 || x.X2 != y.X2 || x.Y2 != y.Y2)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void RunParserBenchmark(const std::string& directoryPath, size_t iterations)
+	{
+		std::vector<std::string> levelTexts;
+		size_t totalBytes = 0;
+		for (const auto& levelFile : FindLevelFiles(directoryPath))
+		{
+			std::ifstream file(levelFile, std::ifstream::binary);
+			levelTexts.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			totalBytes += levelTexts.back().size();
+		}
+
+		if (levelTexts.empty())
+		{
+			fmt::print("Parser: no levels in {}\n", directoryPath);
+			return;
+		}
+
+		size_t mismatches = 0;
+		Serialization::LevelData levelData;
+		for (const auto& text : levelTexts)
+		{
+			Serialization::ParseBuffer(text.data(), text.size(), levelData);
+			mismatches += !IsSameLevel(levelData, LegacyParse(text));
+		}
+
+		fmt::print("Parser ({} levels, {} bytes, {} passes, {} mismatches)\n", levelTexts.size(), totalBytes, iterations, mismatches);
+		fmt::print("{:<24} {:>10} {:>14}\n", "Parser", "MB/s", "Levels/sec");
+
+		const double megabytes = (double)totalBytes * iterations / (1024.0 * 1024.0);
+		const double levelCount = (double)levelTexts.size() * iterations;
+
+		size_t checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			for (const auto& text : levelTexts)
+			{
+				checksum += LegacyParse(text).GridSize;
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(end - start).count();
+		fmt::print("{:<24} {:>10.1f} {:>14.0f}\n", "stringstream (old)", megabytes / seconds, levelCount / seconds);
+
+		start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			for (const auto& text : levelTexts)
+			{
+				Serialization::ParseBuffer(text.data(), text.size(), levelData);
+				checksum += levelData.GridSize;
+			}
+		}
+		end = std::chrono::steady_clock::now();
+		seconds = std::chrono::duration<double>(end - start).count();
+		fmt::print("{:<24} {:>10.1f} {:>14.0f}\n", "Tokenizer", megabytes / seconds, levelCount / seconds);
+
+		if (checksum == 0)
+		{
+			fmt::print("(empty levels)\n");
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fmt/core.h>
+
+#include "Serialization/Parser.h"
+#include "Engine/LevelPrefetcher.h"
+
+namespace Benchmarks
+{
+	void RunPrefetchBenchmark(const std::string& directoryPath)
+	{
+		const std::vector<std::string> levelFiles = FindLevelFiles(directoryPath);
+		if (levelFiles.empty())
+		{
+			fmt::print("Prefetch: no levels in {}\n", directoryPath);
+			return;
+		}
+
+		Serialization::LevelData levelData;
+
+		// What selecting a level cost before: parsing it on the calling thread.
+		auto start = std::chrono::steady_clock::now();
+		for (const auto& levelFile : levelFiles)
+		{
+			Serialization::Parse(levelFile, levelData);
+		}
+		auto end = std::chrono::steady_clock::now();
+		const double syncTime = std::chrono::duration<double, std::micro>(end - start).count() / levelFiles.size();
+
+		// Scroll through the list, prefetching around each level before it is selected.
+		Engine::LevelPrefetcher prefetcher;
+		double selectTime = 0.0;
+		for (size_t i = 0; i < levelFiles.size(); ++i)
+		{
+			std::vector<std::string> paths{ levelFiles[i] };
+			if (i + 1 < levelFiles.size())
+			{
+				paths.push_back(levelFiles[i + 1]);
+			}
+			prefetcher.Prefetch(paths);
+			prefetcher.WaitUntilIdle();
+
+			start = std::chrono::steady_clock::now();
+			if (!prefetcher.TryGet(levelFiles[i], levelData))
+			{
+				Serialization::Parse(levelFiles[i], levelData);
+			}
+			end = std::chrono::steady_clock::now();
+			selectTime += std::chrono::duration<double, std::micro>(end - start).count();
+		}
+
+		const Engine::PrefetchStats stats = prefetcher.GetStats();
+		fmt::print("Prefetch ({} levels in {})\n", levelFiles.size(), directoryPath);
+		fmt::print("{:<32} {:>10.2f} us\n", "Select, parse on caller", syncTime);
+		fmt::print("{:<32} {:>10.2f} us\n", "Select, prefetched", selectTime / levelFiles.size());
+		fmt::print("hits {}, misses {}, parsed {}, evictions {}\n", stats.Hits, stats.Misses, stats.Parsed, stats.Evictions);
+	}
+}
@@ -0,0 +1,111 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Solver/BatchGenerator.h"
+#include "Solver/DifficultyRater.h"
+
+namespace Benchmarks
+{
+	static const uint8_t RATING_GRID_SIZES[] = { 5, 7, 9 };
+	static const Solver::Difficulty RATING_TARGETS[] = { Solver::Difficulty::EASY, Solver::Difficulty::MEDIUM, Solver::Difficulty::HARD };
+	static const size_t RATING_UNIQUE_LEVELS = 100; // Per size and target; the pack repeats them
+
+	void RunRatingBenchmark(size_t levelCount)
+	{
+		// Generated levels carry their generator target along, to see how the rating lines up with it.
+		std::vector<Serialization::LevelData> uniqueLevels;
+		std::vector<Solver::Difficulty> uniqueTargets;
+		for (const uint8_t gridSize : RATING_GRID_SIZES)
+		{
+			for (const Solver::Difficulty target : RATING_TARGETS)
+			{
+				Solver::GeneratorSettings settings;
+				settings.GridSize = gridSize;
+				settings.TargetDifficulty = target;
+				settings.Seed = 22;
+
+				std::vector<Serialization::LevelData> levels;
+				Solver::GenerateBatch(settings, RATING_UNIQUE_LEVELS, 0, levels);
+				for (auto& levelData : levels)
+				{
+					if (levelData.GridSize)
+					{
+						uniqueLevels.push_back(std::move(levelData));
+						uniqueTargets.push_back(target);
+					}
+				}
+			}
+		}
+
+		if (uniqueLevels.empty())
+		{
+			fmt::print("Rating: no levels were generated\n");
+			return;
+		}
+
+		std::vector<Serialization::LevelData> pack(levelCount);
+		for (size_t i = 0; i < levelCount; ++i)
+		{
+			pack[i] = uniqueLevels[i % uniqueLevels.size()];
+		}
+
+		const size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		fmt::print("Difficulty rating ({} levels, {} distinct, sizes 5/7/9 at every generator target)\n", levelCount, uniqueLevels.size());
+		fmt::print("{:>8} {:>10} {:>14} {:>9} {:>8}\n", "Threads", "Seconds", "Levels/sec", "Speedup", "Steals");
+
+		std::vector<Solver::LevelRating> ratings;
+		double singleThreadSeconds = 0.0;
+		for (const size_t threadCount : { (size_t)1, hardwareThreads })
+		{
+			const Solver::RatingBatchStats stats = Solver::RateBatch(pack, threadCount, ratings);
+			if (threadCount == 1)
+			{
+				singleThreadSeconds = stats.Seconds;
+			}
+
+			fmt::print("{:>8} {:>10.3f} {:>14.0f} {:>8.1f}x {:>8}\n",
+				stats.Threads, stats.Seconds, stats.Rated / stats.Seconds, singleThreadSeconds / stats.Seconds, stats.Steals);
+
+			if (hardwareThreads == 1)
+			{
+				break;
+			}
+		}
+
+		fmt::print("{:>8} {:>8} {:>10} {:>10}  {}\n", "Target", "Levels", "Mean", "Max", "Hardest technique (levels)");
+		for (const Solver::Difficulty target : RATING_TARGETS)
+		{
+			size_t count = 0;
+			uint64_t sum = 0;
+			uint16_t maxDifficulty = 0;
+			size_t hardest[(size_t)Solver::Technique::COUNT] = { 0 };
+			for (size_t i = 0; i < uniqueLevels.size(); ++i)
+			{
+				if (uniqueTargets[i] != target || !ratings[i].Solved)
+				{
+					continue;
+				}
+
+				count++;
+				sum += ratings[i].Difficulty;
+				maxDifficulty = std::max(maxDifficulty, ratings[i].Difficulty);
+				hardest[(size_t)ratings[i].GetHardestTechnique()]++;
+			}
+
+			std::string techniques;
+			for (size_t technique = 0; technique < (size_t)Solver::Technique::COUNT; ++technique)
+			{
+				if (hardest[technique])
+				{
+					techniques += fmt::format("{}{} {}", techniques.empty() ? "" : ", ", Solver::ToString((Solver::Technique)technique), hardest[technique]);
+				}
+			}
+
+			fmt::print("{:>8} {:>8} {:>10.0f} {:>10}  {}\n", Solver::ToString(target), count, count ? (double)sum / count : 0.0, maxDifficulty, techniques);
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/Application.h"
+#include "Engine/InputRecording.h"
+
+namespace Benchmarks
+{
+	// Nearest rank, on sorted values.
+	static double Percentile(const std::vector<double>& sortedValues, size_t percent)
+	{
+		const size_t rank = std::max<size_t>((percent * sortedValues.size() + 99) / 100, 1) - 1;
+		return sortedValues[rank];
+	}
+
+	void RunReplayBenchmark(Engine::Application& app, const std::string& recordingPath, const std::string& directoryPath)
+	{
+		Engine::InputPlayback playback;
+		std::string error;
+		if (!playback.Open(recordingPath, &error))
+		{
+			fmt::print("Replay: could not read {}: {}\n", recordingPath, error);
+			return;
+		}
+
+		if (playback.GetFrameCount() == 0)
+		{
+			fmt::print("Replay: {} has no frames\n", recordingPath);
+			return;
+		}
+
+		app.GetNotifications().SetEchoToLog(false);
+		app.InitSession(directoryPath);
+
+		std::vector<double> frameTimes;
+		frameTimes.reserve(playback.GetFrameCount());
+
+		// The recording is played once; the session's state cannot be rewound.
+		const auto replayStart = std::chrono::steady_clock::now();
+		while (true)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			const bool hasInput = app.UpdateLogic(playback);
+			const auto end = std::chrono::steady_clock::now();
+
+			if (!hasInput)
+			{
+				break;
+			}
+			frameTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+		}
+		const auto replayEnd = std::chrono::steady_clock::now();
+		const double totalTime = std::chrono::duration<double>(replayEnd - replayStart).count();
+
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		fmt::print("Replay ({} frames, {} events from {})\n", playback.GetFrameCount(), playback.GetEventCount(), recordingPath);
+		fmt::print("{:<32} {:>12.2f} ms\n", "Total", totalTime * 1.0e3);
+		fmt::print("{:<32} {:>12.0f}\n", "Events per second", playback.GetEventCount() / totalTime);
+		fmt::print("{:<32} {:>12.0f}\n", "Frames per second", playback.GetFrameCount() / totalTime);
+		fmt::print("Frame logic time (us): p50 {:.2f}, p90 {:.2f}, p99 {:.2f}, max {:.2f}\n",
+			Percentile(frameTimes, 50), Percentile(frameTimes, 90), Percentile(frameTimes, 99), frameTimes.back());
+
+		const Engine::EventBusStats& busStats = app.GetEventBus().GetStats();
+		fmt::print("Events dispatched {}, dropped {}, cascade limit hits {}\n", busStats.Dispatched, busStats.Dropped, busStats.CascadeLimitHits);
+	}
+}
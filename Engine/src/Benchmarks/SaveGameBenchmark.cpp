@@ -0,0 +1,128 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/GridModel.h"
+#include "Engine/ProgressStore.h"
+#include "Serialization/SaveGame.h"
+
+namespace Benchmarks
+{
+	static const uint8_t SAVE_GAME_GRID_SIZES[] = { 9, 16 };
+	static const size_t SAVE_GAME_MOVES = 5000;
+	static const size_t SAVE_GAME_LOADS = 200;
+
+	static double ElapsedUs(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// Autosave after every move: appended records against rewriting the whole file each time, then
+	// leaving the level with its undo history and loading it back. Append and Leave are the time the
+	// calling thread spends queueing; Write is the writer thread's snapshot on leaving.
+	void RunSaveGameBenchmark()
+	{
+		namespace fs = std::filesystem;
+		const std::string directoryPath = (fs::temp_directory_path() / "futoshiki_save_benchmark").string() + "/";
+
+		Engine::ProgressStore store;
+		if (!store.Open(directoryPath))
+		{
+			fmt::print("Save games: could not create {}\n", directoryPath);
+			return;
+		}
+
+		fmt::print("Save games ({} random moves per size, saved after each)\n", SAVE_GAME_MOVES);
+		fmt::print("{:>4} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>10} {:>10}\n",
+			"N", "Append us", "Max us", "Rewrite us", "Leave us", "Write us", "Load us", "Bytes", "Restored");
+
+		std::mt19937 rng(25);
+		for (const uint8_t gridSize : SAVE_GAME_GRID_SIZES)
+		{
+			Serialization::LevelData levelData;
+			levelData.GridSize = gridSize;
+			const std::string levelName = fmt::format("Benchmark{}", gridSize);
+
+			Engine::GridModel model;
+			model.LoadFromData(levelData);
+			model.SetEditMode(false);
+			fs::remove(store.GetSavePath(levelName));
+			store.BeginLevel(levelName, levelData);
+			store.Flush();
+			store.Update(model);
+
+			std::uniform_int_distribution<int> cellDistribution(0, gridSize - 1);
+			std::uniform_int_distribution<int> digitDistribution(1, gridSize);
+
+			// Compactions run on the writer thread every SaveGameWriter::COMPACT_RECORD_COUNT records, while moves keep being queued.
+			double appendTime = 0.0;
+			double maxAppendTime = 0.0;
+			for (size_t i = 0; i < SAVE_GAME_MOVES; ++i)
+			{
+				model.OnChangeSelection(cellDistribution(rng) - model.GetSelectedCol(), cellDistribution(rng) - model.GetSelectedRow());
+				model.SetAltMode(i % 3 == 0);
+				model.OnHandleNumber((uint8_t)digitDistribution(rng));
+
+				const auto start = std::chrono::steady_clock::now();
+				store.Update(model);
+				const double time = ElapsedUs(start);
+				appendTime += time;
+				maxAppendTime = std::max(maxAppendTime, time);
+			}
+			model.SetAltMode(false);
+
+			// What every autosave would cost without the records: a full snapshot through a rename.
+			Serialization::SaveGameData snapshot;
+			snapshot.GridSize = gridSize;
+			snapshot.Numbers = model.GetBoard().Numbers;
+			snapshot.Guesses = model.GetBoard().Guesses;
+			Serialization::SaveGameWriter rewriter;
+			const std::string rewritePath = directoryPath + "Rewrite" + Serialization::SAVE_GAME_EXTENSION;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < SAVE_GAME_LOADS; ++i)
+			{
+				rewriter.Open(rewritePath, snapshot);
+			}
+			const double rewriteTime = ElapsedUs(start) / SAVE_GAME_LOADS;
+			rewriter.Close();
+
+			store.Flush();
+			start = std::chrono::steady_clock::now();
+			store.EndLevel(model);
+			const double leaveTime = ElapsedUs(start);
+
+			start = std::chrono::steady_clock::now();
+			store.Flush();
+			const double writeTime = ElapsedUs(start);
+			const size_t fileSize = (size_t)fs::file_size(store.GetSavePath(levelName));
+
+			// Reading the file back and putting it on a freshly loaded level, as selecting the level does.
+			Engine::GridModel loadedModel;
+			Serialization::SaveGameData saveGame;
+			bool restored = true;
+			start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < SAVE_GAME_LOADS; ++i)
+			{
+				loadedModel.LoadFromData(levelData);
+				restored &= Serialization::ReadSaveGame(store.GetSavePath(levelName), saveGame) && loadedModel.RestoreProgress(saveGame);
+			}
+			const double loadTime = ElapsedUs(start) / SAVE_GAME_LOADS;
+
+			restored &= loadedModel.GetBoard().Numbers == model.GetBoard().Numbers
+				&& loadedModel.GetBoard().Guesses == model.GetBoard().Guesses
+				&& loadedModel.GetJournal().GetEntryCount() == model.GetJournal().GetEntryCount();
+
+			fmt::print("{:>4} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>10} {:>10}\n",
+				gridSize, appendTime / SAVE_GAME_MOVES, maxAppendTime, rewriteTime, leaveTime, writeTime, loadTime, fileSize,
+				restored ? "yes" : "no");
+		}
+
+		std::error_code error;
+		fs::remove_all(directoryPath, error);
+	}
+}
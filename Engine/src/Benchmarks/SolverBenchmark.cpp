@@ -0,0 +1,113 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Serialization/Parser.h"
+#include "Solver/Solver.h"
+
+namespace Benchmarks
+{
+	static const size_t SOLVE_ITERATIONS = 1000;
+
+	static bool IsValidSolution(const Serialization::LevelData& levelData, const std::vector<uint8_t>& solution)
+	{
+		const uint8_t gridSize = levelData.GridSize;
+		for (uint8_t i = 0; i < gridSize; ++i)
+		{
+			uint32_t rowSeen = 0, colSeen = 0;
+			for (uint8_t j = 0; j < gridSize; ++j)
+			{
+				rowSeen |= 1u << solution[i * gridSize + j];
+				colSeen |= 1u << solution[j * gridSize + i];
+			}
+
+			const uint32_t expected = ((1u << (gridSize + 1)) - 1) & ~1u;
+			if (rowSeen != expected || colSeen != expected)
+			{
+				return false;
+			}
+		}
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (solution[lockedCell.Y * gridSize + lockedCell.X] != lockedCell.Val)
+			{
+				return false;
+			}
+		}
+
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			if (solution[constraint.Y1 * gridSize + constraint.X1] <= solution[constraint.Y2 * gridSize + constraint.X2])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<std::string> FindLevelFiles(const std::string& directoryPath)
+	{
+		namespace fs = std::filesystem;
+
+		std::vector<std::string> levelFiles;
+		if (!fs::is_directory(directoryPath))
+		{
+			return levelFiles;
+		}
+
+		for (const auto& entry : fs::directory_iterator(directoryPath))
+		{
+			if (entry.path().extension().string() == ".data")
+			{
+				levelFiles.push_back(entry.path().string());
+			}
+		}
+
+		std::sort(levelFiles.begin(), levelFiles.end());
+		return levelFiles;
+	}
+
+	void RunSolverBenchmark(const std::string& directoryPath)
+	{
+		const std::vector<std::string> levelFiles = FindLevelFiles(directoryPath);
+
+		fmt::print("Solver ({} levels in {}, {} solves each)\n", levelFiles.size(), directoryPath, SOLVE_ITERATIONS);
+		fmt::print("{:<20} {:>5} {:>10} {:>8} {:>13} {:>11} {:>7}\n", "Level", "Size", "Time (us)", "Nodes", "Propagations", "Backtracks", "Valid");
+
+		Solver::BoardSolver solver;
+		std::vector<uint8_t> solution;
+		double totalTime = 0.0;
+
+		for (const auto& levelFile : levelFiles)
+		{
+			const Serialization::LevelData levelData = Serialization::Parse(levelFile);
+
+			bool solved = false;
+			const auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < SOLVE_ITERATIONS; ++i)
+			{
+				solved = solver.Load(levelData) && solver.Solve(solution);
+			}
+			const auto end = std::chrono::steady_clock::now();
+
+			const double time = std::chrono::duration<double, std::micro>(end - start).count() / SOLVE_ITERATIONS;
+			totalTime += time;
+
+			const Solver::SolverStats& stats = solver.GetStats();
+			fmt::print("{:<20} {:>3}x{:<1} {:>10.2f} {:>8} {:>13} {:>11} {:>7}\n",
+				std::filesystem::path(levelFile).stem().string(),
+				levelData.GridSize, levelData.GridSize,
+				time, stats.Nodes, stats.Propagations, stats.Backtracks,
+				(solved && IsValidSolution(levelData, solution)) ? "yes" : "NO");
+		}
+
+		fmt::print("Total: {:.2f} us\n", totalTime);
+	}
+}
@@ -0,0 +1,145 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <fmt/core.h>
+
+#include "Solver/Solver.h"
+#include "Solver/Generator.h"
+
+namespace Benchmarks
+{
+	static const uint8_t UNIQUENESS_GRID_SIZE = 9;
+	static const size_t UNIQUENESS_BOARDS = 200;
+	static const size_t UNIQUENESS_PUZZLES = 20;
+	static const double UNIQUENESS_BUDGET_MS = 2.0;
+
+	// Shuffled cyclic Latin square, with some of its cells and inequalities revealed.
+	static Serialization::LevelData MakeBoard(std::mt19937& rng, size_t givenCount, size_t constraintCount)
+	{
+		const uint8_t gridSize = UNIQUENESS_GRID_SIZE;
+
+		const std::vector<uint8_t> solution = MakeLatinSquare(rng, gridSize);
+
+		Serialization::LevelData levelData;
+		levelData.GridSize = gridSize;
+
+		std::vector<uint8_t> cells(gridSize * gridSize);
+		std::iota(cells.begin(), cells.end(), 0);
+		std::shuffle(cells.begin(), cells.end(), rng);
+		for (size_t i = 0; i < givenCount; ++i)
+		{
+			const uint8_t cell = cells[i];
+			levelData.LockedCells.push_back({ (uint8_t)(cell % gridSize), (uint8_t)(cell / gridSize), solution[cell] });
+		}
+
+		for (size_t i = 0; i < constraintCount; ++i)
+		{
+			const uint8_t x1 = rng() % gridSize, y1 = rng() % gridSize;
+			const bool horizontal = rng() % 2;
+			const uint8_t x2 = horizontal ? (x1 + 1) % gridSize : x1;
+			const uint8_t y2 = horizontal ? y1 : (y1 + 1) % gridSize;
+
+			if (solution[y1 * gridSize + x1] > solution[y2 * gridSize + x2])
+			{
+				levelData.GreaterThanConstraints.push_back({ x1, y1, x2, y2 });
+			}
+			else
+			{
+				levelData.GreaterThanConstraints.push_back({ x2, y2, x1, y1 });
+			}
+		}
+
+		return levelData;
+	}
+
+	void RunUniquenessBenchmark()
+	{
+		fmt::print("Uniqueness check ({0} random {1}x{1} boards per row, budget {2} ms)\n", UNIQUENESS_BOARDS, UNIQUENESS_GRID_SIZE,
+			UNIQUENESS_BUDGET_MS);
+		fmt::print("{:>7} {:>12} {:>10} {:>10} {:>8} {:>9} {:>7}\n", "Givens", "Constraints", "Mean (ms)", "Max (ms)", "Unique", "Multiple", "Nodes");
+
+		std::mt19937 rng(42);
+		Solver::BoardSolver solver;
+
+		const size_t givenCounts[] = { 0, 5, 10, 20, 30 };
+		for (const size_t givenCount : givenCounts)
+		{
+			double totalTime = 0.0, maxTime = 0.0;
+			size_t uniqueCount = 0, multipleCount = 0;
+			uint64_t totalNodes = 0;
+
+			for (size_t board = 0; board < UNIQUENESS_BOARDS; ++board)
+			{
+				const Serialization::LevelData levelData = MakeBoard(rng, givenCount, 20);
+
+				const auto start = std::chrono::steady_clock::now();
+				solver.Load(levelData);
+				const Solver::Uniqueness uniqueness = solver.CheckUniqueness();
+				const auto end = std::chrono::steady_clock::now();
+
+				const double time = std::chrono::duration<double, std::milli>(end - start).count();
+				totalTime += time;
+				maxTime = std::max(maxTime, time);
+				totalNodes += solver.GetStats().Nodes;
+
+				uniqueCount += uniqueness == Solver::Uniqueness::UNIQUE;
+				multipleCount += uniqueness == Solver::Uniqueness::MULTIPLE;
+			}
+
+			fmt::print("{:>7} {:>12} {:>10.4f} {:>10.4f} {:>8} {:>9} {:>7}\n",
+				givenCount, 20, totalTime / UNIQUENESS_BOARDS, maxTime, uniqueCount, multipleCount, totalNodes / UNIQUENESS_BOARDS);
+		}
+
+		// Random boards almost always have several solutions and stop at the second one. Proving a
+		// generated puzzle unique has to exhaust the search, which is the expensive case.
+		fmt::print("\nUniqueness check ({0} generated {1}x{1} puzzles per row, budget {2} ms)\n", UNIQUENESS_PUZZLES, UNIQUENESS_GRID_SIZE,
+			UNIQUENESS_BUDGET_MS);
+		fmt::print("{:>10} {:>10} {:>10} {:>8} {:>10} {:>7}\n", "Difficulty", "Mean (ms)", "Max (ms)", "Unique", "In budget", "Nodes");
+
+		Solver::PuzzleGenerator generator;
+		const Solver::Difficulty difficulties[] = { Solver::Difficulty::EASY, Solver::Difficulty::MEDIUM, Solver::Difficulty::HARD };
+		for (const Solver::Difficulty difficulty : difficulties)
+		{
+			Solver::GeneratorSettings settings;
+			settings.GridSize = UNIQUENESS_GRID_SIZE;
+			settings.TargetDifficulty = difficulty;
+			settings.Seed = 4;
+
+			double totalTime = 0.0, maxTime = 0.0;
+			size_t uniqueCount = 0, inBudgetCount = 0, puzzleCount = 0;
+			uint64_t totalNodes = 0;
+
+			Serialization::LevelData levelData;
+			for (size_t puzzle = 0; puzzle < UNIQUENESS_PUZZLES; ++puzzle)
+			{
+				if (!generator.Generate(settings, puzzle, levelData))
+				{
+					continue;
+				}
+
+				const auto start = std::chrono::steady_clock::now();
+				solver.Load(levelData);
+				const Solver::Uniqueness uniqueness = solver.CheckUniqueness();
+				const auto end = std::chrono::steady_clock::now();
+
+				const double time = std::chrono::duration<double, std::milli>(end - start).count();
+				totalTime += time;
+				maxTime = std::max(maxTime, time);
+				totalNodes += solver.GetStats().Nodes;
+
+				puzzleCount++;
+				uniqueCount += uniqueness == Solver::Uniqueness::UNIQUE;
+				inBudgetCount += time <= UNIQUENESS_BUDGET_MS;
+			}
+
+			const size_t divisor = std::max<size_t>(puzzleCount, 1);
+			fmt::print("{:>10} {:>10.4f} {:>10.4f} {:>8} {:>10} {:>7}\n",
+				Solver::ToString(difficulty), totalTime / divisor, maxTime, uniqueCount, fmt::format("{}/{}", inBudgetCount, puzzleCount),
+				totalNodes / divisor);
+		}
+	}
+}
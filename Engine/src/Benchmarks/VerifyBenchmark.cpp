@@ -0,0 +1,197 @@
+#include "Benchmarks.h"
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "Engine/GridModel.h"
+#include "Solver/Verify.h"
+
+namespace Benchmarks
+{
+	static const uint8_t VERIFY_GRID_SIZE = 9;
+	static const size_t VERIFY_LEVEL_COUNT = 64;
+	static const size_t VERIFY_BOARD_COUNT = 1 << 16;
+	static const size_t VERIFY_ITERATIONS = 16;
+	static const size_t VERIFY_GRID_MODEL_BOARDS = 4000;
+
+	struct VerifyLevel
+	{
+		Serialization::LevelData Level;
+		std::vector<uint8_t> Solution;
+	};
+
+	// Shuffled cyclic Latin square with some givens and inequalities that hold for it.
+	static VerifyLevel MakeVerifyLevel(std::mt19937& rng)
+	{
+		const uint8_t gridSize = VERIFY_GRID_SIZE;
+
+		VerifyLevel verifyLevel;
+		verifyLevel.Level.GridSize = gridSize;
+		verifyLevel.Solution = MakeLatinSquare(rng, gridSize);
+
+		const std::vector<uint8_t>& solution = verifyLevel.Solution;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint8_t kind = rng() % 8;
+				if (kind == 0)
+				{
+					verifyLevel.Level.LockedCells.push_back({ x, y, solution[y * gridSize + x] });
+				}
+				else if (kind == 1 && x + 1 < gridSize)
+				{
+					const bool greater = solution[y * gridSize + x] > solution[y * gridSize + x + 1];
+					verifyLevel.Level.GreaterThanConstraints.push_back(greater
+						? Serialization::GreaterThanConstraint{ x, y, (uint8_t)(x + 1), y }
+						: Serialization::GreaterThanConstraint{ (uint8_t)(x + 1), y, x, y });
+				}
+				else if (kind == 2 && y + 1 < gridSize)
+				{
+					const bool greater = solution[y * gridSize + x] > solution[(y + 1) * gridSize + x];
+					verifyLevel.Level.GreaterThanConstraints.push_back(greater
+						? Serialization::GreaterThanConstraint{ x, y, x, (uint8_t)(y + 1) }
+						: Serialization::GreaterThanConstraint{ x, (uint8_t)(y + 1), x, y });
+				}
+			}
+		}
+
+		return verifyLevel;
+	}
+
+	// A quarter of the boards are solutions, the rest have two cells of a row swapped, a cell changed, or a cell cleared.
+	static void MakeSubmission(std::mt19937& rng, const VerifyLevel& verifyLevel, uint8_t* outBoard)
+	{
+		const uint8_t gridSize = VERIFY_GRID_SIZE;
+		std::copy(verifyLevel.Solution.begin(), verifyLevel.Solution.end(), outBoard);
+
+		const size_t cell = rng() % (gridSize * gridSize);
+		switch (rng() % 4)
+		{
+		case 1:
+			std::swap(outBoard[cell], outBoard[cell - cell % gridSize + rng() % gridSize]);
+			break;
+		case 2:
+			outBoard[cell] = (uint8_t)(outBoard[cell] % gridSize + 1);
+			break;
+		case 3:
+			outBoard[cell] = 0;
+			break;
+		default:
+			break;
+		}
+	}
+
+	// What verifying took before: every number locked into a grid, which then validates the board.
+	static void CheckWithGridModel(Engine::GridModel& model, Serialization::LevelData& scratch, const Serialization::LevelData& levelData, const uint8_t* board)
+	{
+		const uint8_t gridSize = levelData.GridSize;
+		scratch.GridSize = gridSize;
+		scratch.LockedCells.clear();
+		scratch.GreaterThanConstraints = levelData.GreaterThanConstraints;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				scratch.LockedCells.push_back({ x, y, board[y * gridSize + x] });
+			}
+		}
+
+		model.LoadFromData(scratch);
+		model.SetEditMode(false);
+		model.Update();
+	}
+
+	// The grid does not know about givens or empty cells, so only its own marks are compared.
+	static bool MatchesGridModel(const Engine::GridModel& model, const Solver::VerifyResult& result, const uint8_t* board)
+	{
+		const uint8_t gridSize = model.GetGridSize();
+		for (uint8_t i = 0; i < gridSize; ++i)
+		{
+			if (model.CheckRowHasError(i) != result.CheckRowHasError(i) || model.CheckColHasError(i) != result.CheckColHasError(i))
+			{
+				return false;
+			}
+		}
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				if (board[y * gridSize + x] != 0 && model.CheckCellHasError(x, y) != result.CheckCellHasError(x, y))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void RunVerifyBenchmark()
+	{
+		const size_t cellCount = (size_t)VERIFY_GRID_SIZE * VERIFY_GRID_SIZE;
+		std::mt19937 rng(20);
+
+		std::vector<VerifyLevel> levels;
+		for (size_t i = 0; i < VERIFY_LEVEL_COUNT; ++i)
+		{
+			levels.push_back(MakeVerifyLevel(rng));
+		}
+
+		std::vector<uint8_t> boards(VERIFY_BOARD_COUNT * cellCount);
+		std::vector<Solver::VerifyRequest> requests(VERIFY_BOARD_COUNT);
+		for (size_t i = 0; i < VERIFY_BOARD_COUNT; ++i)
+		{
+			const VerifyLevel& verifyLevel = levels[rng() % VERIFY_LEVEL_COUNT];
+			MakeSubmission(rng, verifyLevel, &boards[i * cellCount]);
+			requests[i] = Solver::VerifyRequest{ &verifyLevel.Level, &boards[i * cellCount] };
+		}
+
+		std::vector<Solver::VerifyResult> results(VERIFY_BOARD_COUNT);
+		const size_t validCount = Solver::VerifyBatch(requests.data(), requests.size(), results.data());
+
+		Engine::GridModel model;
+		Serialization::LevelData scratch;
+		size_t gridValidCount = 0;
+		const auto gridStart = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < VERIFY_GRID_MODEL_BOARDS; ++i)
+		{
+			CheckWithGridModel(model, scratch, *requests[i].Level, requests[i].Board);
+			gridValidCount += model.PlayerWon();
+		}
+		const auto gridEnd = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < VERIFY_GRID_MODEL_BOARDS; ++i)
+		{
+			CheckWithGridModel(model, scratch, *requests[i].Level, requests[i].Board);
+			if (!MatchesGridModel(model, results[i], requests[i].Board))
+			{
+				fmt::print("Verify: error marks of board {} differ from the grid's\n", i);
+				return;
+			}
+		}
+
+		size_t sink = 0;
+		const auto verifyStart = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < VERIFY_ITERATIONS; ++i)
+		{
+			sink += Solver::VerifyBatch(requests.data(), requests.size(), results.data());
+		}
+		const auto verifyEnd = std::chrono::steady_clock::now();
+
+		const double gridTime = std::chrono::duration<double>(gridEnd - gridStart).count();
+		const double verifyTime = std::chrono::duration<double>(verifyEnd - verifyStart).count();
+		const double gridRate = VERIFY_GRID_MODEL_BOARDS / gridTime;
+		const double verifyRate = (VERIFY_ITERATIONS * VERIFY_BOARD_COUNT) / verifyTime;
+
+		fmt::print("Verify ({0}x{0}, {1} levels, {2} boards, {3} valid)\n", VERIFY_GRID_SIZE, VERIFY_LEVEL_COUNT, VERIFY_BOARD_COUNT, validCount);
+		fmt::print("{:<32} {:>14.0f} boards/sec\n", "Grid model", gridRate);
+		fmt::print("{:<32} {:>14.0f} boards/sec ({:.1f}x)\n", "Verify", verifyRate, verifyRate / gridRate);
+		fmt::print("Error marks match the grid on {} boards ({} of them solved)\n", VERIFY_GRID_MODEL_BOARDS, gridValidCount);
+		fmt::print("(checksum {})\n", sink);
+	}
+}
@@ -13,6 +13,8 @@ namespace Engine
 		PLAY_MODE,
 		ALT_MODE,
 		NUMBER_MODE,
+		HIGH_DIGITS,
+		LOW_DIGITS,
 		SELECT_LEFT,
 		SELECT_RIGHT,
 		SELECT_UP,
@@ -26,8 +28,13 @@ namespace Engine
 		SEVEN,
 		EIGHT,
 		NINE,
+		ZERO,
 		COMMIT,
-		CANCEL
+		CANCEL,
+		HINT,
+		AUTO_CANDIDATES,
+		UNDO,
+		REDO
 	};
 
 	enum class MappingContext : uint8_t
@@ -1,4 +1,5 @@
 #include "Actions.h"
+#include "Profiler.h"
 
 namespace Engine
 {
@@ -41,6 +42,8 @@ namespace Engine
 			return Event{ EventType::NUMBER_EVENT, { 8,  0} };
 		case Engine::ActionType::NINE:
 			return Event{ EventType::NUMBER_EVENT, { 9,  0} };
+		case Engine::ActionType::ZERO:
+			return Event{ EventType::NUMBER_EVENT, { 0,  0} };
 
 			// Grid Modes
 		case Engine::ActionType::ALT_MODE:
@@ -51,6 +54,10 @@ namespace Engine
 			return Event{ EventType::CHANGE_GRID_STATE, { -1, 1} };
 		case Engine::ActionType::PLAY_MODE:
 			return Event{ EventType::CHANGE_GRID_STATE, { -1, 0} };
+		case Engine::ActionType::HIGH_DIGITS:
+			return Event{ EventType::CHANGE_NUMBER_RANGE, { 1,  0} };
+		case Engine::ActionType::LOW_DIGITS:
+			return Event{ EventType::CHANGE_NUMBER_RANGE, { 0,  0} };
 
 			// Level Events
 		case Engine::ActionType::BOARD_RESET:
@@ -60,23 +67,59 @@ namespace Engine
 		case Engine::ActionType::TOGGLE_LEVEL_MENU:
 			return Event{ EventType::TOGGLE_LEVEL_MENU, { 0,  0} };
 
+			// Game Events
+		case Engine::ActionType::HINT:
+			return Event{ EventType::SHOW_HINT, { 0,  0} };
+		case Engine::ActionType::AUTO_CANDIDATES:
+			return Event{ EventType::TOGGLE_AUTO_CANDIDATES, { 0,  0} };
+		case Engine::ActionType::UNDO:
+			return Event{ EventType::UNDO_MOVE, { 0,  0} };
+		case Engine::ActionType::REDO:
+			return Event{ EventType::REDO_MOVE, { 0,  0} };
+
 		default:
 			return Event{ EventType::CHANGE_SELECTION, { 0,  0} };
 		}
 	}
-	void ActionMap::GenerateEvents(std::vector<Event>& events)
+	bool ActionMap::GenerateEvents(std::vector<Event>& events)
 	{
-		for (const auto& [actionType, actions] : m_ActionMap)
+		PROFILE_SCOPE(GENERATE_EVENTS);
+
+		for (const CompiledBinding& binding : GetCompiledBindings(m_MappingContexts[m_CurrentMappingContextIndex]))
 		{
-			for (const auto& action : actions)
+			if (binding.Trigger.IsTriggered())
 			{
-				if (action.Evaluate(m_MappingContexts[m_CurrentMappingContextIndex]))
+				events.push_back(binding.GeneratedEvent);
+			}
+		}
+
+		return true;
+	}
+
+	const std::vector<ActionMap::CompiledBinding>& ActionMap::GetCompiledBindings(MappingContext context)
+	{
+		const size_t mask = (size_t)context;
+		std::vector<CompiledBinding>& compiledBindings = m_CompiledBindings[mask];
+
+		if (!m_CompiledMasks.test(mask))
+		{
+			compiledBindings.clear();
+			for (const Binding& binding : m_Bindings)
+			{
+				if (binding.Trigger.IsActiveIn(context))
 				{
-					Event currEvent = GenerateEventFromAction(actionType);
-					events.push_back(currEvent);
+					compiledBindings.push_back(CompiledBinding{ binding.Trigger, GenerateEventFromAction(binding.Type) });
 				}
 			}
+			m_CompiledMasks.set(mask);
 		}
+
+		return compiledBindings;
+	}
+
+	void ActionMap::InvalidateCompiledBindings()
+	{
+		m_CompiledMasks.reset();
 	}
 
 	void ActionMap::PushInputLayer(MappingContext context)
@@ -117,27 +160,16 @@ namespace Engine
 
 	void ActionMap::AddAction(ActionType actionType, const Action& action)
 	{
-		if (m_ActionMap.find(actionType) == m_ActionMap.end())
-		{
-			m_ActionMap.emplace(actionType, std::vector<Action>{ action });
-		}
-		else
+		for (const Binding& binding : m_Bindings)
 		{
-			bool needsAdding = true;
-			for (auto& _action : m_ActionMap.at(actionType))
+			if (binding.Type == actionType && binding.Trigger.Interaction == action.Interaction && binding.Trigger.KeyCode == action.KeyCode)
 			{
-				if (_action.Interaction == action.Interaction && _action.KeyCode == action.KeyCode)
-				{
-					needsAdding = false;
-					break;
-				}
-			}
-
-			if (needsAdding)
-			{
-				m_ActionMap.at(actionType).emplace_back(action);
+				return;
 			}
 		}
+
+		m_Bindings.push_back(Binding{ actionType, action });
+		InvalidateCompiledBindings();
 	}
 
 	void ActionMap::AddAction(ActionType actionType, const KeyboardKey& key, const InteractionType interactionType, const MappingContext context)
@@ -147,33 +179,36 @@ namespace Engine
 
 	void ActionMap::RemoveAction(ActionType actionType, const KeyboardKey& key)
 	{
-		if (m_ActionMap.find(actionType) == m_ActionMap.end())
-		{
-			return;
-		}
-
-		std::vector<Action>& actions = m_ActionMap.at(actionType);
-		for (auto itr = actions.begin(); itr != actions.end();)
+		for (auto itr = m_Bindings.begin(); itr != m_Bindings.end();)
 		{
-			if (itr->KeyCode == key)
+			if (itr->Type == actionType && itr->Trigger.KeyCode == key)
 			{
-				itr = actions.erase(itr);
+				itr = m_Bindings.erase(itr);
 			}
 			else
 			{
 				itr = std::next(itr);
 			}
 		}
+
+		InvalidateCompiledBindings();
 	}
 
 	void ActionMap::RemoveAllActions(ActionType actionType)
 	{
-		if (m_ActionMap.find(actionType) == m_ActionMap.end())
+		for (auto itr = m_Bindings.begin(); itr != m_Bindings.end();)
 		{
-			return;
+			if (itr->Type == actionType)
+			{
+				itr = m_Bindings.erase(itr);
+			}
+			else
+			{
+				itr = std::next(itr);
+			}
 		}
 
-		m_ActionMap.erase(actionType);
+		InvalidateCompiledBindings();
 	}
 
 }
\ No newline at end of file
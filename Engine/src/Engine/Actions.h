@@ -1,12 +1,14 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <array>
+#include <bitset>
 
 #include "raylib.h"
 
 #include "Events.h"
 #include "ActionTypes.h"
+#include "InputSource.h"
 
 namespace Engine
 {
@@ -16,14 +18,19 @@ namespace Engine
 		InteractionType Interaction;
 		MappingContext Context;
 
+		inline bool IsActiveIn(MappingContext currentContext) const
+		{
+			return (Context & currentContext) != MappingContext::UNDEFINED
+				|| (Context & MappingContext::ALWAYS_ON) != MappingContext::UNDEFINED;
+		}
+
 		inline bool Evaluate(MappingContext currentContext) const
 		{
-			if ((Context & currentContext) == MappingContext::UNDEFINED && 
-				(Context & MappingContext::ALWAYS_ON) == MappingContext::UNDEFINED)
-			{
-				return false;
-			}
+			return IsActiveIn(currentContext) && IsTriggered();
+		}
 
+		inline bool IsTriggered() const
+		{
 			switch (Interaction)
 			{
 			case Engine::InteractionType::PRESSED:
@@ -40,10 +47,13 @@ namespace Engine
 		}
 	};
 
-	class ActionMap
+	// Turns the keys pressed this frame into events, for the actions bound in the current mapping context.
+	// Bindings are compiled into a flat table per context mask, so a frame only polls the keys that are
+	// active, and events are emitted in the order the bindings were added.
+	class ActionMap : public InputSource
 	{
 	public:
-		void GenerateEvents(std::vector<Event>& events);
+		bool GenerateEvents(std::vector<Event>& events) override;
 
 		void PushInputLayer(MappingContext context);
 		void PopInputLayer();
@@ -60,7 +70,29 @@ namespace Engine
 		void RemoveAllActions(ActionType actionType);
 
 	private:
-		std::unordered_map <ActionType, std::vector<Action>> m_ActionMap;
+		struct Binding
+		{
+			ActionType Type;
+			Action Trigger;
+		};
+
+		struct CompiledBinding
+		{
+			Action Trigger;
+			Event GeneratedEvent;
+		};
+
+		static const size_t MAPPING_CONTEXT_MASKS = 1 << (8 * sizeof(MappingContext));
+
+		// Compiled on first use for a context mask, dropped whenever the bindings change.
+		const std::vector<CompiledBinding>& GetCompiledBindings(MappingContext context);
+		void InvalidateCompiledBindings();
+
+	private:
+		std::vector<Binding> m_Bindings;
+		std::array<std::vector<CompiledBinding>, MAPPING_CONTEXT_MASKS> m_CompiledBindings;
+		std::bitset<MAPPING_CONTEXT_MASKS> m_CompiledMasks;
+
 		std::vector<MappingContext> m_MappingContexts = { MappingContext::ALWAYS_ON | MappingContext::GAME };
 		size_t m_CurrentMappingContextIndex = 0;
 		bool m_IsGuessMode = false;
@@ -1,6 +1,9 @@
 #include "Application.h"
 #include "Serialization/Parser.h"
 #include "Serialization/LevelData.h"
+#include "Profiler.h"
+
+#include <fmt/core.h>
 
 #include "raylib.h"
 
@@ -10,10 +13,13 @@ namespace Engine
 
 	Application::Application(ApplicationProps props)
 		:m_ApplicationProps(props)
+		, m_Input(&m_ActionMap)
 		, m_IsRunning(false)
 		, m_Grid()
 	{
 		s_Instance = this;
+		m_InputEvents.reserve(INPUT_EVENTS_PER_FRAME);
+		SetupEventHandlers();
 	}
 
 	Application::~Application()
@@ -32,6 +38,8 @@ namespace Engine
 
 		while ((!WindowShouldClose()) && m_IsRunning)
 		{
+			PROFILE_FRAME();
+
 			const float deltaTime = GetFrameTime();
 
 			Update(deltaTime);
@@ -39,6 +47,8 @@ namespace Engine
 			Draw();
 		}
 
+		m_Progress.EndLevel(m_Grid.GetModel());
+		m_Progress.Flush();
 		CloseWindow();
 	}
 
@@ -54,7 +64,7 @@ namespace Engine
 
 	void Application::AddEvent(const Event& customEvent)
 	{
-		m_PropagatedEventQueue.push_back(customEvent);
+		m_EventBus.Publish(customEvent);
 	}
 
 	Notifications& Application::GetNotifications()
@@ -62,6 +72,44 @@ namespace Engine
 		return m_Notifications;
 	}
 
+	const EventBus& Application::GetEventBus() const
+	{
+		return m_EventBus;
+	}
+
+	bool Application::StartRecording(const std::string& path)
+	{
+		m_Recorder = std::make_unique<InputRecorder>(m_ActionMap);
+		if (!m_Recorder->Open(path))
+		{
+			TraceLog(LOG_ERROR, "Could not record input to %s", path.c_str());
+			m_Recorder.reset();
+			return false;
+		}
+
+		if (!m_Playback)
+		{
+			m_Input = m_Recorder.get();
+		}
+		return true;
+	}
+
+	bool Application::StartPlayback(const std::string& path)
+	{
+		m_Playback = std::make_unique<InputPlayback>();
+
+		std::string error;
+		if (!m_Playback->Open(path, &error))
+		{
+			TraceLog(LOG_ERROR, "Could not play back %s: %s", path.c_str(), error.c_str());
+			m_Playback.reset();
+			return false;
+		}
+
+		m_Input = m_Playback.get();
+		return true;
+	}
+
 	void Application::Init()
 	{
 		SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
@@ -73,7 +121,22 @@ namespace Engine
 
 		SetupKeybindings();
 
-		m_LevelSelection.LoadLevelNames("./data/");
+		InitSession("./data/");
+		m_LevelSelection.StartBackgroundRating();
+
+		// Only the windowed game keeps progress, so that headless replays start from the same board every time.
+		// Recorded sessions leave it off too, or a replay would start from a board the recording does not have.
+		if (!m_Recorder && !m_Playback && !m_Progress.Open("./saves/"))
+		{
+			m_Notifications.AddNotification(LOG_WARNING, "Progress will not be saved");
+		}
+
+		m_IsRunning = true;
+	}
+
+	void Application::InitSession(const std::string& levelDirectory)
+	{
+		m_LevelSelection.LoadCatalogue(levelDirectory);
 		if (m_LevelSelection.HasLevels())
 		{
 			AddEvent(Event{ EventType::TOGGLE_LEVEL_MENU,{0,0} });
@@ -86,8 +149,6 @@ namespace Engine
 			// Change to Edit mode by default
 			AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_ON));
 		}
-
-		m_IsRunning = true;
 	}
 
 	void Application::Update(const float deltaTime)
@@ -113,18 +174,58 @@ namespace Engine
 			m_Notifications.AddNotification(LOG_ERROR, "Game Loaded with Errors!");
 		}
 
-		m_ActionMap.GenerateEvents(m_EventQueue);
+#if PROFILER_ENABLED
+		if (IsKeyPressed(KEY_F3))
+		{
+			Profiler::Get().ToggleOverlay();
+		}
 
-		do
+		if (IsKeyPressed(KEY_F4))
 		{
-			ProcessEvents();
-		} while (m_EventQueue.size());
+			const char* tracePath = "profile_trace.json";
+			if (Profiler::Get().WriteChromeTrace(tracePath))
+			{
+				m_Notifications.AddNotification(LOG_INFO, fmt::format("Profile written to {}", tracePath));
+			}
+			else
+			{
+				m_Notifications.AddNotification(LOG_ERROR, fmt::format("Could not write {}", tracePath));
+			}
+		}
+#endif
+
+		if (!UpdateLogic(*m_Input))
+		{
+			// Playback finished, the keyboard takes over.
+			m_Input = m_Recorder ? (InputSource*)m_Recorder.get() : &m_ActionMap;
+			m_Playback.reset();
+			m_Notifications.AddNotification(LOG_INFO, "Playback finished");
+		}
 
 		m_LevelSelection.Update(deltaTime);
 
+		m_Notifications.Update(deltaTime);
+	}
+
+	bool Application::UpdateLogic(InputSource& input)
+	{
+		m_InputEvents.clear();
+		const bool hasInput = input.GenerateEvents(m_InputEvents);
+		for (const Event& event : m_InputEvents)
+		{
+			m_EventBus.Publish(event);
+		}
+
+		ProcessEvents();
+
 		m_Grid.Update();
 
-		m_Notifications.Update(deltaTime);
+		if (m_Progress.Update(m_Grid.GetModel()))
+		{
+			m_Notifications.AddNotification(LOG_INFO, "Progress restored");
+		}
+
+		return hasInput;
 	}
 
 	void Application::Draw()
@@ -152,164 +253,195 @@ namespace Engine
 		const float offsetPercentY = 0.99f;
 		m_Notifications.Draw(offsetPercentX, offsetPercentY);
 
+#if PROFILER_ENABLED
+		Profiler::Get().DrawOverlay(GetScreenWidth() - 10, 40);
+#endif
+
 		EndDrawing();
 	}
 
 	void Application::ProcessEvents()
 	{
-		for (auto& event: m_EventQueue)
+		PROFILE_SCOPE(PROCESS_EVENTS);
+
+		m_EventBus.Dispatch();
+	}
+
+	void Application::SetupEventHandlers()
+	{
+		// The level menu gets first pick of the navigation events while it is open.
+		const auto levelSelection = [this](Event& event) { m_LevelSelection.ProcessEvents(event); };
+		m_EventBus.Subscribe(EventType::CHANGE_SELECTION, levelSelection);
+		m_EventBus.Subscribe(EventType::COMMIT, levelSelection);
+		m_EventBus.Subscribe(EventType::CANCEL, levelSelection);
+
+		m_EventBus.Subscribe(EventType::INPUT_LAYER_OPERATION, [this](Event& event) { OnInputLayerOperation(event); });
+		m_EventBus.Subscribe(EventType::BOARD_RESET, [this](Event& event) { OnBoardReset(event); });
+		m_EventBus.Subscribe(EventType::PLAYER_WON, [this](Event& event) { OnPlayerWon(event); });
+		m_EventBus.Subscribe(EventType::CHANGE_SELECTION, [this](Event& event) { m_Grid.OnChangeSelection(event.data[0], event.data[1]); });
+		m_EventBus.Subscribe(EventType::NUMBER_EVENT, [this](Event& event) { m_Grid.OnHandleNumber(event.data[0]); });
+		m_EventBus.Subscribe(EventType::CHANGE_NUMBER_RANGE, [this](Event& event) { m_Grid.SetHighDigits(event.data[0]); });
+		m_EventBus.Subscribe(EventType::SHOW_HINT, [this](Event&) { m_Grid.ShowHint(); });
+		m_EventBus.Subscribe(EventType::UNDO_MOVE, [this](Event&) { m_Grid.Undo(); });
+		m_EventBus.Subscribe(EventType::REDO_MOVE, [this](Event&) { m_Grid.Redo(); });
+		m_EventBus.Subscribe(EventType::TOGGLE_AUTO_CANDIDATES, [this](Event&) { m_Grid.SetAutoCandidates(!m_Grid.GetGridState().AutoCandidates); });
+		m_EventBus.Subscribe(EventType::CHANGE_GRID_STATE, [this](Event& event) { OnChangeGridState(event); });
+		m_EventBus.Subscribe(EventType::TOGGLE_LEVEL_MENU, [this](Event& event) { OnToggleLevelMenu(event); });
+		m_EventBus.Subscribe(EventType::SAVE_LEVEL, [this](Event& event) { OnSaveLevel(event); });
+		m_EventBus.Subscribe(EventType::SELECT_LEVEL, [this](Event& event) { OnSelectLevel(event); });
+		m_EventBus.Subscribe(EventType::CANCEL, [this](Event& event) { OnCancel(event); });
+	}
+
+	void Application::ResumeProgress()
+	{
+		if (!m_Progress.IsOpen())
 		{
-			m_LevelSelection.ProcessEvents(event);
+			return;
+		}
 
-			if (event.handled)
-			{
-				continue;
-			}
+		// Unsaved edits and new boards are not the level the progress is kept under, and would replace it.
+		const Serialization::LevelData levelData = Grid::GetSaveData(m_Grid);
+		Serialization::LevelData savedLevelData;
+		if (!m_Grid.HasValidData()
+			|| !m_LevelSelection.GetLastLoadedLevelData(savedLevelData)
+			|| Serialization::ComputeLevelHash(savedLevelData) != Serialization::ComputeLevelHash(levelData))
+		{
+			return;
+		}
 
-			switch (event.type)
-			{
-			case EventType::INPUT_LAYER_OPERATION:
-			{
-				if (event.data[0] == (int)InputLayerOperation::PUSH)
-				{
-					m_ActionMap.PushInputLayer((MappingContext)event.data[1]);
-				}
-				else if (event.data[0] == (int)InputLayerOperation::POP)
-				{
-					m_ActionMap.PopInputLayer();
-				}
-
-				break;
-			}
-			case EventType::BOARD_RESET:
-			{
-				if (m_Grid.GetGridState().EditMode)
-				{
-					if (m_Grid.GetGridState().AltMode)
-					{
-						m_Grid.NewBoard();
-					}
-					else
-					{ 
-						m_Grid.LoadFromData(Serialization::Parse(m_LevelSelection.GetLastLoadedLevelPath()));
-					}
-				}
-				else
-				{
-					m_Grid.Reset();
-					m_ActionMap.RemoveAllMappingContexts();
-					m_ActionMap.AddMappingContext(MappingContext::GAME);
-				}
-				break;
-			}
-			case EventType::PLAYER_WON:
-			{
-				m_ActionMap.RemoveAllMappingContexts();
-				m_ActionMap.AddMappingContext(MappingContext::POST_GAME);
-				break;
-			}
-			case EventType::CHANGE_SELECTION:
+		m_Progress.BeginLevel(m_LevelSelection.GetLastLoadedLevelName(), levelData);
+	}
+
+	void Application::OnInputLayerOperation(Event& event)
+	{
+		if (event.data[0] == (int)InputLayerOperation::PUSH)
+		{
+			m_ActionMap.PushInputLayer((MappingContext)event.data[1]);
+		}
+		else if (event.data[0] == (int)InputLayerOperation::POP)
+		{
+			m_ActionMap.PopInputLayer();
+		}
+	}
+
+	void Application::OnBoardReset(Event&)
+	{
+		if (m_Grid.GetGridState().EditMode)
+		{
+			if (m_Grid.GetGridState().AltMode)
 			{
-				m_Grid.OnChangeSelection(event.data[0], event.data[1]);
-				break;
+				m_Grid.NewBoard();
 			}
-			case EventType::NUMBER_EVENT:
-			{
-				m_Grid.OnHandleNumber(event.data[0]);
-				break;
+			else
+			{ 
+				m_Grid.LoadFromData(Serialization::Parse(m_LevelSelection.GetLastLoadedLevelPath()));
 			}
-			case EventType::CHANGE_GRID_STATE:
-			{
-				if (event.data[0] != ALT_MODE_NC)
-				{
-					m_Grid.SetAltMode(event.data[0]);
-				}
-
-				if (event.data[1] != EDIT_MODE_NC)
-				{
-					m_Grid.SetEditMode(event.data[1]);
-
-					m_ActionMap.RemoveAllMappingContexts();
-
-					if (event.data[1])
-					{
-						m_ActionMap.AddMappingContext(MappingContext::EDITOR);
-					}
-					else
-					{
-						m_ActionMap.AddMappingContext(MappingContext::GAME);
-					}
-				}
-				break;
-			}
-			case EventType::TOGGLE_LEVEL_MENU:
+		}
+		else
+		{
+			m_Grid.Reset();
+			m_ActionMap.RemoveAllMappingContexts();
+			m_ActionMap.AddMappingContext(MappingContext::GAME);
+		}
+	}
+
+	void Application::OnPlayerWon(Event&)
+	{
+		m_ActionMap.RemoveAllMappingContexts();
+		m_ActionMap.AddMappingContext(MappingContext::POST_GAME);
+	}
+
+	void Application::OnChangeGridState(Event& event)
+	{
+		if (event.data[0] != ALT_MODE_NC)
+		{
+			m_Grid.SetAltMode(event.data[0]);
+		}
+
+		if (event.data[1] != EDIT_MODE_NC)
+		{
+			// Edits change the level, so the progress on it is saved as it stood.
+			const bool leavingEditor = !event.data[1] && m_Grid.GetGridState().EditMode;
+			if (event.data[1])
 			{
-				if (m_LevelSelection.IsOpen())
-				{
-					const bool shouldCommit = event.data[0];
-					m_LevelSelection.Close(shouldCommit);
-					if (!shouldCommit && !m_Grid.HasValidData())
-					{
-						AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_ON));
-						m_Grid.NewBoard();
-					}
-				}
-				else
-				{
-					m_LevelSelection.ShowMenu();
-				}
-				break;
+				m_Progress.EndLevel(m_Grid.GetModel());
 			}
-			case EventType::SAVE_LEVEL:
+
+			m_Grid.SetEditMode(event.data[1]);
+			if (leavingEditor)
 			{
-				m_LevelSelection.SaveLevel(Grid::GetSaveData(m_Grid), m_Grid.GetGridState().AltMode);
-				break;
+				ResumeProgress();
 			}
-			case EventType::SELECT_LEVEL:
+
+			m_ActionMap.RemoveAllMappingContexts();
+
+			if (event.data[1])
 			{
-				Serialization::LevelData levelData;
-				if (m_LevelSelection.ParseLevel(event.data[0], levelData))
-				{
-					m_Grid.LoadFromData(levelData);
-					m_ActionMap.RemoveAllMappingContexts();
-					m_ActionMap.AddMappingContext(MappingContext::GAME);
-					AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_OFF));
-				}
-				else
-				{
-					AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_ON));
-					m_Grid.NewBoard();
-				}
-				break;
+				m_ActionMap.AddMappingContext(MappingContext::EDITOR);
 			}
-			case EventType::CANCEL:
+			else
 			{
-				if (m_Grid.GetGridState().EditMode)
-				{
-					AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_OFF));
-				}
-#ifdef BUILD_DEBUG
-				else
-				{
-					Close();
-				}
-#endif
-				break;
+				m_ActionMap.AddMappingContext(MappingContext::GAME);
 			}
-			default:
+		}
+	}
+
+	void Application::OnToggleLevelMenu(Event& event)
+	{
+		if (m_LevelSelection.IsOpen())
+		{
+			const bool shouldCommit = event.data[0];
+			m_LevelSelection.Close(shouldCommit);
+			if (!shouldCommit && !m_Grid.HasValidData())
 			{
-				break;
-			}
+				AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_ON));
+				m_Grid.NewBoard();
 			}
 		}
+		else
+		{
+			m_LevelSelection.ShowMenu();
+		}
+	}
+
+	void Application::OnSaveLevel(Event&)
+	{
+		m_LevelSelection.SaveLevel(Grid::GetSaveData(m_Grid), m_Grid.CheckUniqueness(), m_Grid.GetGridState().AltMode);
+	}
+
+	void Application::OnSelectLevel(Event& event)
+	{
+		m_Progress.EndLevel(m_Grid.GetModel());
 
-		m_EventQueue.clear();
+		Serialization::LevelData levelData;
+		if (m_LevelSelection.ParseLevel(event.data[0], levelData))
+		{
+			m_Grid.LoadFromData(levelData);
+			m_Grid.SetEditMode(false);
+			m_Progress.BeginLevel(m_LevelSelection.GetLastLoadedLevelName(), levelData);
+			m_ActionMap.RemoveAllMappingContexts();
+			m_ActionMap.AddMappingContext(MappingContext::GAME);
+			AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_OFF));
+		}
+		else
+		{
+			AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_ON));
+			m_Grid.NewBoard();
+		}
+	}
 
-		if (!m_PropagatedEventQueue.empty())
+	void Application::OnCancel(Event&)
+	{
+		if (m_Grid.GetGridState().EditMode)
 		{
-			m_EventQueue.insert(m_EventQueue.end(), m_PropagatedEventQueue.begin(), m_PropagatedEventQueue.end());
-			m_PropagatedEventQueue.clear();
+			AddEvent(CreateGridStateChangeEvent(ALT_MODE_NC, EDIT_MODE_OFF));
 		}
+#ifdef BUILD_DEBUG
+		else
+		{
+			Close();
+		}
+#endif
 	}
 
 	void Application::SetupKeybindings()
@@ -364,14 +496,28 @@ namespace Engine
 		m_ActionMap.AddAction(ActionType::NINE, KEY_NINE, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
 		m_ActionMap.AddAction(ActionType::NINE, KEY_KP_9, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
 
+		m_ActionMap.AddAction(ActionType::ZERO, KEY_ZERO, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
+		m_ActionMap.AddAction(ActionType::ZERO, KEY_KP_0, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
+
 		m_ActionMap.AddAction(ActionType::ALT_MODE, KEY_LEFT_CONTROL, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
 		m_ActionMap.AddAction(ActionType::NUMBER_MODE, KEY_LEFT_CONTROL, InteractionType::RELEASED, MappingContext::GAME | MappingContext::EDITOR);
 
 		m_ActionMap.AddAction(ActionType::ALT_MODE, KEY_RIGHT_CONTROL, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
 		m_ActionMap.AddAction(ActionType::NUMBER_MODE, KEY_RIGHT_CONTROL, InteractionType::RELEASED, MappingContext::GAME | MappingContext::EDITOR);
 
+		// Shift + 0-6 enters 10-16
+		m_ActionMap.AddAction(ActionType::HIGH_DIGITS, KEY_LEFT_SHIFT, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
+		m_ActionMap.AddAction(ActionType::LOW_DIGITS, KEY_LEFT_SHIFT, InteractionType::RELEASED, MappingContext::GAME | MappingContext::EDITOR);
+
+		m_ActionMap.AddAction(ActionType::HIGH_DIGITS, KEY_RIGHT_SHIFT, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
+		m_ActionMap.AddAction(ActionType::LOW_DIGITS, KEY_RIGHT_SHIFT, InteractionType::RELEASED, MappingContext::GAME | MappingContext::EDITOR);
+
 		m_ActionMap.AddAction(ActionType::BOARD_RESET, KEY_R, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR | MappingContext::POST_GAME);
 		m_ActionMap.AddAction(ActionType::SAVE_LEVEL, KEY_F, InteractionType::PRESSED, MappingContext::EDITOR);
+		m_ActionMap.AddAction(ActionType::HINT, KEY_H, InteractionType::PRESSED, MappingContext::GAME);
+		m_ActionMap.AddAction(ActionType::AUTO_CANDIDATES, KEY_C, InteractionType::PRESSED, MappingContext::GAME);
+		m_ActionMap.AddAction(ActionType::UNDO, KEY_U, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
+		m_ActionMap.AddAction(ActionType::REDO, KEY_Y, InteractionType::PRESSED, MappingContext::GAME | MappingContext::EDITOR);
 
 		m_ActionMap.AddAction(ActionType::TOGGLE_LEVEL_MENU, KEY_L, InteractionType::PRESSED, MappingContext::ALWAYS_ON);
 
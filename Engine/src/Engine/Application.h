@@ -2,11 +2,15 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
 
 #include "Events.h"
+#include "EventBus.h"
 #include "Actions.h"
+#include "InputRecording.h"
 #include "Grid.h"
 #include "LevelSelection.h"
+#include "ProgressStore.h"
 #include "Notifications.h"
 
 namespace Engine
@@ -26,11 +30,29 @@ namespace Engine
 
         void Run();
         void Close();
+
+        // Runs a command-line tool (validate, solve, generate, benchmark) without a window.
+        // Returns the process exit code.
+        int RunHeadless(const std::vector<std::string>& args);
         
         static Application& Get();
         
+        // Queues an event; events added while events are being processed are handled in the same frame.
         void AddEvent(const Event& customEvent);
         Notifications& GetNotifications();
+        const EventBus& GetEventBus() const;
+
+        // Writes the keyboard input of the session to a file, or plays a recording back in its place.
+        // Call before Run().
+        bool StartRecording(const std::string& path);
+        bool StartPlayback(const std::string& path);
+
+        // Sets up the game state a session starts from. Does not need a window.
+        void InitSession(const std::string& levelDirectory);
+
+        // Runs the game logic of one frame on the events of the input: event processing and Grid::Update.
+        // Returns false when the input has no frames left.
+        bool UpdateLogic(InputSource& input);
         
     protected:
         void Init();
@@ -39,17 +61,44 @@ namespace Engine
 
         void ProcessEvents();
         void SetupKeybindings();
+        void SetupEventHandlers();
+
+        // Starts saving progress again after the editor, when the board still matches its level file.
+        void ResumeProgress();
+
+        void OnInputLayerOperation(Event& event);
+        void OnBoardReset(Event& event);
+        void OnPlayerWon(Event& event);
+        void OnChangeGridState(Event& event);
+        void OnToggleLevelMenu(Event& event);
+        void OnSaveLevel(Event& event);
+        void OnSelectLevel(Event& event);
+        void OnCancel(Event& event);
+
+        int HeadlessValidate(const std::vector<std::string>& args);
+        int HeadlessSolve(const std::vector<std::string>& args);
+        int HeadlessGenerate(const std::vector<std::string>& args);
+        int HeadlessRate(const std::vector<std::string>& args);
+        int HeadlessConvert(const std::vector<std::string>& args);
+        int HeadlessReplay(const std::vector<std::string>& args);
+        int HeadlessBenchmark(const std::vector<std::string>& args);
     protected:
         static Application* s_Instance;
         ApplicationProps m_ApplicationProps;
 
         ActionMap m_ActionMap;
+        InputSource* m_Input;
+        std::unique_ptr<InputRecorder> m_Recorder;
+        std::unique_ptr<InputPlayback> m_Playback;
         
-        std::vector<Event> m_EventQueue;
-        std::vector<Event> m_PropagatedEventQueue;
+        static const size_t INPUT_EVENTS_PER_FRAME = 64;
+
+        std::vector<Event> m_InputEvents;
+        EventBus m_EventBus;
 
         Grid m_Grid;
         LevelSelection m_LevelSelection;
+        ProgressStore m_Progress;
         Notifications m_Notifications;
 
         bool m_IsRunning;
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+
+namespace Engine
+{
+	// Digit n (1-based) maps to bit (n - 1); an empty cell (0) maps to no bit at all.
+	inline constexpr uint16_t DigitBit(uint8_t number)
+	{
+		return (uint16_t)((1u << number) >> 1);
+	}
+
+	// Fills rowDuplicates[y] and colDuplicates[x] with the digits that appear more than once
+	// in that row/column. getNumber(x, y) returns the number stored in a cell (0 when empty).
+	template<typename GetNumberFn>
+	inline void ComputeDuplicateMasks(uint8_t gridSize, GetNumberFn getNumber, uint16_t* rowDuplicates, uint16_t* colDuplicates)
+	{
+		uint16_t colSeen[16] = { 0 };
+
+		for (uint8_t x = 0; x < gridSize; ++x)
+		{
+			colDuplicates[x] = 0;
+		}
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			uint16_t rowSeen = 0;
+			uint16_t rowSeenTwice = 0;
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint16_t bit = DigitBit(getNumber(x, y));
+
+				rowSeenTwice |= rowSeen & bit;
+				rowSeen |= bit;
+
+				colDuplicates[x] |= colSeen[x] & bit;
+				colSeen[x] |= bit;
+			}
+
+			rowDuplicates[y] = rowSeenTwice;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#include "EventBus.h"
+
+namespace Engine
+{
+	EventBus::EventBus(size_t capacity, size_t maxCascadeDepth)
+		: m_Queue(capacity > 0 ? capacity : 1)
+		, m_MaxCascadeDepth(maxCascadeDepth > 0 ? maxCascadeDepth : 1)
+	{
+	}
+
+	void EventBus::Subscribe(EventType type, Handler handler)
+	{
+		m_Subscribers[(size_t)type].push_back(std::move(handler));
+	}
+
+	bool EventBus::Publish(const Event& event)
+	{
+		if (m_Count == m_Queue.size())
+		{
+			m_Stats.Dropped++;
+			return false;
+		}
+
+		m_Queue[(m_Head + m_Count) % m_Queue.size()] = event;
+		m_Count++;
+		m_Stats.Published++;
+		return true;
+	}
+
+	void EventBus::Dispatch()
+	{
+		for (size_t depth = 0; depth < m_MaxCascadeDepth && m_Count > 0; ++depth)
+		{
+			// Events published while this pass runs are left for the next one.
+			for (size_t remaining = m_Count; remaining > 0; --remaining)
+			{
+				// The event stays queued while its handlers run, so publishing cannot overwrite it.
+				Event& event = m_Queue[m_Head];
+				for (const Handler& handler : m_Subscribers[(size_t)event.type])
+				{
+					handler(event);
+					if (event.handled)
+					{
+						break;
+					}
+				}
+
+				m_Head = (m_Head + 1) % m_Queue.size();
+				m_Count--;
+				m_Stats.Dispatched++;
+			}
+		}
+
+		if (m_Count > 0)
+		{
+			m_Stats.CascadeLimitHits++;
+		}
+	}
+
+	void EventBus::Clear()
+	{
+		m_Head = 0;
+		m_Count = 0;
+	}
+
+	size_t EventBus::GetQueuedCount() const
+	{
+		return m_Count;
+	}
+
+	const EventBusStats& EventBus::GetStats() const
+	{
+		return m_Stats;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <stddef.h>
+#include <vector>
+#include <array>
+#include <functional>
+
+#include "Events.h"
+
+namespace Engine
+{
+	struct EventBusStats
+	{
+		size_t Published = 0;
+		size_t Dispatched = 0;
+		size_t Dropped = 0; // Published while the queue was full
+		size_t CascadeLimitHits = 0; // Frames that left events queued for the next frame
+	};
+
+	// Preallocated ring buffer of events, dispatched to the subscribers of each EventType.
+	// Events published by a handler are dispatched in the next pass of the same frame, for at most
+	// maxCascadeDepth passes; whatever is still queued after that waits for the next frame.
+	class EventBus
+	{
+	public:
+		using Handler = std::function<void(Event&)>;
+
+		static const size_t DEFAULT_CAPACITY = 256;
+		static const size_t DEFAULT_MAX_CASCADE_DEPTH = 16;
+
+		EventBus(size_t capacity = DEFAULT_CAPACITY, size_t maxCascadeDepth = DEFAULT_MAX_CASCADE_DEPTH);
+
+		// Handlers run in the order they subscribed, until one of them marks the event handled.
+		void Subscribe(EventType type, Handler handler);
+
+		// Returns false, and counts the event as dropped, when the queue is full.
+		bool Publish(const Event& event);
+
+		void Dispatch();
+		void Clear();
+
+		size_t GetQueuedCount() const;
+		const EventBusStats& GetStats() const;
+
+	private:
+		std::vector<Event> m_Queue;
+		size_t m_Head = 0;
+		size_t m_Count = 0;
+		const size_t m_MaxCascadeDepth;
+
+		std::array<std::vector<Handler>, (size_t)EventType::COUNT> m_Subscribers;
+		EventBusStats m_Stats;
+	};
+}
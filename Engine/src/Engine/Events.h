@@ -26,6 +26,15 @@ namespace Engine
         SAVE_LEVEL,
         TOGGLE_LEVEL_MENU,
         SELECT_LEVEL,
+
+        // Appended to keep the values in existing input recordings
+        CHANGE_NUMBER_RANGE,
+        SHOW_HINT,
+        TOGGLE_AUTO_CANDIDATES,
+        UNDO_MOVE,
+        REDO_MOVE,
+
+        COUNT
     };
 
     struct Event
@@ -1,6 +1,5 @@
 #include "Grid.h"
 #include <string>
-#include <unordered_map>
 #include <algorithm>
 #include <fmt/core.h>
 
@@ -8,6 +7,8 @@
 
 #include "ConstraintArrowVectors.h"
 #include "Application.h"
+#include "Profiler.h"
+#include "DuplicateCheck.h"
 
 namespace Engine
 {
@@ -18,41 +19,26 @@ namespace Engine
 
 
 	Grid::Grid(GridStyle style)
-		: m_GridSize(0)
-		, Style(style)
+		: Style(style)
 		, Center({ 0.0f })
 		, m_Origin({ 0.0f })
-		, m_SelectedRow(0)
-		, m_SelectedCol(0)
-		, m_TargetSum(0)
-		, m_PlayerWon(false)
-
 	{
 	}
 
 	void Grid::Update()
 	{
-		if (!HasValidData())
-		{
-			return;
-		}
+		PROFILE_SCOPE(GRID_UPDATE);
 
-		if (!m_PlayerWon)
+		if (m_Model.Update())
 		{
-			if (!m_State.EditMode)
-			{
-				ClearAllErrors();
-				CheckConstraints();
-			}
-			else if (m_State.EditMode)
-			{
-				ClearAllErrors();
-			}
+			Application::Get().AddEvent(Event{ EventType::PLAYER_WON, {0,0} });
 		}
 	}
 
 	void Grid::Draw()
 	{
+		PROFILE_SCOPE(GRID_DRAW);
+
 		if (!HasValidData())
 		{
 			return;
@@ -60,16 +46,19 @@ namespace Engine
 
 		DrawHelpText(10, 50);
 
-		m_Origin = Vector2Subtract(Center, Vector2{ 0.5f * Style.CellSize * m_GridSize, 0.5f * Style.CellSize * m_GridSize });
+		const GridModel& model = m_Model;
+		const uint8_t gridSize = model.GetGridSize();
+		UpdateLayout(gridSize);
+		m_Origin = Vector2Subtract(Center, Vector2{ 0.5f * m_Layout.CellSize * gridSize, 0.5f * m_Layout.CellSize * gridSize });
 
 		// Draw blocks and numbers
-		for (uint8_t y = 0; y < m_GridSize; ++y)
+		for (uint8_t y = 0; y < gridSize; ++y)
 		{
-			for (uint8_t x = 0; x < m_GridSize; ++x)
+			for (uint8_t x = 0; x < gridSize; ++x)
 			{
-				Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)Style.CellSize * x, (float)Style.CellSize * y });
-				Vector2 blockPosition = Vector2Add(cellPosition, Vector2{ 0.5f * (Style.CellSize - Style.BlockSize), 0.5f * (Style.CellSize - Style.BlockSize) });
-				CellData& cell = GetCellData(x, y);
+				Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)m_Layout.CellSize * x, (float)m_Layout.CellSize * y });
+				Vector2 blockPosition = Vector2Add(cellPosition, Vector2{ 0.5f * (m_Layout.CellSize - m_Layout.BlockSize), 0.5f * (m_Layout.CellSize - m_Layout.BlockSize) });
+				const CellData cell = model.GetCellData(x, y);
 
 				DrawBlock(cell, x, y, blockPosition);
 
@@ -82,15 +71,20 @@ namespace Engine
 			}
 		}
 
-		for (const auto& constraint : m_Constraints)
+		if (m_HintVisible)
 		{
-			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)Style.CellSize * constraint.X1, (float)Style.CellSize * constraint.Y1 });
+			DrawHint();
+		}
+
+		for (const auto& constraint : m_Model.GetConstraints())
+		{
+			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)m_Layout.CellSize * constraint.X1, (float)m_Layout.CellSize * constraint.Y1 });
 			Vector2 v1{ 0.0f }, v2{ 0.0f }, v3{ 0.0f };
 			if (constraint.IsRowConstraint())
 			{
 				ComputeHorizontalArrow(cellPosition,
-					Style.CellSize,
-					Style.BlockSize,
+					m_Layout.CellSize,
+					m_Layout.BlockSize,
 					Style.TriangleWidthPercent,
 					Style.TriangleHeightPercent,
 					v1, v2, v3,
@@ -100,8 +94,8 @@ namespace Engine
 			if (constraint.IsColConstraint())
 			{
 				ComputeVerticalArrow(cellPosition,
-					Style.CellSize,
-					Style.BlockSize,
+					m_Layout.CellSize,
+					m_Layout.BlockSize,
 					Style.TriangleWidthPercent,
 					Style.TriangleHeightPercent,
 					v1, v2, v3,
@@ -113,22 +107,22 @@ namespace Engine
 		}
 
 
-		const Vector2 blockOffset{ 0.5f * (Style.CellSize - Style.BlockSize),0.5f * (Style.CellSize - Style.BlockSize) };
+		const Vector2 blockOffset{ 0.5f * (m_Layout.CellSize - m_Layout.BlockSize),0.5f * (m_Layout.CellSize - m_Layout.BlockSize) };
 
 		// Draw Col Errors
-		for (uint8_t x = 0; x < m_GridSize; ++x)
+		for (uint8_t x = 0; x < gridSize; ++x)
 		{
-			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)Style.CellSize * x, 0 });
+			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ (float)m_Layout.CellSize * x, 0 });
 			Vector2 blockPosition = Vector2Add(cellPosition, blockOffset);
 
-			if (CheckColHasError(x))
+			if (m_Model.CheckColHasError(x))
 			{
 				DrawRectangleLinesEx(
 					Rectangle{
 						blockPosition.x,
 						blockPosition.y,
-						(float)Style.BlockSize,
-						(float)(m_GridSize - 1) * Style.CellSize + Style.BlockSize
+						(float)m_Layout.BlockSize,
+						(float)(gridSize - 1) * m_Layout.CellSize + m_Layout.BlockSize
 					},
 					5.0f,
 					Style.WrongFontColor
@@ -137,19 +131,19 @@ namespace Engine
 		}
 
 		// Draw Row Errors
-		for (uint8_t y = 0; y < m_GridSize; ++y)
+		for (uint8_t y = 0; y < gridSize; ++y)
 		{
-			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ 0, (float)Style.CellSize * y });
+			Vector2 cellPosition = Vector2Add(m_Origin, Vector2{ 0, (float)m_Layout.CellSize * y });
 			Vector2 blockPosition = Vector2Add(cellPosition, blockOffset);
 
-			if (CheckRowHasError(y))
+			if (m_Model.CheckRowHasError(y))
 			{
 				DrawRectangleLinesEx(
 					Rectangle{
 						blockPosition.x,
 						blockPosition.y,
-						(float)(m_GridSize - 1) * Style.CellSize + Style.BlockSize,
-						(float)Style.BlockSize,
+						(float)(gridSize - 1) * m_Layout.CellSize + m_Layout.BlockSize,
+						(float)m_Layout.BlockSize,
 					},
 					5.0f,
 					Style.WrongFontColor
@@ -158,460 +152,198 @@ namespace Engine
 		}
 	}
 
+	void Grid::UpdateLayout(uint8_t gridSize)
+	{
+		// Grids that do not fit the window are scaled down, leaving room for the title and mode text.
+		const float availableSize = (float)std::min(GetScreenWidth() - 2 * LAYOUT_MARGIN_X, GetScreenHeight() - 2 * LAYOUT_MARGIN_Y);
+		const float scale = std::clamp(availableSize / (Style.CellSize * gridSize), MIN_LAYOUT_SCALE, 1.0f);
+
+		m_Layout = Style;
+		m_Layout.CellSize = (int)(Style.CellSize * scale);
+		m_Layout.BlockSize = (int)(Style.BlockSize * scale);
+		m_Layout.NumberFontSize = std::max((int)(Style.NumberFontSize * scale), MIN_FONT_SIZE);
+		m_Layout.GuessFontSize = std::max((int)(Style.GuessFontSize * (gridSize > 9 ? 0.75f : 1.0f) * scale), MIN_FONT_SIZE);
+	}
+
 	void Grid::Reset()
 	{
-		for (auto& cell : m_CellData)
-		{
-			cell.Guesses.reset();
-			if (!cell.Locked)
-			{
-				cell.Number = 0;
-			}
-		}
-		m_PlayerWon = false;
+		ClearHint();
+		m_Model.Reset();
 	}
 
 	void Grid::NewBoard(bool useDefaultSize, bool showNotification)
 	{
-		ChangeGridSize(useDefaultSize || (m_GridSize == 0) ? DEFAULT_GRID_SIZE : m_GridSize, false);
+		ClearHint();
+		m_Model.NewBoard(useDefaultSize);
 
 		if (showNotification)
 		{
-			Application::Get().GetNotifications().AddNotification(LOG_INFO, fmt::format("Starting Editor {0}x{0}", m_GridSize));
+			Application::Get().GetNotifications().AddNotification(LOG_INFO, fmt::format("Starting Editor {0}x{0}", m_Model.GetGridSize()));
 		}
 	}
 
 	void Grid::OnHandleNumber(uint8_t number)
 	{
-		if (!HasValidData())
-		{
-			return;
-		}
-
-		if (m_State.EditMode)
-		{
-			if (m_State.AltMode)
-			{
-				ChangeGridSize(number);
-			}
-			else if (!(number < 0 || number > m_GridSize))
-			{
-				ToggleLock(number);
-			}
-		}
-		else
-		{
-			if (number < 0 || number > m_GridSize)
-			{
-				return;
-			}
-
-			if (m_State.AltMode)
-			{
-				ToggleGuess(number);
-			}
-			else
-			{
-				ToggleNumber(number);
-			}
-		}
+		ClearHint();
+		m_Model.OnHandleNumber(m_Model.GetGridState().HighDigits ? number + 10 : number);
 	}
 
-	void Grid::ToggleGuess(uint8_t guess)
+	void Grid::OnChangeSelection(int x, int y)
 	{
-		CellData& cell = GetCellData(m_SelectedCol, m_SelectedRow);
-		if (cell.Number)
-		{
-			cell.Number = 0;
-		}
-
-		cell.Guesses.flip(guess - 1);
+		m_Model.OnChangeSelection(x, y);
 	}
 
-	void Grid::ToggleNumber(uint8_t number)
+	const GridState& Grid::GetGridState() const
 	{
-		CellData& cell = GetCellData(m_SelectedCol, m_SelectedRow);
-		if (cell.Guesses.any())
-		{
-			cell.Guesses.reset();
-		}
-
-		if (cell.Number == number)
-		{
-			cell.Number = 0;
-		}
-		else
-		{
-			cell.Number = number;
-		}
+		return m_Model.GetGridState();
 	}
 
-	void Grid::ToggleLock(uint8_t number)
+	void Grid::SetAltMode(bool altMode)
 	{
-		CellData& cell = GetCellData(m_SelectedCol, m_SelectedRow);
-		if (cell.Locked && cell.Number == number)
-		{
-			UnlockCell(m_SelectedCol, m_SelectedRow);
-		}
-		else
-		{
-			LockCell(m_SelectedCol, m_SelectedRow, number);
-		}
+		m_Model.SetAltMode(altMode);
 	}
 
-	void Grid::ToggleConstraint(int x, int y)
+	void Grid::SetEditMode(bool editMode)
 	{
-		bool isFlipped = false;
-		const int offset = GetConstraintIndex(m_SelectedCol, m_SelectedRow, m_SelectedCol + x, m_SelectedRow + y, isFlipped);
-		if (offset == -1)
-		{
-			AddGreaterThanConstraint(m_SelectedCol, m_SelectedRow, m_SelectedCol + x, m_SelectedRow + y);
-		}
-		else
-		{
-			if (isFlipped)
-			{
-				FlipGreaterThanConstraint(offset);
-			}
-			else
-			{
-				RemoveGreaterThanConstraint(m_SelectedCol, m_SelectedRow, m_SelectedCol + x, m_SelectedRow + y);
-			}
-		}
+		ClearHint();
+		m_Model.SetEditMode(editMode);
 	}
 
-	void Grid::OnChangeSelection(int x, int y)
+	void Grid::SetHighDigits(bool highDigits)
 	{
-		if (!HasValidData())
-		{
-			return;
-		}
-
-
-
-		if (m_State.EditMode)
-		{
-			if (m_State.AltMode)
-			{
-				ToggleConstraint(x, y);
-			}
-			else
-			{
-				m_SelectedCol += x;
-				m_SelectedRow += y;
-
-				m_SelectedCol = (m_SelectedCol + m_GridSize) % m_GridSize;
-				m_SelectedRow = (m_SelectedRow + m_GridSize) % m_GridSize;
-			}
-		}
-		else
-		{
-			if (!IsCellValid(m_SelectedCol + x, m_SelectedRow + y))
-			{
-				return;
-			}
-
-
-			if (IsCellLocked(m_SelectedCol + x, m_SelectedRow + y))
-			{
-				int multiplier = 2;
-				while (IsCellValid(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y) 
-					&& IsCellLocked(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y))
-				{
-					multiplier++;
-				}
-
-				if (IsCellValid(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y))
-				{
-					OnChangeSelection(multiplier * x, multiplier * y);
-				}
-			}
-			else
-			{
-				m_SelectedCol += x;
-				m_SelectedRow += y;
-			}
-		}
+		m_Model.SetHighDigits(highDigits);
 	}
 
-	void Grid::ChangeGridSize(uint8_t gridSize, bool retainData)
+	void Grid::Undo()
 	{
-		if (!retainData)
-		{
-			for (uint8_t y = 0; y < m_GridSize; ++y)
-			{
-				for (uint8_t x = 0; x < m_GridSize; ++x)
-				{
-					CellData& cell = GetCellData(x, y);
-					cell.Guesses.reset();
-					cell.Number = 0;
-					cell.Locked = false;
-				}
-			}
-
-			m_GridSize = gridSize;
-			m_GridSize = gridSize;
-			m_TargetSum = gridSize * (gridSize * (gridSize + 1) / 2);
-
-			m_CellData.resize(gridSize * gridSize);
-
-			m_Constraints.clear();
-		}
-		else
-		{
-			struct TempLockedCell
-			{
-				uint8_t x;
-				uint8_t y;
-				int value;
-			};
-
-			std::vector<TempLockedCell> lockedCells;
-			for (uint8_t y = 0; y < m_GridSize; ++y)
-			{
-				for (uint8_t x = 0; x < m_GridSize; ++x)
-				{
-					CellData& cell = GetCellData(x, y);
-					if (cell.Locked)
-					{
-						TempLockedCell& lockedCell = lockedCells.emplace_back();
-						lockedCell.x = x;
-						lockedCell.y = y;
-						lockedCell.value = cell.Number;
-					}
-
-					cell.Guesses.reset();
-					cell.Number = 0;
-					cell.Locked = false;
-				}
-			}
-
-			m_GridSize = gridSize;
-			m_GridSize = gridSize;
-			m_TargetSum = gridSize * (gridSize * (gridSize + 1) / 2);
-
-			m_CellData.resize(gridSize * gridSize);
-
-			for (auto& itr = m_Constraints.begin(); itr != m_Constraints.end();)
-			{
-				if (itr->IsViolated(gridSize))
-				{
-					itr = m_Constraints.erase(itr);
-				}
-				else
-				{
-					itr = std::next(itr);
-				}
-			}
-
-			for (const auto& lockedCell : lockedCells)
-			{
-				LockCell(lockedCell.x, lockedCell.y, lockedCell.value);
-			}
-		}
+		ClearHint();
+		m_Model.Undo();
 	}
 
-	void Grid::LockCell(uint8_t x, uint8_t y, uint8_t number, bool suppressNotifications)
+	void Grid::Redo()
 	{
-		if (!IsCellValid(x, y) || (number > m_GridSize))
-		{
-			if (!suppressNotifications)
-			{
-				Application::Get().GetNotifications().AddNotification(LOG_WARNING, "Cell position out of grid.");
-			}
-			return;
-		}
-
-		CellData& cell = GetCellData(x, y);
-		cell.Guesses.reset();
-		cell.Locked = true;
-		cell.Number = number;
+		ClearHint();
+		m_Model.Redo();
 	}
 
-	void Grid::UnlockCell(uint8_t x, uint8_t y)
+	void Grid::SetAutoCandidates(bool autoCandidates)
 	{
-		if (!IsCellValid(x, y))
-		{
-			return;
-		}
+		m_Model.SetAutoCandidates(autoCandidates);
+	}
 
-		CellData& cell = GetCellData(x, y);
-		cell.Locked = false;
-		cell.Number = 0;
+	Serialization::LevelData Grid::GetSaveData(const Grid& grid)
+	{
+		return GridModel::GetSaveData(grid.m_Model);
 	}
 
-	void Grid::AddGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool suppressNotifications)
+	void Grid::LoadFromData(const Serialization::LevelData& levelData)
 	{
-		if (x1 == x2 && y1 == y2)
+		ClearHint();
+		std::vector<GridEditResult> rejected;
+		m_Model.LoadFromData(levelData, &rejected);
+
+		Notifications& notifications = Application::Get().GetNotifications();
+		for (const GridEditResult result : rejected)
 		{
-			if (!suppressNotifications)
+			switch (result)
+			{
+			case GridEditResult::CELL_OUT_OF_GRID:
 			{
-				Application::Get().GetNotifications().AddNotification(LOG_ERROR, "Constraint: same cell.");
+				notifications.AddNotification(LOG_WARNING, "Cell position out of grid.");
+				break;
 			}
-			return;
-		}
-
-		if (!IsCellValid(x1, y1) || !IsCellValid(x2, y2))
-		{
-			if (!suppressNotifications)
+			case GridEditResult::CONSTRAINT_SAME_CELL:
 			{
-				Application::Get().GetNotifications().AddNotification(LOG_WARNING, "Constraint: out of grid.");
+				notifications.AddNotification(LOG_ERROR, "Constraint: same cell.");
+				break;
 			}
-			return;
-		}
-
-		if ((std::abs(x1 - x2) > 1) || (std::abs(y1 - y2) > 1))
-		{
-			if (!suppressNotifications)
+			case GridEditResult::CONSTRAINT_OUT_OF_GRID:
 			{
-				Application::Get().GetNotifications().AddNotification(LOG_ERROR, "Constraint: not in adjacent cells.");
+				notifications.AddNotification(LOG_WARNING, "Constraint: out of grid.");
+				break;
 			}
-			return;
-		}
-
-		ConstraintData& data = m_Constraints.emplace_back();
-		data.X1 = x1;
-		data.Y1 = y1;
-		data.X2 = x2;
-		data.Y2 = y2;
-	}
-
-	void Grid::RemoveGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
-	{
-		for (auto& itr = m_Constraints.begin(); itr != m_Constraints.end();)
-		{
-			if (itr->X1 == x1
-				&& itr->Y1 == y1
-				&& itr->X2 == x2
-				&& itr->Y2 == y2)
+			case GridEditResult::CONSTRAINT_NOT_ADJACENT:
 			{
-				m_Constraints.erase(itr);
+				notifications.AddNotification(LOG_ERROR, "Constraint: not in adjacent cells.");
 				break;
 			}
-			else
+			case GridEditResult::GRID_SIZE_NOT_SUPPORTED:
 			{
-				itr = std::next(itr);
+				notifications.AddNotification(LOG_ERROR, fmt::format("Grids larger than {0}x{0} are not supported.", GridModel::MAX_GRID_SIZE));
+				break;
+			}
+			default:
+				break;
 			}
 		}
 	}
 
-	void Grid::FlipGreaterThanConstraint(int index)
+	bool Grid::PlayerWon() const
 	{
-		std::swap(m_Constraints[index].X1, m_Constraints[index].X2);
-		std::swap(m_Constraints[index].Y1, m_Constraints[index].Y2);
+		return m_Model.PlayerWon();
 	}
 
-	int Grid::GetConstraintIndex(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool& isFlipped) const
+	static std::string FormatCandidates(Solver::CandidateMask candidates)
 	{
-		for (int i = 0; i < m_Constraints.size(); ++i)
+		std::string text;
+		for (uint8_t digit = 1; candidates; ++digit, candidates >>= 1)
 		{
-			if (m_Constraints[i].X1 == x1
-				&& m_Constraints[i].Y1 == y1
-				&& m_Constraints[i].X2 == x2
-				&& m_Constraints[i].Y2 == y2)
-			{
-				return i;
-			}
-			else if (m_Constraints[i].X1 == x2
-				&& m_Constraints[i].Y1 == y2
-				&& m_Constraints[i].X2 == x1
-				&& m_Constraints[i].Y2 == y1)
+			if (candidates & 1)
 			{
-				isFlipped = true;
-				return i;
+				text += text.empty() ? std::to_string(digit) : fmt::format(", {}", digit);
 			}
-
 		}
-
-		return -1;
+		return text;
 	}
 
-	Serialization::LevelData Grid::GetSaveData(const Grid& grid)
+	void Grid::ShowHint()
 	{
-		Serialization::LevelData data;
-		data.GridSize = grid.m_GridSize;
-		for (uint8_t y = 0; y < grid.m_GridSize; ++y)
-		{
-			for (uint8_t x = 0; x < grid.m_GridSize; ++x)
-			{
-				const CellData& cell = grid.m_CellData[y * grid.m_GridSize + x];
-				if (cell.Locked)
-				{
-					Serialization::LockedNumber& lockedCell = data.LockedCells.emplace_back();
-					lockedCell.X = x;
-					lockedCell.Y = y;
-					lockedCell.Val = cell.Number;
-				}
-			}
-		}
-
-		for (const auto& constraint : grid.m_Constraints)
+		if (m_Model.GetGridState().EditMode || m_Model.PlayerWon() || !HasValidData())
 		{
-			Serialization::GreaterThanConstraint& gtConstraint = data.GreaterThanConstraints.emplace_back();
-			gtConstraint.X1 = constraint.X1;
-			gtConstraint.Y1 = constraint.Y1;
-			gtConstraint.X2 = constraint.X2;
-			gtConstraint.Y2 = constraint.Y2;
+			return;
 		}
 
-		return data;
-	}
+		m_Hint = m_Model.FindHint();
+		m_HintVisible = m_Hint.Rule != Solver::HintRule::NONE;
 
-	void Grid::LoadFromData(const Serialization::LevelData& levelData)
-	{
-		if (levelData.GridSize == 0)
+		Notifications& notifications = Application::Get().GetNotifications();
+		const uint8_t row = m_Hint.Cell.Y + 1;
+		const uint8_t col = m_Hint.Cell.X + 1;
+		switch (m_Hint.Rule)
 		{
-			m_GridSize = levelData.GridSize;
-			m_GridSize = levelData.GridSize;
-			m_TargetSum = levelData.GridSize * (levelData.GridSize * (levelData.GridSize + 1) / 2);
-
-			m_CellData.clear();
-			m_Constraints.clear();
-			return;
+		case Solver::HintRule::NONE:
+		{
+			notifications.AddNotification(LOG_INFO, "No hint found.");
+			break;
 		}
-
-		m_GridSize = levelData.GridSize;
-		m_GridSize = levelData.GridSize;
-		m_TargetSum = levelData.GridSize * (levelData.GridSize * (levelData.GridSize + 1) / 2);
-
-		m_CellData.resize(levelData.GridSize * levelData.GridSize);
-		m_Constraints.clear();
-
-		for (auto& cell : m_CellData)
+		case Solver::HintRule::CONFLICT:
 		{
-			cell.Guesses.reset();
-			cell.Locked = false;
-			cell.Number = 0;
+			notifications.AddNotification(LOG_WARNING, fmt::format("Conflict: row {}, column {} breaks a rule.", row, col));
+			break;
 		}
-
-		const bool suppressNotifications = false;
-
-		for (const auto& lockedCell : levelData.LockedCells)
+		case Solver::HintRule::DEAD_END:
 		{
-			LockCell(lockedCell.X, lockedCell.Y, lockedCell.Val, suppressNotifications);
+			notifications.AddNotification(LOG_WARNING, fmt::format("Dead end: no number fits row {}, column {}.", row, col));
+			break;
 		}
-
-		for (uint8_t i = 0; i < m_CellData.size(); ++i)
+		default:
 		{
-			if (!m_CellData[i].Locked)
+			if (m_Hint.Number)
 			{
-				m_SelectedCol = i % m_GridSize;
-				m_SelectedRow = i / m_GridSize;
-				break;
+				notifications.AddNotification(LOG_INFO, fmt::format("{}: row {}, column {} is {}.", Solver::ToString(m_Hint.Rule), row, col, m_Hint.Number));
+			}
+			else
+			{
+				notifications.AddNotification(LOG_INFO, fmt::format("{}: row {}, column {} can only be {}.", Solver::ToString(m_Hint.Rule), row, col, FormatCandidates(m_Hint.Candidates)));
 			}
+			break;
 		}
-
-		for (const auto& constraint : levelData.GreaterThanConstraints)
-		{
-			AddGreaterThanConstraint(constraint.X1, constraint.Y1, constraint.X2, constraint.Y2, suppressNotifications);
 		}
-
-		m_PlayerWon = false;
 	}
 
-	bool Grid::PlayerWon() const
+	void Grid::ClearHint()
 	{
-		return m_PlayerWon;
+		m_HintVisible = false;
 	}
 
 	void Grid::DrawHelpText(int x, int y)
@@ -621,7 +353,7 @@ namespace Engine
 		const float  fontSize = 20;
 		const float  lineSpacing = fontSize * 1.1f;
 
-		if (m_State.EditMode)
+		if (m_Model.GetGridState().EditMode)
 		{
 			DrawText("Ctrl + WASD/Arrow Keys = Toggle Constraint", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
@@ -632,6 +364,12 @@ namespace Engine
 			DrawText("Ctrl + Num = Set Grid Size", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
 
+			DrawText("Shift + 0-6 = Numbers 10-16", startX, startY, fontSize, GRAY);
+			startY += lineSpacing;
+
+			DrawText("U/Y = Undo/Redo", startX, startY, fontSize, GRAY);
+			startY += lineSpacing;
+
 			DrawText("F = Save As New Level", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
 
@@ -644,6 +382,20 @@ namespace Engine
 			DrawText("Ctrl + R = New Level", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
 
+			const Solver::Uniqueness uniqueness = m_Model.GetUniqueness();
+			Color uniquenessColor = GRAY;
+			if (uniqueness == Solver::Uniqueness::UNIQUE)
+			{
+				uniquenessColor = DARKGREEN;
+			}
+			else if (uniqueness != Solver::Uniqueness::UNKNOWN)
+			{
+				uniquenessColor = RED;
+			}
+
+			DrawText(fmt::format("Solutions: {}", Solver::ToString(uniqueness)).c_str(), startX, startY, fontSize, uniquenessColor);
+			startY += lineSpacing;
+
 			DrawText("MODE: EDIT", 10, GetScreenHeight() - 50, 40, BLUE);
 		}
 		else
@@ -654,9 +406,24 @@ namespace Engine
 			DrawText("Num = Number", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
 
+			if (m_Model.GetGridSize() > 9)
+			{
+				DrawText("Shift + 0-6 = Numbers 10-16", startX, startY, fontSize, GRAY);
+				startY += lineSpacing;
+			}
+
 			DrawText("WASD/Arrow Keys = Navigation", startX, startY, fontSize, GRAY);
 			startY += lineSpacing;
 
+			DrawText("H = Hint", startX, startY, fontSize, GRAY);
+			startY += lineSpacing;
+
+			DrawText("C = Auto Candidates", startX, startY, fontSize, GRAY);
+			startY += lineSpacing;
+
+			DrawText("U/Y = Undo/Redo", startX, startY, fontSize, GRAY);
+			startY += lineSpacing;
+
 			DrawText("R = Reset", startX, startY, fontSize, RED);
 			startY += lineSpacing;
 
@@ -669,7 +436,7 @@ namespace Engine
 		DrawText("P = Play", startX, startY, fontSize, GRAY);
 		startY += lineSpacing;
 
-		if (m_PlayerWon)
+		if (m_Model.PlayerWon())
 		{
 			const float width = MeasureText("You won!", 64);
 			DrawText("You won!", 0.5f * (GetScreenWidth() - width), GetScreenHeight() - 80, 64, BLACK);
@@ -678,40 +445,42 @@ namespace Engine
 
 	void Grid::DrawBlock(const CellData& cell, uint8_t x, uint8_t y, const Vector2& blockPosition)
 	{
-		if (!cell.Locked || m_State.EditMode)
+		if (!cell.Locked || m_Model.GetGridState().EditMode)
 		{
-			if (m_SelectedRow == y && m_SelectedCol == x && !m_PlayerWon)
+			if (m_Model.GetSelectedRow() == y && m_Model.GetSelectedCol() == x && !m_Model.PlayerWon())
 			{
-				DrawRectangle((int)blockPosition.x, (int)blockPosition.y, Style.BlockSize, Style.BlockSize, Style.SelectionColor);
+				DrawRectangle((int)blockPosition.x, (int)blockPosition.y, m_Layout.BlockSize, m_Layout.BlockSize, Style.SelectionColor);
 			}
 
-			DrawRectangleLines((int)blockPosition.x, (int)blockPosition.y, Style.BlockSize, Style.BlockSize, Style.BlockBorderColor);
+			DrawRectangleLines((int)blockPosition.x, (int)blockPosition.y, m_Layout.BlockSize, m_Layout.BlockSize, Style.BlockBorderColor);
 		}
 		else
 		{
-			DrawRectangle((int)blockPosition.x, (int)blockPosition.y, Style.BlockSize, Style.BlockSize, Style.LockedBlockColor);
+			DrawRectangle((int)blockPosition.x, (int)blockPosition.y, m_Layout.BlockSize, m_Layout.BlockSize, Style.LockedBlockColor);
 		}
 	}
 
 	void Grid::DrawGuess(const CellData& cell, uint8_t x, uint8_t y, const Vector2& blockPosition)
 	{
-		if (m_State.EditMode || !cell.Guesses.any())
+		if (m_Model.GetGridState().EditMode || !cell.Guesses)
 		{
 			return;
 		}
 
-		const float offset = Style.BlockSize / 3.0f;
-		for (uint8_t i = 0; i < 9; ++i)
+		// 3x3 guesses up to 9x9 grids, 4x4 above
+		const uint8_t guessColumns = m_Model.GetGridSize() > 9 ? 4 : 3;
+		const float offset = (float)m_Layout.BlockSize / guessColumns;
+		for (uint8_t i = 0; i < m_Model.GetGridSize(); ++i)
 		{
-			if (cell.Guesses[i] != 0)
+			if (cell.Guesses & DigitBit(i + 1))
 			{
 				const std::string text = std::to_string(i + 1);
-				Vector2 textDims = MeasureTextEx(GetFontDefault(), text.c_str(), (float)Style.GuessFontSize, offset);
+				Vector2 textDims = MeasureTextEx(GetFontDefault(), text.c_str(), (float)m_Layout.GuessFontSize, offset);
 
 				DrawText(text.c_str(),
-					(int)(blockPosition.x + (i % 3) * offset + 0.5f * (offset - textDims.x)),
-					(int)(blockPosition.y + (i / 3) * offset + 0.5f * (offset - textDims.y)),
-					Style.GuessFontSize, Style.GuessFontColor);
+					(int)(blockPosition.x + (i % guessColumns) * offset + 0.5f * (offset - textDims.x)),
+					(int)(blockPosition.y + (i / guessColumns) * offset + 0.5f * (offset - textDims.y)),
+					m_Layout.GuessFontSize, Style.GuessFontColor);
 			}
 		}
 	}
@@ -723,250 +492,73 @@ namespace Engine
 			return;
 		}
 
-		if (m_State.EditMode && !cell.Locked)
+		if (m_Model.GetGridState().EditMode && !cell.Locked)
 		{
 			return;
 		}
 
 		const std::string text = std::to_string(cell.Number);
-		Vector2 textDims = MeasureTextEx(GetFontDefault(), text.c_str(), (float)Style.NumberFontSize, (float)Style.NumberFontSize);
+		Vector2 textDims = MeasureTextEx(GetFontDefault(), text.c_str(), (float)m_Layout.NumberFontSize, (float)m_Layout.NumberFontSize);
 
 		Color fontColor = Style.NumberFontColor;
-		if (!m_State.EditMode && cell.Locked)
+		if (!m_Model.GetGridState().EditMode && cell.Locked)
 		{
 			fontColor = Style.LockedFontColor;
 		}
 
 		// If not satisfying constraints mark as wrong
-		if (CheckCellHasError(x, y))
+		if (m_Model.CheckCellHasError(x, y))
 		{
 			fontColor = Style.WrongFontColor;
 		}
 
 
 		DrawText(text.c_str(),
-			(int)(blockPosition.x + 0.5f * (Style.BlockSize - textDims.x)),
-			(int)(blockPosition.y + 0.5f * (Style.BlockSize - textDims.y)),
-			Style.NumberFontSize, fontColor);
-
-	}
-
-	Grid::CellData& Grid::GetCellData(uint8_t x, uint8_t y)
-	{
-		return m_CellData[y * m_GridSize + x];
-	}
-
-	const Grid::CellData& Grid::GetCellData(uint8_t x, uint8_t y)const
-	{
-		return m_CellData[y * m_GridSize + x];
-	}
-
-	const bool Grid::IsCellLocked(uint8_t x, uint8_t y) const
-	{
-		return m_CellData[y * m_GridSize + x].Locked;
-	}
-
-	const bool Grid::IsCellValid(uint8_t x, uint8_t y) const
-	{
-		return (x >= 0 && x < m_GridSize)
-			&& (y >= 0 && y < m_GridSize);
-	}
-
-	bool Grid::CheckColHasError(uint8_t col) const
-	{
-		const uint8_t offset = 9;
-		return m_Errors[offset + col];
-	}
-
-	bool Grid::CheckRowHasError(uint8_t row) const
-	{
-		return m_Errors[row];
-	}
-
-	bool Grid::CheckCellHasError(uint8_t x, uint8_t y) const
-	{
-		const uint8_t offset = 18;
-		return m_Errors[offset + 9 * y + x];
-	}
-
-	void Grid::MarkErrorColumn(uint8_t col)
-	{
-		const uint8_t offset = 9;
-		m_Errors.set(offset + col);
-	}
-
-	void Grid::MarkErrorRow(uint8_t row)
-	{
-		m_Errors.set(row);
-	}
+			(int)(blockPosition.x + 0.5f * (m_Layout.BlockSize - textDims.x)),
+			(int)(blockPosition.y + 0.5f * (m_Layout.BlockSize - textDims.y)),
+			m_Layout.NumberFontSize, fontColor);
 
-	void Grid::MarkErrorCell(uint8_t x, uint8_t y)
-	{
-		const uint8_t offset = 18;
-		m_Errors.set(offset + 9 * y + x);
 	}
 
-	void Grid::ClearAllErrors()
+	void Grid::DrawHint()
 	{
-		m_Errors.reset();
-	}
+		const Vector2 blockOffset{ 0.5f * (m_Layout.CellSize - m_Layout.BlockSize), 0.5f * (m_Layout.CellSize - m_Layout.BlockSize) };
+		const float thickness = std::max(2.0f, 0.05f * m_Layout.BlockSize);
 
-	void Grid::CheckConstraints()
-	{
-		bool allConstraintsSatisfied = true;
-		uint8_t currentSum = 0;
-		// Row Constraints
+		for (uint8_t i = 0; i < m_Hint.ReasonCount; ++i)
 		{
-			std::unordered_map<uint8_t, uint8_t> rowState;
-
-			for (uint8_t y = 0; y < m_GridSize; ++y)
-			{
-				rowState.clear();
-				for (uint8_t x = 0; x < m_GridSize; ++x)
-				{
-					CellData& cell = GetCellData(x, y);
-					currentSum += cell.Number;
-					if (cell.Number == 0)
-					{
-						continue;
-					}
-
-					if (rowState.find(cell.Number) != rowState.end())
-					{
-						MarkErrorRow(y);
-						MarkErrorCell(rowState.at(cell.Number), y);
-						MarkErrorCell(x, y);
-
-						allConstraintsSatisfied &= false;
-					}
-
-					rowState.emplace(cell.Number, x);
-				}
-			}
+			const Solver::HintCell& reason = m_Hint.Reasons[i];
+			const Vector2 position = Vector2Add(m_Origin, Vector2{ (float)m_Layout.CellSize * reason.X + blockOffset.x, (float)m_Layout.CellSize * reason.Y + blockOffset.y });
+			DrawRectangleLinesEx(Rectangle{ position.x, position.y, (float)m_Layout.BlockSize, (float)m_Layout.BlockSize }, thickness, Style.HintReasonColor);
 		}
 
-		// Col Constraints
-		{
-			std::unordered_map<uint8_t, uint8_t> colState;
-			for (uint8_t x = 0; x < m_GridSize; ++x)
-			{
-				colState.clear();
-				for (uint8_t y = 0; y < m_GridSize; ++y)
-				{
-					CellData& cell = GetCellData(x, y);
-					if (cell.Number == 0)
-					{
-						continue;
-					}
-
-					if (colState.find(cell.Number) != colState.end())
-					{
-						MarkErrorColumn(x);
-						MarkErrorCell(x, colState.at(cell.Number));
-						MarkErrorCell(x, y);
-						allConstraintsSatisfied &= false;
-					}
-
-					colState.emplace(cell.Number, y);
-				}
-			}
-		}
-
-		if (m_Constraints.size())
-		{
-			for (const auto& constraint : m_Constraints)
-			{
-				if (!constraint.IsSatisfied(*this))
-				{
-					MarkErrorCell(constraint.X1, constraint.Y1);
-					MarkErrorCell(constraint.X2, constraint.Y2);
-
-					if (constraint.IsRowConstraint())
-					{
-						MarkErrorRow(constraint.Y1);
-					}
-
-					if (constraint.IsColConstraint())
-					{
-						MarkErrorColumn(constraint.X1);
-					}
-
-					allConstraintsSatisfied &= false;
-				}
-			}
-		}
-
-		if (allConstraintsSatisfied)
-		{
-			if (currentSum == m_TargetSum)
-			{
-				m_PlayerWon = true;
-				Application::Get().AddEvent(Event{ EventType::PLAYER_WON, {0,0} });
-			}
-		}
-	}
-
-	const GridState& Grid::GetGridState() const
-	{
-		return m_State;
-	}
-
-	void Grid::SetAltMode(bool altMode)
-	{
-		m_State.AltMode = altMode;
-	}
-
-	void Grid::SetEditMode(bool editMode)
-	{
-		m_State.EditMode = editMode;
-		if (m_State.EditMode)
-		{
-			m_PlayerWon = false;
-		}
+		const Color hintColor = m_Hint.Rule == Solver::HintRule::CONFLICT || m_Hint.Rule == Solver::HintRule::DEAD_END ? Style.WrongFontColor : Style.HintColor;
+		const Vector2 position = Vector2Add(m_Origin, Vector2{ (float)m_Layout.CellSize * m_Hint.Cell.X + blockOffset.x, (float)m_Layout.CellSize * m_Hint.Cell.Y + blockOffset.y });
+		DrawRectangleLinesEx(Rectangle{ position.x, position.y, (float)m_Layout.BlockSize, (float)m_Layout.BlockSize }, 2.0f * thickness, hintColor);
 	}
 
 	bool Grid::HasValidData() const
 	{
-		return m_GridSize > 0;
+		return m_Model.HasValidData();
 	}
 
-	bool Grid::ConstraintData::IsSatisfied(const Grid& grid) const
+	bool Grid::HasErrors() const
 	{
-		const Grid::CellData& cell1 = grid.GetCellData(X1, Y1);
-		const Grid::CellData& cell2 = grid.GetCellData(X2, Y2);
-
-		if (cell1.Number == 0 || cell2.Number == 0)
-		{
-			return true;
-		}
-
-		return cell1.Number > cell2.Number;
-	}
-
-	bool Grid::ConstraintData::IsRowConstraint() const
-	{
-		return Y1 == Y2;
+		return m_Model.HasErrors();
 	}
 
-	bool Grid::ConstraintData::IsColConstraint() const
-	{
-		return X1 == X2;
-	}
-	bool Grid::ConstraintData::FaceLeft() const
+	Solver::Uniqueness Grid::CheckUniqueness()
 	{
-		return X1 > X2;
+		return m_Model.CheckUniqueness();
 	}
 
-	bool Grid::ConstraintData::FaceUp() const
+	GridModel& Grid::GetModel()
 	{
-		return Y1 > Y2;
+		return m_Model;
 	}
 
-	bool Grid::ConstraintData::IsViolated(uint8_t gridSize) const
+	const GridModel& Grid::GetModel() const
 	{
-		return ((X1 < 0 || X1 >= gridSize)
-			|| (X2 < 0 || X2 >= gridSize)
-			|| (Y1 < 0 || Y1 >= gridSize)
-			|| (Y2 < 0 || Y2 >= gridSize));
+		return m_Model;
 	}
-}
\ No newline at end of file
+}
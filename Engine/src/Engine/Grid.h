@@ -2,10 +2,10 @@
 #include "raylib.h"
 #include <stdint.h>
 #include <vector>
-#include <bitset>
-#include <unordered_set>
 
+#include "GridModel.h"
 #include "Serialization/LevelData.h"
+#include "Solver/Solver.h"
 #include "Events.h"
 
 #define ALT_MODE_ON 1
@@ -30,7 +30,9 @@ namespace Engine
 		Color LockedBlockColor = LIGHTGRAY;
 		Color BlockBorderColor = BLACK;
 		Color ConstraintColor = BLACK;
-		
+		Color HintColor = Color{ 0, 158, 47, 255 };
+		Color HintReasonColor = Color{ 102, 191, 255, 255 };
+
 		float TriangleWidthPercent = 0.7f;
 		float TriangleHeightPercent = 0.6f;
 
@@ -41,39 +43,13 @@ namespace Engine
 		int BlockSize = 72;
 	};
 
-	struct GridState
-	{
-		bool AltMode = false;
-		bool EditMode = false;
-	};
-
+	// Draws a GridModel and reports its results through the Application (events and notifications).
 	class Grid
 	{
 	private:
-		struct CellData
-		{
-			std::bitset<9> Guesses{ 0 };
-			uint8_t Number{ 0 };
-			bool Locked = false;
-		};
-
-		struct ConstraintData
-		{
-			uint8_t X1, Y1;
-			uint8_t X2, Y2;
-
-			bool IsSatisfied(const Grid& grid) const;
-			bool IsRowConstraint() const;
-			bool IsColConstraint() const;
-			bool FaceLeft() const;
-			bool FaceUp() const;
-			bool IsViolated(uint8_t gridSize) const;
-		};
+		using CellData = GridModel::CellData;
 
 	public:
-		static const uint8_t DEFAULT_GRID_SIZE = 4;
-
-
 		Grid(GridStyle style = GridStyle{});
 
 		void Update();
@@ -87,72 +63,56 @@ namespace Engine
 		const GridState& GetGridState()const;
 		void SetAltMode(bool altMode);
 		void SetEditMode(bool editMode);
-		
-		// Will result in loss of data when changing the grid size to a lower one.
-		void ChangeGridSize(uint8_t gridSize,bool retainData = true);
-
-		void LockCell(uint8_t x, uint8_t y, uint8_t number, bool suppressNotifications = true);
-		void UnlockCell(uint8_t x, uint8_t y);
-		
-		void AddGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool suppressNotifications = true);
-		void RemoveGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+		void SetHighDigits(bool highDigits);
+		void SetAutoCandidates(bool autoCandidates);
 
 		static Serialization::LevelData GetSaveData(const Grid& grid);
 		void LoadFromData(const Serialization::LevelData& levelData);
 
 		bool PlayerWon() const;
-		
+
+		// Highlights the cells of the next logical step until the board changes.
+		void ShowHint();
+		void ClearHint();
+
+		void Undo();
+		void Redo();
+
 		void DrawHelpText(int x, int y);
 
 		bool HasValidData() const;
+		bool HasErrors() const;
 
-	protected:
-		void ToggleGuess(uint8_t guess);
-		void ToggleNumber(uint8_t number);
-		void ToggleLock(uint8_t number);
-		void ToggleConstraint(int x,int y);
+		// Finishes any pending uniqueness check of the edited level and returns its result.
+		Solver::Uniqueness CheckUniqueness();
 
-		void FlipGreaterThanConstraint(int index);
-		int GetConstraintIndex(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool& isFlipped) const;
+		GridModel& GetModel();
+		const GridModel& GetModel() const;
 
+	protected:
+		// Scales the style down so that a grid of this size fits the window.
+		void UpdateLayout(uint8_t gridSize);
 
 		void DrawBlock(const CellData& cell, uint8_t x, uint8_t y, const Vector2& blockPosition);
 		void DrawGuess(const CellData& cell, uint8_t x, uint8_t y, const Vector2& blockPosition);
 		void DrawNumber(const CellData& cell, uint8_t x, uint8_t y, const Vector2& blockPosition);
-	
-		CellData& GetCellData(uint8_t x, uint8_t y);
-		const CellData& GetCellData(uint8_t x, uint8_t y)const;
-		const bool IsCellLocked(uint8_t x, uint8_t y)const;
-		const bool IsCellValid(uint8_t x, uint8_t y)const;
-
-		bool CheckCellHasError(uint8_t x, uint8_t y) const;
-		bool CheckColHasError(uint8_t col) const;
-		bool CheckRowHasError(uint8_t row) const;
-		
-		void MarkErrorColumn(uint8_t col);
-		void MarkErrorRow(uint8_t row);
-		void MarkErrorCell(uint8_t x, uint8_t y);
-
-		void ClearAllErrors();
-		void CheckConstraints();
+		void DrawHint();
 
 	public:
 		Vector2 Center;
 		GridStyle Style;
 
 	private:
-		GridState m_State;
-		uint8_t m_GridSize;
+		static const int LAYOUT_MARGIN_X = 10;
+		static const int LAYOUT_MARGIN_Y = 70; // Title and mode text
+		static const int MIN_FONT_SIZE = 10;
+		static constexpr float MIN_LAYOUT_SCALE = 0.25f;
 
-		int m_SelectedRow, m_SelectedCol;
 		Vector2 m_Origin;
+		GridStyle m_Layout;
+		GridModel m_Model;
 
-		std::vector<CellData> m_CellData;
-		std::vector<ConstraintData> m_Constraints;
-
-		std::bitset<99> m_Errors;
-
-		size_t m_TargetSum;
-		bool m_PlayerWon;
+		Solver::Hint m_Hint;
+		bool m_HintVisible = false;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,1271 @@
+#include "GridModel.h"
+#include <algorithm>
+#include <stdlib.h>
+
+#include "DuplicateCheck.h"
+
+namespace Engine
+{
+	GridModel::GridModel()
+		: m_GridSize(0)
+		, m_SelectedRow(0)
+		, m_SelectedCol(0)
+		, m_TargetSum(0)
+		, m_PlayerWon(false)
+	{
+	}
+
+	bool GridModel::Update()
+	{
+		if (!HasValidData())
+		{
+			return false;
+		}
+
+		if (m_State.EditMode)
+		{
+			UpdateUniquenessCheck(UNIQUENESS_CHECK_BUDGET_MS);
+			return false;
+		}
+
+		if (m_State.AutoCandidates && m_Candidates.NeedsRebuild)
+		{
+			RebuildCandidates();
+		}
+
+		// Errors are only shown while playing, and nothing needs validating on idle frames.
+		if (m_PlayerWon || !IsValidationDirty())
+		{
+			return false;
+		}
+
+		if (m_Validation.NeedsRebuild)
+		{
+			RebuildValidationState();
+			ClearAllErrors();
+			CheckConstraints();
+			return m_PlayerWon;
+		}
+
+		RefreshDirtyErrors();
+
+		if (m_Validation.DuplicateCount == 0
+			&& m_Validation.ViolationCount == 0
+			&& m_Validation.CurrentSum == m_TargetSum)
+		{
+			m_PlayerWon = true;
+		}
+
+		return m_PlayerWon;
+	}
+
+	void GridModel::Reset()
+	{
+		// One undo step brings the whole board back.
+		m_Journal.BeginStep();
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const size_t cell = m_Board.GetIndex(x, y);
+				const uint8_t oldNumber = m_Board.Numbers[cell];
+				const uint16_t oldGuesses = m_Board.Guesses[cell];
+
+				m_Board.Guesses[cell] = 0;
+				if (!m_Board.IsLocked(x, y))
+				{
+					m_Board.Numbers[cell] = 0;
+				}
+
+				RecordCellChange(cell, oldNumber, oldGuesses, m_Board.IsLocked(x, y));
+			}
+		}
+		m_PlayerWon = false;
+		RequestValidationRebuild();
+	}
+
+	void GridModel::NewBoard(bool useDefaultSize)
+	{
+		ChangeGridSize(useDefaultSize || (m_GridSize == 0) ? DEFAULT_GRID_SIZE : m_GridSize, false);
+	}
+
+	void GridModel::OnHandleNumber(uint8_t number)
+	{
+		if (!HasValidData())
+		{
+			return;
+		}
+
+		if (number == 0 || number > MAX_GRID_SIZE)
+		{
+			return;
+		}
+
+		if (m_State.EditMode)
+		{
+			if (m_State.AltMode)
+			{
+				ChangeGridSize(number);
+			}
+			else if (number <= m_GridSize)
+			{
+				ToggleLock(number);
+			}
+		}
+		else
+		{
+			if (number > m_GridSize)
+			{
+				return;
+			}
+
+			if (m_State.AltMode)
+			{
+				ToggleGuess(number);
+			}
+			else
+			{
+				ToggleNumber(number);
+			}
+		}
+	}
+
+	void GridModel::ToggleGuess(uint8_t guess)
+	{
+		// The board owns the guesses while they are filled in automatically.
+		if (m_State.AutoCandidates)
+		{
+			return;
+		}
+
+		const size_t cell = m_Board.GetIndex(m_SelectedCol, m_SelectedRow);
+		const uint8_t oldNumber = m_Board.Numbers[cell];
+		const uint16_t oldGuesses = m_Board.Guesses[cell];
+
+		if (m_Board.Numbers[cell])
+		{
+			SetCellNumber(m_SelectedCol, m_SelectedRow, 0);
+		}
+
+		m_Board.Guesses[cell] ^= DigitBit(guess);
+
+		m_Journal.BeginStep();
+		RecordCellChange(cell, oldNumber, oldGuesses, m_Board.IsLocked(m_SelectedCol, m_SelectedRow));
+	}
+
+	void GridModel::ToggleNumber(uint8_t number)
+	{
+		const size_t cell = m_Board.GetIndex(m_SelectedCol, m_SelectedRow);
+		const uint8_t oldNumber = m_Board.Numbers[cell];
+		const uint16_t oldGuesses = m_Board.Guesses[cell];
+		m_Board.Guesses[cell] = 0;
+
+		if (m_Board.Numbers[cell] == number)
+		{
+			SetCellNumber(m_SelectedCol, m_SelectedRow, 0);
+		}
+		else
+		{
+			SetCellNumber(m_SelectedCol, m_SelectedRow, number);
+		}
+
+		m_Journal.BeginStep();
+		RecordCellChange(cell, oldNumber, oldGuesses, m_Board.IsLocked(m_SelectedCol, m_SelectedRow));
+	}
+
+	void GridModel::ToggleLock(uint8_t number)
+	{
+		const size_t cell = m_Board.GetIndex(m_SelectedCol, m_SelectedRow);
+		const uint8_t oldNumber = m_Board.Numbers[cell];
+		const uint16_t oldGuesses = m_Board.Guesses[cell];
+		const bool oldLocked = m_Board.IsLocked(m_SelectedCol, m_SelectedRow);
+
+		if (m_Board.IsLocked(m_SelectedCol, m_SelectedRow) && m_Board.GetNumber(m_SelectedCol, m_SelectedRow) == number)
+		{
+			UnlockCell(m_SelectedCol, m_SelectedRow);
+		}
+		else
+		{
+			LockCell(m_SelectedCol, m_SelectedRow, number);
+		}
+
+		m_Journal.BeginStep();
+		RecordCellChange(cell, oldNumber, oldGuesses, oldLocked);
+	}
+
+	void GridModel::ToggleConstraint(int x, int y)
+	{
+		const uint8_t x2 = m_SelectedCol + x;
+		const uint8_t y2 = m_SelectedRow + y;
+
+		m_Journal.BeginStep();
+
+		bool isFlipped = false;
+		const int offset = GetConstraintIndex(m_SelectedCol, m_SelectedRow, x2, y2, isFlipped);
+		if (offset == -1)
+		{
+			if (AddGreaterThanConstraint(m_SelectedCol, m_SelectedRow, x2, y2) == GridEditResult::OK)
+			{
+				RecordConstraintChange(JournalEntryKind::CONSTRAINT_ADD, m_SelectedCol, m_SelectedRow, x2, y2);
+			}
+		}
+		else
+		{
+			if (isFlipped)
+			{
+				FlipGreaterThanConstraint(offset);
+				RecordConstraintChange(JournalEntryKind::CONSTRAINT_FLIP, m_SelectedCol, m_SelectedRow, x2, y2);
+			}
+			else
+			{
+				RemoveGreaterThanConstraint(m_SelectedCol, m_SelectedRow, x2, y2);
+				RecordConstraintChange(JournalEntryKind::CONSTRAINT_REMOVE, m_SelectedCol, m_SelectedRow, x2, y2);
+			}
+		}
+	}
+
+	void GridModel::OnChangeSelection(int x, int y)
+	{
+		if (!HasValidData())
+		{
+			return;
+		}
+
+
+
+		if (m_State.EditMode)
+		{
+			if (m_State.AltMode)
+			{
+				ToggleConstraint(x, y);
+			}
+			else
+			{
+				m_SelectedCol += x;
+				m_SelectedRow += y;
+
+				m_SelectedCol = (m_SelectedCol + m_GridSize) % m_GridSize;
+				m_SelectedRow = (m_SelectedRow + m_GridSize) % m_GridSize;
+			}
+		}
+		else
+		{
+			if (!IsCellValid(m_SelectedCol + x, m_SelectedRow + y))
+			{
+				return;
+			}
+
+
+			if (IsCellLocked(m_SelectedCol + x, m_SelectedRow + y))
+			{
+				int multiplier = 2;
+				while (IsCellValid(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y) 
+					&& IsCellLocked(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y))
+				{
+					multiplier++;
+				}
+
+				if (IsCellValid(m_SelectedCol + multiplier * x, m_SelectedRow + multiplier * y))
+				{
+					OnChangeSelection(multiplier * x, multiplier * y);
+				}
+			}
+			else
+			{
+				m_SelectedCol += x;
+				m_SelectedRow += y;
+			}
+		}
+	}
+
+	void GridModel::ChangeGridSize(uint8_t gridSize, bool retainData)
+	{
+		std::vector<Serialization::LockedNumber> lockedCells;
+		if (retainData)
+		{
+			Serialization::StoreLockedCells(m_Board, lockedCells);
+		}
+		else
+		{
+			m_Constraints.clear();
+		}
+
+		m_GridSize = gridSize;
+		m_TargetSum = gridSize * (gridSize * (gridSize + 1) / 2);
+		m_Board.Resize(gridSize);
+		m_Journal.Clear();
+
+		for (auto& itr = m_Constraints.begin(); itr != m_Constraints.end();)
+		{
+			if (itr->IsViolated(gridSize))
+			{
+				itr = m_Constraints.erase(itr);
+			}
+			else
+			{
+				itr = std::next(itr);
+			}
+		}
+
+		RequestValidationRebuild();
+
+		for (const auto& lockedCell : lockedCells)
+		{
+			LockCell(lockedCell.X, lockedCell.Y, lockedCell.Val);
+		}
+	}
+
+	GridEditResult GridModel::LockCell(uint8_t x, uint8_t y, uint8_t number)
+	{
+		if (!IsCellValid(x, y) || (number > m_GridSize))
+		{
+			return GridEditResult::CELL_OUT_OF_GRID;
+		}
+
+		m_Board.Guesses[m_Board.GetIndex(x, y)] = 0;
+		m_Board.SetLocked(x, y, true);
+		SetCellNumber(x, y, number);
+		m_UniquenessDirty = true;
+		return GridEditResult::OK;
+	}
+
+	void GridModel::UnlockCell(uint8_t x, uint8_t y)
+	{
+		if (!IsCellValid(x, y))
+		{
+			return;
+		}
+
+		m_Board.SetLocked(x, y, false);
+		SetCellNumber(x, y, 0);
+		m_UniquenessDirty = true;
+	}
+
+	GridEditResult GridModel::AddGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+	{
+		if (x1 == x2 && y1 == y2)
+		{
+			return GridEditResult::CONSTRAINT_SAME_CELL;
+		}
+
+		if (!IsCellValid(x1, y1) || !IsCellValid(x2, y2))
+		{
+			return GridEditResult::CONSTRAINT_OUT_OF_GRID;
+		}
+
+		if ((std::abs(x1 - x2) > 1) || (std::abs(y1 - y2) > 1))
+		{
+			return GridEditResult::CONSTRAINT_NOT_ADJACENT;
+		}
+
+		ConstraintData& data = m_Constraints.emplace_back();
+		data.X1 = x1;
+		data.Y1 = y1;
+		data.X2 = x2;
+		data.Y2 = y2;
+
+		RequestValidationRebuild();
+		return GridEditResult::OK;
+	}
+
+	void GridModel::RemoveGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+	{
+		for (auto& itr = m_Constraints.begin(); itr != m_Constraints.end();)
+		{
+			if (itr->X1 == x1
+				&& itr->Y1 == y1
+				&& itr->X2 == x2
+				&& itr->Y2 == y2)
+			{
+				m_Constraints.erase(itr);
+				RequestValidationRebuild();
+				break;
+			}
+			else
+			{
+				itr = std::next(itr);
+			}
+		}
+	}
+
+	void GridModel::FlipGreaterThanConstraint(int index)
+	{
+		std::swap(m_Constraints[index].X1, m_Constraints[index].X2);
+		std::swap(m_Constraints[index].Y1, m_Constraints[index].Y2);
+		RequestValidationRebuild();
+	}
+
+	int GridModel::GetConstraintIndex(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool& isFlipped) const
+	{
+		for (int i = 0; i < m_Constraints.size(); ++i)
+		{
+			if (m_Constraints[i].X1 == x1
+				&& m_Constraints[i].Y1 == y1
+				&& m_Constraints[i].X2 == x2
+				&& m_Constraints[i].Y2 == y2)
+			{
+				return i;
+			}
+			else if (m_Constraints[i].X1 == x2
+				&& m_Constraints[i].Y1 == y2
+				&& m_Constraints[i].X2 == x1
+				&& m_Constraints[i].Y2 == y1)
+			{
+				isFlipped = true;
+				return i;
+			}
+
+		}
+
+		return -1;
+	}
+
+	Serialization::LevelData GridModel::GetSaveData(const GridModel& grid)
+	{
+		Serialization::LevelData data;
+		data.GridSize = grid.m_GridSize;
+		Serialization::StoreLockedCells(grid.m_Board, data.LockedCells);
+
+		for (const auto& constraint : grid.m_Constraints)
+		{
+			Serialization::GreaterThanConstraint& gtConstraint = data.GreaterThanConstraints.emplace_back();
+			gtConstraint.X1 = constraint.X1;
+			gtConstraint.Y1 = constraint.Y1;
+			gtConstraint.X2 = constraint.X2;
+			gtConstraint.Y2 = constraint.Y2;
+		}
+
+		return data;
+	}
+
+	void GridModel::LoadFromData(const Serialization::LevelData& levelData, std::vector<GridEditResult>* outRejected)
+	{
+		if (levelData.GridSize > MAX_GRID_SIZE)
+		{
+			if (outRejected)
+			{
+				outRejected->push_back(GridEditResult::GRID_SIZE_NOT_SUPPORTED);
+			}
+			LoadFromData(Serialization::LevelData(), outRejected);
+			return;
+		}
+
+		if (levelData.GridSize == 0)
+		{
+			m_GridSize = levelData.GridSize;
+			m_TargetSum = levelData.GridSize * (levelData.GridSize * (levelData.GridSize + 1) / 2);
+
+			m_Board.Resize(0);
+			m_Constraints.clear();
+			m_Journal.Clear();
+			RequestValidationRebuild();
+			return;
+		}
+
+		m_GridSize = levelData.GridSize;
+		m_TargetSum = levelData.GridSize * (levelData.GridSize * (levelData.GridSize + 1) / 2);
+
+		m_Board.Resize(levelData.GridSize);
+		m_Constraints.clear();
+		m_Journal.Clear();
+		RequestValidationRebuild();
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			const GridEditResult result = LockCell(lockedCell.X, lockedCell.Y, lockedCell.Val);
+			if (outRejected && result != GridEditResult::OK)
+			{
+				outRejected->push_back(result);
+			}
+		}
+
+		for (size_t i = 0; i < m_Board.GetCellCount(); ++i)
+		{
+			if (!m_Board.IsLocked(i % m_GridSize, i / m_GridSize))
+			{
+				m_SelectedCol = (int)(i % m_GridSize);
+				m_SelectedRow = (int)(i / m_GridSize);
+				break;
+			}
+		}
+
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			const GridEditResult result = AddGreaterThanConstraint(constraint.X1, constraint.Y1, constraint.X2, constraint.Y2);
+			if (outRejected && result != GridEditResult::OK)
+			{
+				outRejected->push_back(result);
+			}
+		}
+
+		m_PlayerWon = false;
+	}
+
+	bool GridModel::PlayerWon() const
+	{
+		return m_PlayerWon;
+	}
+
+	uint8_t GridModel::GetGridSize() const
+	{
+		return m_GridSize;
+	}
+
+	int GridModel::GetSelectedCol() const
+	{
+		return m_SelectedCol;
+	}
+
+	int GridModel::GetSelectedRow() const
+	{
+		return m_SelectedRow;
+	}
+
+	const std::vector<GridModel::ConstraintData>& GridModel::GetConstraints() const
+	{
+		return m_Constraints;
+	}
+
+	GridModel::CellData GridModel::GetCellData(uint8_t x, uint8_t y)const
+	{
+		const size_t cell = m_Board.GetIndex(x, y);
+		const uint16_t guesses = m_State.AutoCandidates && !m_State.EditMode ? GetAutoCandidates(x, y) : m_Board.Guesses[cell];
+		return CellData{ guesses, m_Board.Numbers[cell], m_Board.IsLocked(x, y) };
+	}
+
+	uint16_t GridModel::GetAutoCandidates(uint8_t x, uint8_t y) const
+	{
+		const size_t cell = m_Board.GetIndex(x, y);
+		return m_Candidates.NeedsRebuild || cell >= m_Candidates.Candidates.size() ? 0 : m_Candidates.Candidates[cell];
+	}
+
+	const Serialization::BoardData& GridModel::GetBoard() const
+	{
+		return m_Board;
+	}
+
+	const bool GridModel::IsCellLocked(uint8_t x, uint8_t y) const
+	{
+		return m_Board.IsLocked(x, y);
+	}
+
+	const bool GridModel::IsCellValid(uint8_t x, uint8_t y) const
+	{
+		return (x >= 0 && x < m_GridSize)
+			&& (y >= 0 && y < m_GridSize);
+	}
+
+	bool GridModel::CheckColHasError(uint8_t col) const
+	{
+		return (m_ColErrors >> col) & 1;
+	}
+
+	bool GridModel::CheckRowHasError(uint8_t row) const
+	{
+		return (m_RowErrors >> row) & 1;
+	}
+
+	bool GridModel::CheckCellHasError(uint8_t x, uint8_t y) const
+	{
+		return (m_CellErrors[y] >> x) & 1;
+	}
+
+	static void SetBit(uint16_t& mask, uint8_t bit, bool value)
+	{
+		mask = value ? (uint16_t)(mask | (1u << bit)) : (uint16_t)(mask & ~(1u << bit));
+	}
+
+	void GridModel::MarkErrorColumn(uint8_t col, bool hasError)
+	{
+		SetBit(m_ColErrors, col, hasError);
+	}
+
+	void GridModel::MarkErrorRow(uint8_t row, bool hasError)
+	{
+		SetBit(m_RowErrors, row, hasError);
+	}
+
+	void GridModel::MarkErrorCell(uint8_t x, uint8_t y, bool hasError)
+	{
+		SetBit(m_CellErrors[y], x, hasError);
+	}
+
+	void GridModel::ClearAllErrors()
+	{
+		m_RowErrors = 0;
+		m_ColErrors = 0;
+		m_CellErrors.fill(0);
+	}
+
+	void GridModel::CheckConstraints()
+	{
+		bool allConstraintsSatisfied = true;
+		size_t currentSum = 0;
+		// Row/Col Constraints
+		{
+			uint16_t rowDuplicates[MAX_GRID_SIZE];
+			uint16_t colDuplicates[MAX_GRID_SIZE];
+			const uint8_t* numbers = m_Board.Numbers.data();
+			const uint8_t gridSize = m_GridSize;
+			ComputeDuplicateMasks(gridSize,
+				[numbers, gridSize](uint8_t x, uint8_t y) { return numbers[y * gridSize + x]; },
+				rowDuplicates, colDuplicates);
+
+			for (uint8_t y = 0; y < m_GridSize; ++y)
+			{
+				MarkErrorRow(y, rowDuplicates[y] != 0);
+				MarkErrorColumn(y, colDuplicates[y] != 0);
+
+				for (uint8_t x = 0; x < m_GridSize; ++x)
+				{
+					const uint8_t number = numbers[y * gridSize + x];
+					currentSum += number;
+
+					MarkErrorCell(x, y, ((rowDuplicates[y] | colDuplicates[x]) & DigitBit(number)) != 0);
+				}
+
+				allConstraintsSatisfied &= (rowDuplicates[y] | colDuplicates[y]) == 0;
+			}
+		}
+
+		if (m_Constraints.size())
+		{
+			for (const auto& constraint : m_Constraints)
+			{
+				if (!constraint.IsSatisfied(*this))
+				{
+					MarkErrorCell(constraint.X1, constraint.Y1);
+					MarkErrorCell(constraint.X2, constraint.Y2);
+
+					if (constraint.IsRowConstraint())
+					{
+						MarkErrorRow(constraint.Y1);
+					}
+
+					if (constraint.IsColConstraint())
+					{
+						MarkErrorColumn(constraint.X1);
+					}
+
+					allConstraintsSatisfied &= false;
+				}
+			}
+		}
+
+		if (allConstraintsSatisfied)
+		{
+			if (currentSum == m_TargetSum)
+			{
+				m_PlayerWon = true;
+			}
+		}
+	}
+
+	void GridModel::SetCellNumber(uint8_t x, uint8_t y, uint8_t number)
+	{
+		uint8_t& cellNumber = m_Board.Numbers[m_Board.GetIndex(x, y)];
+		const uint8_t oldNumber = cellNumber;
+		if (oldNumber == number)
+		{
+			return;
+		}
+
+		cellNumber = number;
+
+		if (m_State.AutoCandidates && !m_Candidates.NeedsRebuild)
+		{
+			UpdateCandidatesAround(x, y);
+		}
+		else
+		{
+			m_Candidates.NeedsRebuild = true;
+		}
+
+		// A pending rebuild recounts everything from the cell data anyway.
+		if (m_Validation.NeedsRebuild)
+		{
+			return;
+		}
+
+		UpdateDigitCount(x, y, oldNumber, -1);
+		UpdateDigitCount(x, y, number, 1);
+		m_Validation.CurrentSum = m_Validation.CurrentSum + number - oldNumber;
+
+		for (const uint16_t constraintIndex : m_Validation.CellConstraints[y * m_GridSize + x])
+		{
+			UpdateConstraintViolation(constraintIndex);
+		}
+
+		m_Validation.DirtyRows |= (1u << y);
+		m_Validation.DirtyCols |= (1u << x);
+	}
+
+	void GridModel::UpdateDigitCount(uint8_t x, uint8_t y, uint8_t digit, int delta)
+	{
+		if (digit == 0)
+		{
+			return;
+		}
+
+		const size_t stride = m_GridSize + 1;
+
+		uint8_t& rowCount = m_Validation.RowDigitCount[y * stride + digit];
+		const bool rowHadDuplicate = rowCount > 1;
+		rowCount += delta;
+		if (rowHadDuplicate != (rowCount > 1))
+		{
+			m_Validation.RowDuplicates[y] += delta;
+			m_Validation.DuplicateCount += delta;
+		}
+
+		uint8_t& colCount = m_Validation.ColDigitCount[x * stride + digit];
+		const bool colHadDuplicate = colCount > 1;
+		colCount += delta;
+		if (colHadDuplicate != (colCount > 1))
+		{
+			m_Validation.ColDuplicates[x] += delta;
+			m_Validation.DuplicateCount += delta;
+		}
+	}
+
+	void GridModel::UpdateConstraintViolation(size_t constraintIndex)
+	{
+		ConstraintData& constraint = m_Constraints[constraintIndex];
+		const bool violated = !constraint.IsSatisfied(*this);
+		if (violated == constraint.Violated)
+		{
+			return;
+		}
+
+		constraint.Violated = violated;
+		const int delta = violated ? 1 : -1;
+
+		m_Validation.CellViolations[constraint.Y1 * m_GridSize + constraint.X1] += delta;
+		m_Validation.CellViolations[constraint.Y2 * m_GridSize + constraint.X2] += delta;
+		m_Validation.ViolationCount += delta;
+
+		if (constraint.IsRowConstraint())
+		{
+			m_Validation.RowViolations[constraint.Y1] += delta;
+		}
+
+		if (constraint.IsColConstraint())
+		{
+			m_Validation.ColViolations[constraint.X1] += delta;
+		}
+
+		// Both ends need their marks refreshed, diagonal constraints included.
+		m_Validation.DirtyRows |= (1u << constraint.Y1) | (1u << constraint.Y2);
+		m_Validation.DirtyCols |= (1u << constraint.X1) | (1u << constraint.X2);
+	}
+
+	void GridModel::RequestValidationRebuild()
+	{
+		m_Validation.NeedsRebuild = true;
+		m_Candidates.NeedsRebuild = true;
+		m_UniquenessDirty = true;
+	}
+
+	void GridModel::RebuildValidationState()
+	{
+		const size_t stride = m_GridSize + 1;
+		const size_t cellCount = (size_t)m_GridSize * m_GridSize;
+
+		m_Validation.RowDigitCount.assign(m_GridSize * stride, 0);
+		m_Validation.ColDigitCount.assign(m_GridSize * stride, 0);
+		m_Validation.RowDuplicates.assign(m_GridSize, 0);
+		m_Validation.ColDuplicates.assign(m_GridSize, 0);
+		m_Validation.RowViolations.assign(m_GridSize, 0);
+		m_Validation.ColViolations.assign(m_GridSize, 0);
+		m_Validation.CellViolations.assign(cellCount, 0);
+
+		m_Validation.CellConstraints.resize(cellCount);
+		for (auto& cellConstraints : m_Validation.CellConstraints)
+		{
+			cellConstraints.clear();
+		}
+
+		m_Validation.DuplicateCount = 0;
+		m_Validation.ViolationCount = 0;
+		m_Validation.CurrentSum = 0;
+		m_Validation.NeedsRebuild = false;
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const uint8_t number = m_Board.GetNumber(x, y);
+				UpdateDigitCount(x, y, number, 1);
+				m_Validation.CurrentSum += number;
+			}
+		}
+
+		for (size_t i = 0; i < m_Constraints.size(); ++i)
+		{
+			ConstraintData& constraint = m_Constraints[i];
+			constraint.Violated = false;
+
+			m_Validation.CellConstraints[constraint.Y1 * m_GridSize + constraint.X1].push_back((uint16_t)i);
+			m_Validation.CellConstraints[constraint.Y2 * m_GridSize + constraint.X2].push_back((uint16_t)i);
+
+			UpdateConstraintViolation(i);
+		}
+
+		m_Validation.DirtyRows = 0;
+		m_Validation.DirtyCols = 0;
+	}
+
+	void GridModel::RefreshDirtyErrors()
+	{
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			if (m_Validation.DirtyRows & (1u << y))
+			{
+				MarkErrorRow(y, m_Validation.RowDuplicates[y] || m_Validation.RowViolations[y]);
+				for (uint8_t x = 0; x < m_GridSize; ++x)
+				{
+					RefreshCellError(x, y);
+				}
+			}
+		}
+
+		for (uint8_t x = 0; x < m_GridSize; ++x)
+		{
+			if (m_Validation.DirtyCols & (1u << x))
+			{
+				MarkErrorColumn(x, m_Validation.ColDuplicates[x] || m_Validation.ColViolations[x]);
+				for (uint8_t y = 0; y < m_GridSize; ++y)
+				{
+					RefreshCellError(x, y);
+				}
+			}
+		}
+
+		m_Validation.DirtyRows = 0;
+		m_Validation.DirtyCols = 0;
+	}
+
+	void GridModel::RefreshCellError(uint8_t x, uint8_t y)
+	{
+		const size_t stride = m_GridSize + 1;
+		const uint8_t number = m_Board.GetNumber(x, y);
+
+		bool hasError = m_Validation.CellViolations[y * m_GridSize + x] > 0;
+		if (number)
+		{
+			hasError |= m_Validation.RowDigitCount[y * stride + number] > 1;
+			hasError |= m_Validation.ColDigitCount[x * stride + number] > 1;
+		}
+
+		MarkErrorCell(x, y, hasError);
+	}
+
+	bool GridModel::IsValidationDirty() const
+	{
+		return m_Validation.NeedsRebuild || m_Validation.DirtyRows || m_Validation.DirtyCols;
+	}
+
+	void GridModel::RebuildCandidates()
+	{
+		const size_t cellCount = (size_t)m_GridSize * m_GridSize;
+
+		m_Candidates.RowDigits.assign(m_GridSize, 0);
+		m_Candidates.ColDigits.assign(m_GridSize, 0);
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const uint16_t bit = DigitBit(m_Board.GetNumber(x, y));
+				m_Candidates.RowDigits[y] |= bit;
+				m_Candidates.ColDigits[x] |= bit;
+			}
+		}
+
+		// Links are grouped by cell with a counting pass, so that every cell's links are contiguous.
+		m_Candidates.LinkOffsets.assign(cellCount + 1, 0);
+		for (const auto& constraint : m_Constraints)
+		{
+			m_Candidates.LinkOffsets[constraint.Y1 * m_GridSize + constraint.X1 + 1]++;
+			m_Candidates.LinkOffsets[constraint.Y2 * m_GridSize + constraint.X2 + 1]++;
+		}
+
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			m_Candidates.LinkOffsets[cell + 1] += m_Candidates.LinkOffsets[cell];
+		}
+
+		m_Candidates.Links.resize(2 * m_Constraints.size());
+		std::vector<uint32_t> nextLink(m_Candidates.LinkOffsets.begin(), m_Candidates.LinkOffsets.end() - 1);
+		for (const auto& constraint : m_Constraints)
+		{
+			const size_t greater = constraint.Y1 * m_GridSize + constraint.X1;
+			const size_t lesser = constraint.Y2 * m_GridSize + constraint.X2;
+			m_Candidates.Links[nextLink[greater]++] = (uint16_t)(lesser | CandidateState::LINK_GREATER);
+			m_Candidates.Links[nextLink[lesser]++] = (uint16_t)greater;
+		}
+
+		m_Candidates.Candidates.resize(cellCount);
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			RefreshCandidates(cell);
+		}
+
+		m_Candidates.NeedsRebuild = false;
+	}
+
+	void GridModel::UpdateCandidatesAround(uint8_t x, uint8_t y)
+	{
+		uint16_t rowDigits = 0;
+		uint16_t colDigits = 0;
+		for (uint8_t i = 0; i < m_GridSize; ++i)
+		{
+			rowDigits |= DigitBit(m_Board.GetNumber(i, y));
+			colDigits |= DigitBit(m_Board.GetNumber(x, i));
+		}
+		m_Candidates.RowDigits[y] = rowDigits;
+		m_Candidates.ColDigits[x] = colDigits;
+
+		// The row and column lose or regain the digit, and their constraint neighbours are bounded by them.
+		for (uint8_t i = 0; i < m_GridSize; ++i)
+		{
+			for (const size_t cell : { (size_t)y * m_GridSize + i, (size_t)i * m_GridSize + x })
+			{
+				RefreshCandidates(cell);
+				for (uint32_t link = m_Candidates.LinkOffsets[cell]; link < m_Candidates.LinkOffsets[cell + 1]; ++link)
+				{
+					RefreshCandidates(m_Candidates.Links[link] & ~CandidateState::LINK_GREATER);
+				}
+			}
+		}
+	}
+
+	void GridModel::RefreshCandidates(size_t cell)
+	{
+		if (m_Board.Numbers[cell])
+		{
+			m_Candidates.Candidates[cell] = 0;
+			return;
+		}
+
+		uint16_t candidates = GetLatinCandidates(cell);
+		for (uint32_t link = m_Candidates.LinkOffsets[cell]; link < m_Candidates.LinkOffsets[cell + 1]; ++link)
+		{
+			const uint16_t neighbourLink = m_Candidates.Links[link];
+			const size_t neighbour = neighbourLink & ~CandidateState::LINK_GREATER;
+			const uint16_t bound = m_Board.Numbers[neighbour] ? DigitBit(m_Board.Numbers[neighbour]) : GetLatinCandidates(neighbour);
+			if (!bound)
+			{
+				continue;
+			}
+
+			// Greater than the neighbour's smallest candidate, or less than its largest.
+			if (neighbourLink & CandidateState::LINK_GREATER)
+			{
+				candidates &= Solver::GreaterBound(bound);
+			}
+			else
+			{
+				candidates &= Solver::LesserBound(bound);
+			}
+		}
+
+		m_Candidates.Candidates[cell] = candidates;
+	}
+
+	uint16_t GridModel::GetLatinCandidates(size_t cell) const
+	{
+		const size_t x = cell % m_GridSize;
+		const size_t y = cell / m_GridSize;
+		return (uint16_t)(Solver::FullMask(m_GridSize) & ~(m_Candidates.RowDigits[y] | m_Candidates.ColDigits[x]));
+	}
+
+	void GridModel::UpdateSolverConstraints()
+	{
+		m_SolverConstraints.clear();
+		for (const auto& constraint : m_Constraints)
+		{
+			m_SolverConstraints.push_back({ constraint.X1, constraint.Y1, constraint.X2, constraint.Y2 });
+		}
+	}
+
+	void GridModel::UpdateUniquenessCheck(float timeBudgetMs)
+	{
+		if (m_UniquenessDirty)
+		{
+			m_UniquenessDirty = false;
+			UpdateSolverConstraints();
+
+			m_UniquenessSolver.Load(m_Board, m_SolverConstraints);
+			m_UniquenessSolver.BeginSearch(2);
+		}
+
+		if (!m_UniquenessSolver.IsSearchFinished())
+		{
+			m_UniquenessSolver.ContinueSearch(timeBudgetMs);
+		}
+	}
+
+	Solver::Uniqueness GridModel::CheckUniqueness()
+	{
+		UpdateUniquenessCheck(0.0f);
+		return m_UniquenessSolver.GetUniqueness();
+	}
+
+	Solver::Uniqueness GridModel::GetUniqueness() const
+	{
+		return m_UniquenessSolver.GetUniqueness();
+	}
+
+	const Solver::Hint& GridModel::FindHint()
+	{
+		UpdateSolverConstraints();
+		return m_HintEngine.FindHint(m_Board, m_SolverConstraints);
+	}
+
+	bool GridModel::Undo()
+	{
+		if (!m_Journal.Undo(m_JournalStep))
+		{
+			return false;
+		}
+
+		for (const JournalEntry& entry : m_JournalStep)
+		{
+			ApplyJournalEntry(entry, true);
+		}
+
+		m_PlayerWon = false;
+		return true;
+	}
+
+	bool GridModel::Redo()
+	{
+		if (!m_Journal.Redo(m_JournalStep))
+		{
+			return false;
+		}
+
+		for (const JournalEntry& entry : m_JournalStep)
+		{
+			ApplyJournalEntry(entry, false);
+		}
+
+		m_PlayerWon = false;
+		return true;
+	}
+
+	const MoveJournal& GridModel::GetJournal() const
+	{
+		return m_Journal;
+	}
+
+	bool GridModel::LoadJournal(const uint8_t* data, size_t size)
+	{
+		return m_Journal.Decode(data, size, m_GridSize);
+	}
+
+	bool GridModel::RestoreProgress(const Serialization::SaveGameData& saveGame)
+	{
+		const size_t cellCount = m_Board.GetCellCount();
+		if (saveGame.GridSize != m_GridSize || saveGame.Numbers.size() != cellCount || saveGame.Guesses.size() != cellCount)
+		{
+			return false;
+		}
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const size_t cell = m_Board.GetIndex(x, y);
+				if (!m_Board.IsLocked(x, y))
+				{
+					m_Board.Numbers[cell] = saveGame.Numbers[cell];
+					m_Board.Guesses[cell] = saveGame.Guesses[cell];
+				}
+			}
+		}
+
+		m_Journal.Clear();
+		if (!saveGame.Journal.empty())
+		{
+			m_Journal.Decode(saveGame.Journal.data(), saveGame.Journal.size(), m_GridSize, true);
+		}
+
+		m_PlayerWon = false;
+		RequestValidationRebuild();
+		return true;
+	}
+
+	void GridModel::RecordCellChange(size_t cell, uint8_t oldNumber, uint16_t oldGuesses, bool oldLocked)
+	{
+		const bool newLocked = m_Board.IsLocked((uint8_t)(cell % m_GridSize), (uint8_t)(cell / m_GridSize));
+		if (oldNumber == m_Board.Numbers[cell] && oldGuesses == m_Board.Guesses[cell] && oldLocked == newLocked)
+		{
+			return;
+		}
+
+		JournalEntry entry;
+		entry.Cell = (uint16_t)cell;
+		entry.OldGuesses = oldGuesses;
+		entry.NewGuesses = m_Board.Guesses[cell];
+		entry.OldNumber = oldNumber;
+		entry.NewNumber = m_Board.Numbers[cell];
+		entry.Flags = (oldLocked ? JournalEntry::OLD_LOCKED : 0) | (newLocked ? JournalEntry::NEW_LOCKED : 0);
+		m_Journal.Record(entry);
+	}
+
+	void GridModel::RecordConstraintChange(JournalEntryKind kind, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2)
+	{
+		JournalEntry entry;
+		entry.Kind = kind;
+		entry.Cell = (uint16_t)m_Board.GetIndex(x1, y1);
+		entry.OtherCell = (uint16_t)m_Board.GetIndex(x2, y2);
+		m_Journal.Record(entry);
+	}
+
+	void GridModel::ApplyJournalEntry(const JournalEntry& entry, bool undo)
+	{
+		const uint8_t x1 = entry.Cell % m_GridSize;
+		const uint8_t y1 = entry.Cell / m_GridSize;
+		const uint8_t x2 = entry.OtherCell % m_GridSize;
+		const uint8_t y2 = entry.OtherCell / m_GridSize;
+
+		switch (entry.Kind)
+		{
+		case JournalEntryKind::CELL:
+		{
+			// Givens decide the solution, so the uniqueness result is stale once one changes value or lock.
+			const bool locked = entry.Flags & (undo ? JournalEntry::OLD_LOCKED : JournalEntry::NEW_LOCKED);
+			if (entry.Flags & (JournalEntry::OLD_LOCKED | JournalEntry::NEW_LOCKED))
+			{
+				m_UniquenessDirty = true;
+			}
+			m_Board.SetLocked(x1, y1, locked);
+
+			m_Board.Guesses[entry.Cell] = undo ? entry.OldGuesses : entry.NewGuesses;
+			SetCellNumber(x1, y1, undo ? entry.OldNumber : entry.NewNumber);
+			break;
+		}
+		case JournalEntryKind::CONSTRAINT_ADD:
+		case JournalEntryKind::CONSTRAINT_REMOVE:
+			if ((entry.Kind == JournalEntryKind::CONSTRAINT_ADD) != undo)
+			{
+				AddGreaterThanConstraint(x1, y1, x2, y2);
+			}
+			else
+			{
+				RemoveGreaterThanConstraint(x1, y1, x2, y2);
+			}
+			break;
+		case JournalEntryKind::CONSTRAINT_FLIP:
+		{
+			bool isFlipped = false;
+			const int index = GetConstraintIndex(x1, y1, x2, y2, isFlipped);
+			if (index != -1)
+			{
+				FlipGreaterThanConstraint(index);
+			}
+			break;
+		}
+		}
+	}
+
+	const GridState& GridModel::GetGridState() const
+	{
+		return m_State;
+	}
+
+	void GridModel::SetAltMode(bool altMode)
+	{
+		m_State.AltMode = altMode;
+	}
+
+	void GridModel::SetHighDigits(bool highDigits)
+	{
+		m_State.HighDigits = highDigits;
+	}
+
+	void GridModel::SetAutoCandidates(bool autoCandidates)
+	{
+		if (autoCandidates && !m_State.AutoCandidates)
+		{
+			m_Candidates.NeedsRebuild = true;
+		}
+		m_State.AutoCandidates = autoCandidates;
+	}
+
+	void GridModel::SetEditMode(bool editMode)
+	{
+		// Play and editor moves are not undone from the other mode.
+		if (editMode != m_State.EditMode)
+		{
+			m_Journal.Clear();
+		}
+
+		m_State.EditMode = editMode;
+		if (m_State.EditMode)
+		{
+			m_PlayerWon = false;
+			ClearAllErrors();
+		}
+		else
+		{
+			RequestValidationRebuild();
+		}
+	}
+
+	bool GridModel::HasValidData() const
+	{
+		return m_GridSize > 0;
+	}
+
+	bool GridModel::HasErrors() const
+	{
+		uint16_t cellErrors = 0;
+		for (const uint16_t rowCellErrors : m_CellErrors)
+		{
+			cellErrors |= rowCellErrors;
+		}
+		return m_RowErrors || m_ColErrors || cellErrors;
+	}
+
+	bool GridModel::ConstraintData::IsSatisfied(const GridModel& grid) const
+	{
+		const uint8_t number1 = grid.m_Board.GetNumber(X1, Y1);
+		const uint8_t number2 = grid.m_Board.GetNumber(X2, Y2);
+
+		if (number1 == 0 || number2 == 0)
+		{
+			return true;
+		}
+
+		return number1 > number2;
+	}
+
+	bool GridModel::ConstraintData::IsRowConstraint() const
+	{
+		return Y1 == Y2;
+	}
+
+	bool GridModel::ConstraintData::IsColConstraint() const
+	{
+		return X1 == X2;
+	}
+	bool GridModel::ConstraintData::FaceLeft() const
+	{
+		return X1 > X2;
+	}
+
+	bool GridModel::ConstraintData::FaceUp() const
+	{
+		return Y1 > Y2;
+	}
+
+	bool GridModel::ConstraintData::IsViolated(uint8_t gridSize) const
+	{
+		return ((X1 < 0 || X1 >= gridSize)
+			|| (X2 < 0 || X2 >= gridSize)
+			|| (Y1 < 0 || Y1 >= gridSize)
+			|| (Y2 < 0 || Y2 >= gridSize));
+	}
+}
\ No newline at end of file
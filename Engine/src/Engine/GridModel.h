@@ -0,0 +1,243 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <array>
+
+#include "Serialization/LevelData.h"
+#include "Serialization/BoardData.h"
+#include "Serialization/SaveGame.h"
+#include "Solver/Solver.h"
+#include "Solver/HintEngine.h"
+#include "MoveJournal.h"
+
+namespace Engine
+{
+	struct GridState
+	{
+		bool AltMode = false;
+		bool EditMode = false;
+		bool HighDigits = false; // Number keys enter 10-16
+		bool AutoCandidates = false; // Guesses show the candidates left by the numbers on the board
+	};
+
+	enum class GridEditResult : uint8_t
+	{
+		OK,
+		CELL_OUT_OF_GRID,
+		CONSTRAINT_SAME_CELL,
+		CONSTRAINT_OUT_OF_GRID,
+		CONSTRAINT_NOT_ADJACENT,
+		GRID_SIZE_NOT_SUPPORTED,
+	};
+
+	// Board state, moves and validation of a Futoshiki grid. Does not depend on raylib or the
+	// Application, so it can be used by tools and benchmarks without a window.
+	class GridModel
+	{
+	public:
+		// One cell gathered from the board's arrays, for drawing.
+		struct CellData
+		{
+			uint16_t Guesses = 0; // Digit n is bit (n - 1)
+			uint8_t Number{ 0 };
+			bool Locked = false;
+		};
+
+		struct ConstraintData
+		{
+			uint8_t X1, Y1;
+			uint8_t X2, Y2;
+			bool Violated = false;
+
+			bool IsSatisfied(const GridModel& grid) const;
+			bool IsRowConstraint() const;
+			bool IsColConstraint() const;
+			bool FaceLeft() const;
+			bool FaceUp() const;
+			bool IsViolated(uint8_t gridSize) const;
+		};
+
+	private:
+		// Bookkeeping for incremental validation. Digit counts are stored with a stride of
+		// (GridSize + 1) so that a digit can be used directly as an offset into its row/column.
+		struct ValidationState
+		{
+			std::vector<uint8_t> RowDigitCount;
+			std::vector<uint8_t> ColDigitCount;
+			std::vector<uint8_t> RowDuplicates;
+			std::vector<uint8_t> ColDuplicates;
+			std::vector<uint8_t> RowViolations;
+			std::vector<uint8_t> ColViolations;
+			std::vector<uint8_t> CellViolations;
+			std::vector<std::vector<uint16_t>> CellConstraints;
+
+			size_t DuplicateCount = 0;
+			size_t ViolationCount = 0;
+			size_t CurrentSum = 0;
+
+			uint32_t DirtyRows = 0;
+			uint32_t DirtyCols = 0;
+			bool NeedsRebuild = true;
+		};
+
+		// Candidates of the auto-candidate mode: digits missing from the cell's row and column, bounded
+		// by the greater-than signs around it. A number change refreshes only its row and column and
+		// their constraint neighbours; constraint and board changes rebuild everything.
+		struct CandidateState
+		{
+			static const uint16_t LINK_GREATER = 0x8000; // Set on a link when the cell is the greater one
+
+			std::vector<uint16_t> RowDigits;   // Digits entered in each row
+			std::vector<uint16_t> ColDigits;   // Digits entered in each column
+			std::vector<uint16_t> Candidates;  // Per cell, 0 for filled cells
+			std::vector<uint32_t> LinkOffsets; // Links of cell i are Links[LinkOffsets[i], LinkOffsets[i + 1])
+			std::vector<uint16_t> Links;       // Neighbour cell across a constraint, plus LINK_GREATER
+
+			bool NeedsRebuild = true;
+		};
+
+	public:
+		static const uint8_t DEFAULT_GRID_SIZE = 4;
+		static const uint8_t MAX_GRID_SIZE = Solver::BoardSolver::MAX_GRID_SIZE;
+		static constexpr float UNIQUENESS_CHECK_BUDGET_MS = 1.0f;
+
+		GridModel();
+
+		// Returns true on the update in which the player wins.
+		bool Update();
+		void Reset();
+		void NewBoard(bool useDefaultSize = false);
+
+		void OnHandleNumber(uint8_t number);
+		void OnChangeSelection(int x, int y);
+
+		const GridState& GetGridState()const;
+		void SetAltMode(bool altMode);
+		void SetEditMode(bool editMode);
+		void SetHighDigits(bool highDigits);
+		void SetAutoCandidates(bool autoCandidates);
+
+		// Will result in loss of data when changing the grid size to a lower one.
+		void ChangeGridSize(uint8_t gridSize, bool retainData = true);
+
+		GridEditResult LockCell(uint8_t x, uint8_t y, uint8_t number);
+		void UnlockCell(uint8_t x, uint8_t y);
+
+		GridEditResult AddGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+		void RemoveGreaterThanConstraint(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+
+		static Serialization::LevelData GetSaveData(const GridModel& grid);
+
+		// Entries that could not be applied are reported through outRejected when given.
+		void LoadFromData(const Serialization::LevelData& levelData, std::vector<GridEditResult>* outRejected = nullptr);
+
+		bool PlayerWon() const;
+		bool HasValidData() const;
+		bool HasErrors() const;
+
+		// Finishes any pending uniqueness check of the edited level and returns its result.
+		Solver::Uniqueness CheckUniqueness();
+		Solver::Uniqueness GetUniqueness() const;
+
+		// Cheapest human-style step from the numbers on the board.
+		const Solver::Hint& FindHint();
+
+		// Number, guess, lock, constraint and reset steps taken through the input handlers.
+		// Loading a level or changing the grid size clears the history.
+		bool Undo();
+		bool Redo();
+		const MoveJournal& GetJournal() const;
+		bool LoadJournal(const uint8_t* data, size_t size);
+
+		// Puts saved numbers and guesses back on the unlocked cells of the loaded level, with the undo
+		// history when it was saved. Fails when the save is for a different grid size.
+		bool RestoreProgress(const Serialization::SaveGameData& saveGame);
+
+		uint8_t GetGridSize() const;
+		int GetSelectedCol() const;
+		int GetSelectedRow() const;
+
+		// Guesses are the auto candidates while that mode is on.
+		CellData GetCellData(uint8_t x, uint8_t y)const;
+		uint16_t GetAutoCandidates(uint8_t x, uint8_t y) const;
+		const Serialization::BoardData& GetBoard() const;
+		const std::vector<ConstraintData>& GetConstraints() const;
+		const bool IsCellLocked(uint8_t x, uint8_t y)const;
+		const bool IsCellValid(uint8_t x, uint8_t y)const;
+
+		bool CheckCellHasError(uint8_t x, uint8_t y) const;
+		bool CheckColHasError(uint8_t col) const;
+		bool CheckRowHasError(uint8_t row) const;
+
+	protected:
+		void ToggleGuess(uint8_t guess);
+		void ToggleNumber(uint8_t number);
+		void ToggleLock(uint8_t number);
+		void ToggleConstraint(int x, int y);
+
+		void FlipGreaterThanConstraint(int index);
+		int GetConstraintIndex(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, bool& isFlipped) const;
+
+		void MarkErrorColumn(uint8_t col, bool hasError = true);
+		void MarkErrorRow(uint8_t row, bool hasError = true);
+		void MarkErrorCell(uint8_t x, uint8_t y, bool hasError = true);
+
+		void ClearAllErrors();
+		void CheckConstraints();
+
+		// Incremental validation
+		void SetCellNumber(uint8_t x, uint8_t y, uint8_t number);
+		void UpdateDigitCount(uint8_t x, uint8_t y, uint8_t digit, int delta);
+		void UpdateConstraintViolation(size_t constraintIndex);
+		void RequestValidationRebuild();
+		void RebuildValidationState();
+		void RefreshDirtyErrors();
+		void RefreshCellError(uint8_t x, uint8_t y);
+		bool IsValidationDirty() const;
+
+		// Auto candidates
+		void RebuildCandidates();
+		void UpdateCandidatesAround(uint8_t x, uint8_t y);
+		void RefreshCandidates(size_t cell);
+		uint16_t GetLatinCandidates(size_t cell) const;
+
+		// Undo history
+		void RecordCellChange(size_t cell, uint8_t oldNumber, uint16_t oldGuesses, bool oldLocked);
+		void RecordConstraintChange(JournalEntryKind kind, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+		void ApplyJournalEntry(const JournalEntry& entry, bool undo);
+
+		void UpdateSolverConstraints();
+		void UpdateUniquenessCheck(float timeBudgetMs);
+
+	private:
+		GridState m_State;
+		uint8_t m_GridSize;
+
+		int m_SelectedRow, m_SelectedCol;
+
+		Serialization::BoardData m_Board;
+		std::vector<ConstraintData> m_Constraints;
+		std::vector<Serialization::GreaterThanConstraint> m_SolverConstraints;
+
+		// One bit per row, column, and cell of each row.
+		uint16_t m_RowErrors = 0;
+		uint16_t m_ColErrors = 0;
+		std::array<uint16_t, MAX_GRID_SIZE> m_CellErrors{};
+		ValidationState m_Validation;
+		CandidateState m_Candidates;
+
+		size_t m_TargetSum;
+		bool m_PlayerWon;
+
+		Solver::BoardSolver m_UniquenessSolver;
+		bool m_UniquenessDirty = true;
+
+		Solver::HintEngine m_HintEngine;
+
+		MoveJournal m_Journal;
+		std::vector<JournalEntry> m_JournalStep;
+	};
+
+	static_assert(GridModel::MAX_GRID_SIZE <= 16, "Guesses and error rows are 16-bit masks");
+}
@@ -0,0 +1,459 @@
+#include "Application.h"
+
+#include <algorithm>
+#include <numeric>
+#include <fmt/core.h>
+
+#include "GridModel.h"
+#include "Serialization/Parser.h"
+#include "Serialization/LevelConverter.h"
+#include "Solver/Solver.h"
+#include "Solver/BatchGenerator.h"
+#include "Solver/DifficultyRater.h"
+#include "Benchmarks/Benchmarks.h"
+
+namespace Engine
+{
+	static const char* HEADLESS_USAGE =
+		"Usage: Engine --headless <command> [args]\n"
+		"  validate [directory]                                   Check every level for errors and a unique solution\n"
+		"  solve <level.data>                                     Print the solution of a level\n"
+		"  generate <count> <size> [seed] [easy|medium|hard] [threads] [directory]\n"
+		"                                                         Generate levels into a directory (default ./generated/)\n"
+		"  rate [directory] [threads]                             Rate the difficulty of every level and list them easiest first\n"
+		"  convert <input> <output>                               Convert between .data and .lvl levels, or a directory and a .pack\n"
+		"  replay <recording> [directory]                         Play back a recorded session and print the final board\n"
+		"  benchmark [all|duplicates|solver|uniqueness|generator|batch|formats|parser|prefetch|sizes|layout|latin|verify|hints|rating|candidates|journal|savegame] [directory]\n"
+		"  benchmark replay <recording> [directory]\n";
+
+	static const std::string DEFAULT_DATA_DIRECTORY = "./data/";
+	static const std::string DEFAULT_GENERATE_DIRECTORY = "./generated/";
+
+	static std::string GetArg(const std::vector<std::string>& args, size_t index, const std::string& defaultValue)
+	{
+		return index < args.size() ? args[index] : defaultValue;
+	}
+
+	static bool ParseNumberArg(const std::vector<std::string>& args, size_t index, uint64_t defaultValue, uint64_t& outValue)
+	{
+		if (index >= args.size())
+		{
+			outValue = defaultValue;
+			return true;
+		}
+
+		try
+		{
+			outValue = std::stoull(args[index]);
+			return true;
+		}
+		catch (const std::exception&)
+		{
+			fmt::print("Expected a number, got '{}'\n", args[index]);
+			return false;
+		}
+	}
+
+	static std::string WithTrailingSlash(std::string directoryPath)
+	{
+		if (!directoryPath.empty() && directoryPath.back() != '/' && directoryPath.back() != '\\')
+		{
+			directoryPath += '/';
+		}
+		return directoryPath;
+	}
+
+	int Application::RunHeadless(const std::vector<std::string>& args)
+	{
+		SetTraceLogLevel(LOG_WARNING);
+		m_Notifications.SetEchoToLog(true);
+
+		const std::string command = GetArg(args, 0, "");
+		const std::vector<std::string> commandArgs(args.begin() + (args.empty() ? 0 : 1), args.end());
+
+		if (command == "validate")
+		{
+			return HeadlessValidate(commandArgs);
+		}
+		else if (command == "solve")
+		{
+			return HeadlessSolve(commandArgs);
+		}
+		else if (command == "generate")
+		{
+			return HeadlessGenerate(commandArgs);
+		}
+		else if (command == "rate")
+		{
+			return HeadlessRate(commandArgs);
+		}
+		else if (command == "convert")
+		{
+			return HeadlessConvert(commandArgs);
+		}
+		else if (command == "replay")
+		{
+			return HeadlessReplay(commandArgs);
+		}
+		else if (command == "benchmark")
+		{
+			return HeadlessBenchmark(commandArgs);
+		}
+
+		fmt::print("{}", HEADLESS_USAGE);
+		return command.empty() || command == "help" ? 0 : 1;
+	}
+
+	int Application::HeadlessValidate(const std::vector<std::string>& args)
+	{
+		m_LevelSelection.LoadCatalogue(WithTrailingSlash(GetArg(args, 0, DEFAULT_DATA_DIRECTORY)));
+
+		size_t failedCount = 0;
+		Serialization::LevelData levelData;
+		GridModel grid;
+
+		for (size_t levelIndex = 0; levelIndex < m_LevelSelection.GetLevelCount(); ++levelIndex)
+		{
+			if (!m_LevelSelection.ParseLevel(levelIndex, levelData))
+			{
+				fmt::print("{:<12} could not be read\n", m_LevelSelection.GetLastLoadedLevelName());
+				failedCount++;
+				continue;
+			}
+
+			grid.LoadFromData(levelData);
+
+			// One play-mode update runs the full validation of the givens.
+			grid.SetEditMode(false);
+			grid.Update();
+			const bool hasErrors = grid.HasErrors();
+
+			const Solver::Uniqueness uniqueness = grid.CheckUniqueness();
+			const bool passed = !hasErrors && uniqueness == Solver::Uniqueness::UNIQUE;
+			failedCount += !passed;
+
+			fmt::print("{:<12} {}x{}  {:<20} {}\n",
+				m_LevelSelection.GetLastLoadedLevelName(), levelData.GridSize, levelData.GridSize,
+				Solver::ToString(uniqueness), hasErrors ? "conflicting givens" : (passed ? "ok" : "-"));
+		}
+
+		fmt::print("{} levels, {} failed\n", m_LevelSelection.GetLevelCount(), failedCount);
+		return failedCount ? 1 : 0;
+	}
+
+	int Application::HeadlessSolve(const std::vector<std::string>& args)
+	{
+		if (args.empty())
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		Serialization::LevelData levelData;
+		Serialization::ParseError error;
+		if (!Serialization::Parse(args[0], levelData, &error))
+		{
+			fmt::print("Could not read a level from '{}': {}\n", args[0], Serialization::ToString(error));
+			return 1;
+		}
+
+		Solver::BoardSolver solver;
+		std::vector<uint8_t> solution;
+		if (!solver.Load(levelData) || !solver.Solve(solution))
+		{
+			fmt::print("No solution\n");
+			return 1;
+		}
+
+		for (uint8_t y = 0; y < levelData.GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < levelData.GridSize; ++x)
+			{
+				fmt::print("{:>3}", solution[y * levelData.GridSize + x]);
+			}
+			fmt::print("\n");
+		}
+
+		const Solver::SolverStats& stats = solver.GetStats();
+		fmt::print("nodes {}, propagations {}, backtracks {}\n", stats.Nodes, stats.Propagations, stats.Backtracks);
+		return 0;
+	}
+
+	int Application::HeadlessGenerate(const std::vector<std::string>& args)
+	{
+		uint64_t count = 0, gridSize = 0, seed = 0, threads = 0;
+		if (args.size() < 2
+			|| !ParseNumberArg(args, 0, 0, count)
+			|| !ParseNumberArg(args, 1, 0, gridSize)
+			|| !ParseNumberArg(args, 2, 1, seed)
+			|| !ParseNumberArg(args, 4, 0, threads))
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		if (gridSize == 0 || gridSize > GridModel::MAX_GRID_SIZE)
+		{
+			fmt::print("Grid size must be between 1 and {}\n", (int)GridModel::MAX_GRID_SIZE);
+			return 1;
+		}
+
+		Solver::GeneratorSettings settings;
+		settings.GridSize = (uint8_t)gridSize;
+		settings.Seed = seed;
+
+		const std::string difficulty = GetArg(args, 3, "medium");
+		if (difficulty == "easy")
+		{
+			settings.TargetDifficulty = Solver::Difficulty::EASY;
+		}
+		else if (difficulty == "hard")
+		{
+			settings.TargetDifficulty = Solver::Difficulty::HARD;
+		}
+
+		// Generated levels go next to the shipped ones only when asked for.
+		const std::string directoryPath = WithTrailingSlash(GetArg(args, 5, DEFAULT_GENERATE_DIRECTORY));
+
+		Solver::BatchStats stats;
+		const size_t written = Solver::GenerateLevels(settings, count, directoryPath, threads, &stats);
+
+		fmt::print("Wrote {} {} {}x{} levels to {} in {:.2f}s on {} threads ({:.1f} puzzles/sec)\n",
+			written, Solver::ToString(settings.TargetDifficulty), gridSize, gridSize, directoryPath,
+			stats.Seconds, stats.Threads, stats.Generator.Puzzles / stats.Seconds);
+
+		return written == count ? 0 : 1;
+	}
+
+	int Application::HeadlessRate(const std::vector<std::string>& args)
+	{
+		uint64_t threads = 0;
+		if (!ParseNumberArg(args, 1, 0, threads))
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		m_LevelSelection.LoadCatalogue(WithTrailingSlash(GetArg(args, 0, DEFAULT_DATA_DIRECTORY)));
+		const Solver::RatingBatchStats stats = m_LevelSelection.RateLevels(threads, true);
+
+		// Levels that could not be rated go last.
+		const size_t levelCount = m_LevelSelection.GetLevelCount();
+		std::vector<size_t> order(levelCount);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+			{
+				return (uint16_t)(m_LevelSelection.GetLevelRecord(a).Difficulty - 1) < (uint16_t)(m_LevelSelection.GetLevelRecord(b).Difficulty - 1);
+			});
+
+		for (const size_t levelIndex : order)
+		{
+			const Serialization::CatalogueRecord& record = m_LevelSelection.GetLevelRecord(levelIndex);
+			if (record.Difficulty == 0)
+			{
+				fmt::print("{:<12} {:>2}x{:<2} {:>10}  {}\n", record.Name, record.GridSize, record.GridSize, "-", "not rated");
+				continue;
+			}
+
+			Solver::LevelRating rating;
+			rating.Techniques = record.Techniques;
+			fmt::print("{:<12} {:>2}x{:<2} {:>10}  {}\n", record.Name, record.GridSize, record.GridSize, record.Difficulty,
+				Solver::ToString(rating.GetHardestTechnique()));
+		}
+
+		fmt::print("Rated {} of {} levels in {:.3f}s on {} threads ({:.0f} levels/sec)\n",
+			stats.Rated, levelCount, stats.Seconds, stats.Threads, stats.Rated / std::max(stats.Seconds, 1e-9));
+		return stats.Rated == levelCount ? 0 : 1;
+	}
+
+	int Application::HeadlessConvert(const std::vector<std::string>& args)
+	{
+		if (args.size() < 2)
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		const size_t converted = Serialization::ConvertLevels(args[0], args[1]);
+		if (converted == 0)
+		{
+			fmt::print("Could not convert '{}' to '{}'\n", args[0], args[1]);
+			return 1;
+		}
+
+		fmt::print("Converted {} levels from {} to {}\n", converted, args[0], args[1]);
+		return 0;
+	}
+
+	int Application::HeadlessReplay(const std::vector<std::string>& args)
+	{
+		if (args.empty())
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		InputPlayback playback;
+		std::string error;
+		if (!playback.Open(args[0], &error))
+		{
+			fmt::print("Could not read a recording from '{}': {}\n", args[0], error);
+			return 1;
+		}
+
+		InitSession(WithTrailingSlash(GetArg(args, 1, DEFAULT_DATA_DIRECTORY)));
+		while (UpdateLogic(playback))
+		{
+		}
+
+		const GridModel& model = m_Grid.GetModel();
+		const EventBusStats& busStats = m_EventBus.GetStats();
+		fmt::print("{} frames, {} events\n", playback.GetFrameCount(), playback.GetEventCount());
+		fmt::print("dispatched {}, dropped {}, cascade limit hits {}\n", busStats.Dispatched, busStats.Dropped, busStats.CascadeLimitHits);
+		fmt::print("{} {}x{} {}, {}\n", m_LevelSelection.GetLastLoadedLevelName(), model.GetGridSize(), model.GetGridSize(),
+			model.GetGridState().EditMode ? "editing" : "playing", model.PlayerWon() ? "won" : "not won");
+
+		for (uint8_t y = 0; y < model.GetGridSize(); ++y)
+		{
+			for (uint8_t x = 0; x < model.GetGridSize(); ++x)
+			{
+				fmt::print("{:>3}", model.GetCellData(x, y).Number);
+			}
+			fmt::print("\n");
+		}
+
+		return 0;
+	}
+
+	int Application::HeadlessBenchmark(const std::vector<std::string>& args)
+	{
+		const std::string name = GetArg(args, 0, "all");
+
+		// Takes a recording rather than a level directory as its first argument, and is not part of "all".
+		if (name == "replay")
+		{
+			if (args.size() < 2)
+			{
+				fmt::print("{}", HEADLESS_USAGE);
+				return 1;
+			}
+
+			Benchmarks::RunReplayBenchmark(*this, args[1], WithTrailingSlash(GetArg(args, 2, DEFAULT_DATA_DIRECTORY)));
+			return 0;
+		}
+
+		const std::string directoryPath = WithTrailingSlash(GetArg(args, 1, DEFAULT_DATA_DIRECTORY));
+		const bool runAll = name == "all";
+		bool ranAny = false;
+
+		if (runAll || name == "duplicates")
+		{
+			Benchmarks::RunDuplicateCheckBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "solver")
+		{
+			Benchmarks::RunSolverBenchmark(directoryPath);
+			ranAny = true;
+		}
+
+		if (runAll || name == "uniqueness")
+		{
+			Benchmarks::RunUniquenessBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "generator")
+		{
+			Benchmarks::RunGeneratorBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "batch")
+		{
+			Benchmarks::RunBatchGeneratorBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "formats")
+		{
+			Benchmarks::RunLevelFormatBenchmark(directoryPath);
+			ranAny = true;
+		}
+
+		if (runAll || name == "parser")
+		{
+			Benchmarks::RunParserBenchmark(directoryPath);
+			ranAny = true;
+		}
+
+		if (runAll || name == "prefetch")
+		{
+			Benchmarks::RunPrefetchBenchmark(directoryPath);
+			ranAny = true;
+		}
+
+		if (runAll || name == "sizes")
+		{
+			Benchmarks::RunGridSizeBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "layout")
+		{
+			Benchmarks::RunBoardLayoutBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "latin")
+		{
+			Benchmarks::RunLatinCheckBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "verify")
+		{
+			Benchmarks::RunVerifyBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "hints")
+		{
+			Benchmarks::RunHintBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "rating")
+		{
+			Benchmarks::RunRatingBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "candidates")
+		{
+			Benchmarks::RunCandidateBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "journal")
+		{
+			Benchmarks::RunJournalBenchmark();
+			ranAny = true;
+		}
+
+		if (runAll || name == "savegame")
+		{
+			Benchmarks::RunSaveGameBenchmark();
+			ranAny = true;
+		}
+
+		if (!ranAny)
+		{
+			fmt::print("{}", HEADLESS_USAGE);
+			return 1;
+		}
+
+		return 0;
+	}
+}
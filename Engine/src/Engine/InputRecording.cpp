@@ -0,0 +1,167 @@
+#include "InputRecording.h"
+#include <algorithm>
+#include <iterator>
+#include <fmt/core.h>
+
+namespace Engine
+{
+	static const char RECORDING_MAGIC[4] = { 'F', 'U', 'T', 'I' };
+	static const uint32_t RECORDING_VERSION = 1;
+
+	InputRecorder::InputRecorder(InputSource& source)
+		: m_Source(source)
+	{
+	}
+
+	bool InputRecorder::Open(const std::string& path)
+	{
+		Close();
+
+		m_File.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+		if (!m_File.is_open())
+		{
+			return false;
+		}
+
+		m_File.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+		m_File.write((const char*)&RECORDING_VERSION, sizeof(RECORDING_VERSION));
+		m_FrameCount = 0;
+		return m_File.good();
+	}
+
+	void InputRecorder::Close()
+	{
+		if (m_File.is_open())
+		{
+			m_File.close();
+		}
+	}
+
+	bool InputRecorder::IsOpen() const
+	{
+		return m_File.is_open();
+	}
+
+	bool InputRecorder::GenerateEvents(std::vector<Event>& events)
+	{
+		const size_t firstEvent = events.size();
+		const bool hasInput = m_Source.GenerateEvents(events);
+
+		if (m_File.is_open() && hasInput)
+		{
+			m_FrameEvents.clear();
+			for (size_t i = firstEvent; i < events.size(); ++i)
+			{
+				m_FrameEvents.push_back(RecordedEvent{ (uint8_t)events[i].type, { 0, 0, 0 }, { events[i].data[0], events[i].data[1] } });
+			}
+
+			const uint32_t eventCount = (uint32_t)m_FrameEvents.size();
+			m_File.write((const char*)&eventCount, sizeof(eventCount));
+			m_File.write((const char*)m_FrameEvents.data(), m_FrameEvents.size() * sizeof(RecordedEvent));
+			m_FrameCount++;
+		}
+
+		return hasInput;
+	}
+
+	size_t InputRecorder::GetFrameCount() const
+	{
+		return m_FrameCount;
+	}
+
+	bool InputPlayback::Open(const std::string& path, std::string* outError)
+	{
+		const auto fail = [&](const std::string& message)
+		{
+			if (outError)
+			{
+				*outError = message;
+			}
+			m_Events.clear();
+			m_FrameEnds.clear();
+			m_CurrentFrame = 0;
+			return false;
+		};
+
+		std::ifstream file(path, std::ifstream::binary);
+		if (!file.is_open())
+		{
+			return fail("could not open file");
+		}
+
+		char magic[4];
+		uint32_t version = 0;
+		file.read(magic, sizeof(magic));
+		file.read((char*)&version, sizeof(version));
+		if (!file.good() || !std::equal(std::begin(magic), std::end(magic), RECORDING_MAGIC))
+		{
+			return fail("not an input recording");
+		}
+
+		if (version != RECORDING_VERSION)
+		{
+			return fail(fmt::format("unsupported version {}", version));
+		}
+
+		m_Events.clear();
+		m_FrameEnds.clear();
+		m_CurrentFrame = 0;
+
+		std::vector<RecordedEvent> frameEvents;
+		uint32_t eventCount = 0;
+		while (file.read((char*)&eventCount, sizeof(eventCount)))
+		{
+			frameEvents.resize(eventCount);
+			if (!file.read((char*)frameEvents.data(), eventCount * sizeof(RecordedEvent)))
+			{
+				return fail(fmt::format("frame {} is truncated", m_FrameEnds.size()));
+			}
+
+			for (const RecordedEvent& recordedEvent : frameEvents)
+			{
+				if (recordedEvent.Type >= (uint8_t)EventType::COUNT)
+				{
+					return fail(fmt::format("frame {} has an unknown event type {}", m_FrameEnds.size(), recordedEvent.Type));
+				}
+
+				m_Events.push_back(Event{ (EventType)recordedEvent.Type, { recordedEvent.Data[0], recordedEvent.Data[1] } });
+			}
+			m_FrameEnds.push_back(m_Events.size());
+		}
+
+		return true;
+	}
+
+	bool InputPlayback::GenerateEvents(std::vector<Event>& events)
+	{
+		if (m_CurrentFrame >= m_FrameEnds.size())
+		{
+			return false;
+		}
+
+		const size_t firstEvent = m_CurrentFrame > 0 ? m_FrameEnds[m_CurrentFrame - 1] : 0;
+		events.insert(events.end(), m_Events.begin() + firstEvent, m_Events.begin() + m_FrameEnds[m_CurrentFrame]);
+		m_CurrentFrame++;
+		return true;
+	}
+
+	void InputPlayback::Rewind()
+	{
+		m_CurrentFrame = 0;
+	}
+
+	size_t InputPlayback::GetFrameCount() const
+	{
+		return m_FrameEnds.size();
+	}
+
+	size_t InputPlayback::GetEventCount() const
+	{
+		return m_Events.size();
+	}
+
+	size_t InputPlayback::GetCurrentFrame() const
+	{
+		return m_CurrentFrame;
+	}
+}
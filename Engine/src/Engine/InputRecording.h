@@ -0,0 +1,66 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "InputSource.h"
+
+namespace Engine
+{
+	// A recording is a "FUTI" header followed by one block per frame: the number of events,
+	// then the events themselves. Stored in native byte order.
+	struct RecordedEvent
+	{
+		uint8_t Type;
+		uint8_t Reserved[3];
+		int32_t Data[2];
+	};
+
+	static_assert(sizeof(RecordedEvent) == 12, "RecordedEvent is stored on disk");
+
+	// Passes the events of another source through and writes every frame of them to a file.
+	class InputRecorder : public InputSource
+	{
+	public:
+		static constexpr const char* RECORDING_EXTENSION = ".input";
+
+		InputRecorder(InputSource& source);
+
+		bool Open(const std::string& path);
+		void Close();
+		bool IsOpen() const;
+
+		bool GenerateEvents(std::vector<Event>& events) override;
+
+		size_t GetFrameCount() const;
+
+	private:
+		InputSource& m_Source;
+		std::ofstream m_File;
+		std::vector<RecordedEvent> m_FrameEvents;
+		size_t m_FrameCount = 0;
+	};
+
+	// Plays a recording back frame by frame, without a window.
+	class InputPlayback : public InputSource
+	{
+	public:
+		bool Open(const std::string& path, std::string* outError = nullptr);
+
+		bool GenerateEvents(std::vector<Event>& events) override;
+
+		// Starts from the first frame again.
+		void Rewind();
+
+		size_t GetFrameCount() const;
+		size_t GetEventCount() const;
+		size_t GetCurrentFrame() const;
+
+	private:
+		std::vector<Event> m_Events;
+		std::vector<size_t> m_FrameEnds; // One past the last event of each frame
+		size_t m_CurrentFrame = 0;
+	};
+}
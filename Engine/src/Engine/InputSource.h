@@ -0,0 +1,17 @@
+#pragma once
+#include <vector>
+
+#include "Events.h"
+
+namespace Engine
+{
+	// Produces the input events of one frame; the keyboard (ActionMap) or a recorded session.
+	class InputSource
+	{
+	public:
+		virtual ~InputSource() = default;
+
+		// Appends the events of the next frame. Returns false once the source has no frames left.
+		virtual bool GenerateEvents(std::vector<Event>& events) = 0;
+	};
+}
@@ -0,0 +1,182 @@
+#include "LevelPrefetcher.h"
+
+#include "Serialization/Parser.h"
+
+namespace Engine
+{
+	LevelPrefetcher::LevelPrefetcher(size_t capacity)
+		: m_Capacity(capacity > 0 ? capacity : 1)
+	{
+	}
+
+	LevelPrefetcher::~LevelPrefetcher()
+	{
+		Stop();
+	}
+
+	void LevelPrefetcher::Prefetch(const std::vector<std::string>& paths)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Requests.clear();
+			for (const auto& path : paths)
+			{
+				if (m_Lookup.find(path) == m_Lookup.end())
+				{
+					m_Requests.push_back(path);
+				}
+			}
+
+			if (m_Requests.empty())
+			{
+				return;
+			}
+
+			if (!m_Worker.joinable())
+			{
+				m_Stopping = false;
+				m_Worker = std::thread(&LevelPrefetcher::WorkerLoop, this);
+			}
+		}
+
+		m_WakeWorker.notify_one();
+	}
+
+	bool LevelPrefetcher::TryGet(const std::string& path, Serialization::LevelData& outLevelData)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		const auto itr = m_Lookup.find(path);
+		if (itr == m_Lookup.end())
+		{
+			m_Stats.Misses++;
+			return false;
+		}
+
+		m_Entries.splice(m_Entries.begin(), m_Entries, itr->second);
+		outLevelData = itr->second->Level;
+		m_Stats.Hits++;
+		return true;
+	}
+
+	void LevelPrefetcher::Insert(const std::string& path, const Serialization::LevelData& levelData)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		InsertLocked(path, levelData);
+	}
+
+	void LevelPrefetcher::Invalidate(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Generation++;
+
+		const auto itr = m_Lookup.find(path);
+		if (itr != m_Lookup.end())
+		{
+			m_Entries.erase(itr->second);
+			m_Lookup.erase(itr);
+		}
+	}
+
+	void LevelPrefetcher::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Generation++;
+		m_Requests.clear();
+		m_Entries.clear();
+		m_Lookup.clear();
+	}
+
+	void LevelPrefetcher::WaitUntilIdle()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Idle.wait(lock, [this]() { return m_Requests.empty() && !m_Busy; });
+	}
+
+	PrefetchStats LevelPrefetcher::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Stats;
+	}
+
+	void LevelPrefetcher::WorkerLoop()
+	{
+		Serialization::LevelData levelData;
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		while (true)
+		{
+			m_WakeWorker.wait(lock, [this]() { return m_Stopping || !m_Requests.empty(); });
+			if (m_Stopping)
+			{
+				break;
+			}
+
+			const std::string path = std::move(m_Requests.front());
+			m_Requests.pop_front();
+
+			if (m_Lookup.find(path) == m_Lookup.end())
+			{
+				const size_t generation = m_Generation;
+				m_Busy = true;
+				lock.unlock();
+
+				const bool parsed = Serialization::Parse(path, levelData);
+
+				lock.lock();
+				m_Busy = false;
+
+				// Results for files that were invalidated while parsing are dropped.
+				if (parsed && generation == m_Generation)
+				{
+					InsertLocked(path, levelData);
+					m_Stats.Parsed++;
+				}
+			}
+
+			if (m_Requests.empty())
+			{
+				m_Idle.notify_all();
+			}
+		}
+
+		m_Busy = false;
+		m_Idle.notify_all();
+	}
+
+	void LevelPrefetcher::InsertLocked(const std::string& path, const Serialization::LevelData& levelData)
+	{
+		const auto itr = m_Lookup.find(path);
+		if (itr != m_Lookup.end())
+		{
+			itr->second->Level = levelData;
+			m_Entries.splice(m_Entries.begin(), m_Entries, itr->second);
+			return;
+		}
+
+		m_Entries.push_front(CacheEntry{ path, levelData });
+		m_Lookup[path] = m_Entries.begin();
+
+		if (m_Entries.size() > m_Capacity)
+		{
+			m_Lookup.erase(m_Entries.back().Path);
+			m_Entries.pop_back();
+			m_Stats.Evictions++;
+		}
+	}
+
+	void LevelPrefetcher::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+			m_Requests.clear();
+		}
+
+		m_WakeWorker.notify_all();
+		if (m_Worker.joinable())
+		{
+			m_Worker.join();
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Serialization/LevelData.h"
+
+namespace Engine
+{
+	struct PrefetchStats
+	{
+		size_t Hits = 0;
+		size_t Misses = 0;
+		size_t Parsed = 0;
+		size_t Evictions = 0;
+	};
+
+	// Parses level files on a background thread into a bounded LRU cache, so that selecting a
+	// level that was prefetched does not touch the disk on the calling thread.
+	class LevelPrefetcher
+	{
+	public:
+		static const size_t DEFAULT_CAPACITY = 32;
+
+		LevelPrefetcher(size_t capacity = DEFAULT_CAPACITY);
+		~LevelPrefetcher();
+
+		LevelPrefetcher(const LevelPrefetcher&) = delete;
+		LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+		// Replaces the pending requests; paths are parsed in the given order. Starts the thread on first use.
+		void Prefetch(const std::vector<std::string>& paths);
+
+		// Copies a cached level and marks it as most recently used. Returns false on a miss.
+		bool TryGet(const std::string& path, Serialization::LevelData& outLevelData);
+		void Insert(const std::string& path, const Serialization::LevelData& levelData);
+
+		// Drops a cached level, e.g. after the file was written. A parse in flight is discarded.
+		void Invalidate(const std::string& path);
+		void Clear();
+
+		// Blocks until all pending requests are parsed.
+		void WaitUntilIdle();
+
+		PrefetchStats GetStats() const;
+
+	private:
+		void WorkerLoop();
+		void InsertLocked(const std::string& path, const Serialization::LevelData& levelData);
+		void Stop();
+
+	private:
+		struct CacheEntry
+		{
+			std::string Path;
+			Serialization::LevelData Level;
+		};
+
+		const size_t m_Capacity;
+
+		// Front is the most recently used entry.
+		std::list<CacheEntry> m_Entries;
+		std::unordered_map<std::string, std::list<CacheEntry>::iterator> m_Lookup;
+
+		std::deque<std::string> m_Requests;
+		bool m_Busy = false;
+		size_t m_Generation = 0;
+		PrefetchStats m_Stats;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_WakeWorker;
+		std::condition_variable m_Idle;
+		std::thread m_Worker;
+		bool m_Stopping = false;
+	};
+}
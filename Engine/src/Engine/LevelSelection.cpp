@@ -1,6 +1,5 @@
 #include "LevelSelection.h"
 
-#include <sstream>
 #include <filesystem>
 #include <iostream>
 #include <fmt/core.h>
@@ -10,57 +9,54 @@
 #include "Animations/Easings.h"
 #include "Application.h"
 #include "Actions.h"
+#include "Profiler.h"
 
 #include <iostream>
 
 namespace Engine
 {
-	void LevelSelection::LoadLevelNames(const std::string& directoryPath)
+	LevelSelection::~LevelSelection()
 	{
-		namespace fs = std::filesystem;
-
-		const std::string extensionFilter = ".data";
+		StopBackgroundRating();
+	}
 
-		m_LevelNames.clear();
+	void LevelSelection::LoadCatalogue(const std::string& directoryPath)
+	{
+		StopBackgroundRating();
 		m_DirectoryPath = directoryPath;
-
-		int currentLevelIndex = 1;
-		bool shouldRenameRest = false;
-		for (const auto& entry : fs::directory_iterator(directoryPath))
+		m_Prefetcher.Clear();
+		if (!m_Catalogue.Open(directoryPath))
 		{
-			if (entry.path().extension().string() == extensionFilter)
-			{
-				const std::string levelName = fmt::format(LEVEL_NAME_FMT, currentLevelIndex);
-				if (shouldRenameRest || (entry.path().stem().string() != levelName))
-				{
-					fs::rename(entry.path(), fs::path(directoryPath + levelName + extensionFilter));
-					shouldRenameRest = true;
-				}
-
-				m_LevelNames.push_back(levelName);
-				currentLevelIndex++;
-			}
+			TraceLog(LOG_ERROR, "Could not open the level catalogue in %s", directoryPath.c_str());
 		}
 	}
 
 	bool LevelSelection::ParseLevel(size_t levelIndex, Serialization::LevelData& outLevelData)
 	{
-		if (levelIndex >= m_LevelNames.size())
+		if (levelIndex >= m_Catalogue.GetLevelCount())
 		{
 			TraceLog(LOG_ERROR, "Level Index out of bounds");
 			outLevelData = Serialization::LevelData();
 			return false;
 		}
 
-		m_LoadedLevelName = m_LevelNames[levelIndex];
-		outLevelData = Serialization::Parse(m_DirectoryPath + m_LevelNames[levelIndex] + ".data");
-		if (outLevelData.GridSize == 0)
+		m_LoadedLevelName = m_Catalogue.GetLevelName(levelIndex);
+
+		const std::string levelPath = m_Catalogue.GetLevelPath(levelIndex);
+		if (m_Prefetcher.TryGet(levelPath, outLevelData))
 		{
-			Application::Get().GetNotifications().AddNotification(LOG_ERROR, "Error: Level Data has invalid grid size.");
-			outLevelData = Serialization::LevelData();
+			return true;
+		}
+
+		Serialization::ParseError error;
+		if (!m_Catalogue.LoadLevel(levelIndex, outLevelData, &error))
+		{
+			Application::Get().GetNotifications().AddNotification(LOG_ERROR,
+				fmt::format("Error: {} {}", m_LoadedLevelName, Serialization::ToString(error)));
 			return false;
 		}
 
+		m_Prefetcher.Insert(levelPath, outLevelData);
 		return true;
 	}
 
@@ -74,40 +70,258 @@ namespace Engine
 		return m_DirectoryPath + m_LoadedLevelName + ".data";
 	}
 
-	void LevelSelection::SaveLevel(const Serialization::LevelData& levelData, bool overwrite)
+	bool LevelSelection::GetLastLoadedLevelData(Serialization::LevelData& outLevelData)
 	{
-		if (m_LoadedLevelName == "")
+		if (m_LoadedLevelName.empty())
 		{
-			overwrite = false;
+			return false;
 		}
 
-		std::string levelName = m_LoadedLevelName;
-		std::stringstream ss;
-		if (overwrite)
+		const std::string levelPath = GetLastLoadedLevelPath();
+		if (m_Prefetcher.TryGet(levelPath, outLevelData))
 		{
-			ss << m_DirectoryPath << m_LoadedLevelName << ".data";
+			return true;
 		}
-		else
+
+		if (!m_Catalogue.LoadLevel(m_Catalogue.FindLevel(m_LoadedLevelName), outLevelData))
 		{
-			levelName = fmt::format(LEVEL_NAME_FMT, (m_LevelNames.size() + 1));
-			ss << m_DirectoryPath << levelName << ".data";
+			return false;
 		}
 
+		m_Prefetcher.Insert(levelPath, outLevelData);
+		return true;
+	}
+
+	void LevelSelection::SaveLevel(const Serialization::LevelData& levelData, Solver::Uniqueness uniqueness, bool overwrite)
+	{
 		Notifications& notifications = Application::Get().GetNotifications();
-		if (Serialization::Write(levelData, ss.str()))
+		if (uniqueness == Solver::Uniqueness::NO_SOLUTION)
 		{
-			notifications.AddNotification(LOG_INFO, fmt::format("{} saved successfully!", levelName));
+			notifications.AddNotification(LOG_ERROR, "Level has no solution. Not saved.");
+			return;
+		}
+
+		if (m_LoadedLevelName == "")
+		{
+			overwrite = false;
+		}
+
+		std::string levelName = m_LoadedLevelName;
+		if (!overwrite)
+		{
+			// Names of deleted levels are not reused, and nothing else in the directory is renamed.
+			size_t levelNumber = m_Catalogue.GetLevelCount() + 1;
+			levelName = fmt::format(LEVEL_NAME_FMT, levelNumber);
+			while (m_Catalogue.FindLevel(levelName) != m_Catalogue.GetLevelCount()
+				|| std::filesystem::exists(m_DirectoryPath + levelName + ".data"))
+			{
+				levelName = fmt::format(LEVEL_NAME_FMT, ++levelNumber);
+			}
+		}
+
+		size_t levelIndex = 0;
+		const std::string levelPath = m_DirectoryPath + levelName + ".data";
+		const bool saved = m_Catalogue.SaveLevel(levelName, levelData, levelIndex);
+		m_Prefetcher.Invalidate(levelPath);
+
+		if (saved)
+		{
+			if (uniqueness == Solver::Uniqueness::MULTIPLE)
+			{
+				notifications.AddNotification(LOG_WARNING, fmt::format("{} saved, but has multiple solutions!", levelName));
+			}
+			else
+			{
+				notifications.AddNotification(LOG_INFO, fmt::format("{} saved successfully!", levelName));
+			}
 			m_LoadedLevelName = levelName;
+			m_Prefetcher.Insert(levelPath, levelData);
+
+			// The record was stored unrated; rating a large level can take longer than a frame.
+			QueueBackgroundRating({ RatingJob{ levelIndex, m_Catalogue.GetLevelPath(levelIndex), m_Catalogue.GetRecord(levelIndex).Checksum } });
 		}
 		else
 		{
 			notifications.AddNotification(LOG_ERROR, "Something went wrong");
 		}
+	}
 
-		if (!overwrite)
+	Solver::RatingBatchStats LevelSelection::RateLevels(size_t threadCount, bool rerate)
+	{
+		std::vector<size_t> levelIndices;
+		std::vector<size_t> unratable;
+		std::vector<Serialization::LevelData> levels;
+		for (size_t levelIndex = 0; levelIndex < m_Catalogue.GetLevelCount(); ++levelIndex)
+		{
+			if (!rerate && m_Catalogue.GetRecord(levelIndex).Rating != Serialization::RatingState::UNRATED)
+			{
+				continue;
+			}
+
+			Serialization::LevelData& levelData = levels.emplace_back();
+			if (!m_Catalogue.LoadLevel(levelIndex, levelData))
+			{
+				levels.pop_back();
+				unratable.push_back(levelIndex);
+				continue;
+			}
+			levelIndices.push_back(levelIndex);
+		}
+
+		std::vector<Solver::LevelRating> ratings;
+		const Solver::RatingBatchStats stats = levels.empty() ? Solver::RatingBatchStats{} : Solver::RateBatch(levels, threadCount, ratings);
+
+		std::vector<Serialization::CatalogueRating> catalogueRatings;
+		for (size_t i = 0; i < ratings.size(); ++i)
+		{
+			if (ratings[i].Solved)
+			{
+				catalogueRatings.push_back({ levelIndices[i], ratings[i].Difficulty, ratings[i].Techniques });
+			}
+			else
+			{
+				unratable.push_back(levelIndices[i]);
+			}
+		}
+
+		for (const size_t levelIndex : unratable)
+		{
+			catalogueRatings.push_back({ levelIndex, 0, 0, Serialization::RatingState::UNRATABLE });
+		}
+
+		if (!catalogueRatings.empty() && !m_Catalogue.StoreRatings(catalogueRatings))
+		{
+			TraceLog(LOG_ERROR, "Could not store the level ratings in %s", m_DirectoryPath.c_str());
+		}
+
+		return stats;
+	}
+
+	void LevelSelection::StartBackgroundRating()
+	{
+		StopBackgroundRating();
+
+		// Only the paths are read here; the worker parses the files itself, leaving the catalogue to this thread.
+		std::vector<RatingJob> jobs;
+		for (size_t levelIndex = 0; levelIndex < m_Catalogue.GetLevelCount(); ++levelIndex)
+		{
+			const Serialization::CatalogueRecord& record = m_Catalogue.GetRecord(levelIndex);
+			if (record.Rating == Serialization::RatingState::UNRATED)
+			{
+				jobs.push_back({ levelIndex, m_Catalogue.GetLevelPath(levelIndex), record.Checksum });
+			}
+		}
+
+		QueueBackgroundRating(std::move(jobs));
+	}
+
+	void LevelSelection::QueueBackgroundRating(std::vector<RatingJob> jobs)
+	{
+		if (jobs.empty())
 		{
-			LoadLevelNames(m_DirectoryPath);
+			return;
+		}
+
+		{
+			// The worker only finishes with the lock held and the queue empty, so it picks these up.
+			std::lock_guard<std::mutex> lock(m_RatingMutex);
+			if (m_RatingWorker.joinable() && !m_RatingDone)
+			{
+				m_RatingJobs.insert(m_RatingJobs.end(), std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
+				return;
+			}
+		}
+
+		if (m_RatingWorker.joinable())
+		{
+			m_RatingWorker.join();
+		}
+
+		m_RatingJobs.assign(std::make_move_iterator(jobs.begin()), std::make_move_iterator(jobs.end()));
+		m_StopRating = false;
+		m_RatingDone = false;
+		m_RatingWorker = std::thread(&LevelSelection::RatingWorkerLoop, this);
+	}
+
+	void LevelSelection::RatingWorkerLoop()
+	{
+		Solver::DifficultyRater rater;
+		while (!m_StopRating)
+		{
+			RatingJob job;
+			{
+				std::lock_guard<std::mutex> lock(m_RatingMutex);
+				if (m_RatingJobs.empty())
+				{
+					m_RatingDone = true;
+					return;
+				}
+
+				job = std::move(m_RatingJobs.front());
+				m_RatingJobs.pop_front();
+			}
+
+			RatingResult result{ job.LevelIndex, job.Checksum, Solver::LevelRating{}, false };
+			Serialization::LevelData levelData;
+			if (Serialization::Parse(job.Path, levelData))
+			{
+				result.Rated = rater.Rate(levelData, result.Rating);
+			}
+
+			std::lock_guard<std::mutex> lock(m_RatingMutex);
+			m_RatingResults.push_back(std::move(result));
+		}
+
+		std::lock_guard<std::mutex> lock(m_RatingMutex);
+		m_RatingJobs.clear();
+		m_RatingDone = true;
+	}
+
+	void LevelSelection::StoreBackgroundRatings(bool flush)
+	{
+		std::vector<RatingResult> results;
+		{
+			std::lock_guard<std::mutex> lock(m_RatingMutex);
+			if (m_RatingResults.empty() || (!flush && m_RatingResults.size() < RATING_BATCH_SIZE))
+			{
+				return;
+			}
+			results.swap(m_RatingResults);
+		}
+
+		std::vector<Serialization::CatalogueRating> catalogueRatings;
+		for (const RatingResult& result : results)
+		{
+			if (result.LevelIndex >= m_Catalogue.GetLevelCount() || m_Catalogue.GetRecord(result.LevelIndex).Checksum != result.Checksum)
+			{
+				continue;
+			}
+
+			catalogueRatings.push_back({ result.LevelIndex, result.Rating.Difficulty, result.Rating.Techniques,
+				result.Rated ? Serialization::RatingState::RATED : Serialization::RatingState::UNRATABLE });
+		}
+
+		if (!catalogueRatings.empty() && !m_Catalogue.StoreRatings(catalogueRatings))
+		{
+			TraceLog(LOG_ERROR, "Could not store the level ratings in %s", m_DirectoryPath.c_str());
+		}
+	}
+
+	void LevelSelection::StopBackgroundRating()
+	{
+		if (!m_RatingWorker.joinable())
+		{
+			return;
 		}
+
+		m_StopRating = true;
+		m_RatingWorker.join();
+		StoreBackgroundRatings(true);
+	}
+
+	const Serialization::CatalogueRecord& LevelSelection::GetLevelRecord(size_t levelIndex) const
+	{
+		return m_Catalogue.GetRecord(levelIndex);
 	}
 
 	void LevelSelection::ShowMenu()
@@ -115,6 +329,7 @@ namespace Engine
 		m_SlideTime = 0.0f;
 		m_AnimationDirection = 1;
 		m_IsOpen = true;
+		PrefetchAround(m_SelectedIndex);
 		Application::Get().AddEvent(Event{ EventType::INPUT_LAYER_OPERATION, {(int)InputLayerOperation::PUSH, (int)MappingContext::LEVEL_SELECTION} });
 	}
 
@@ -129,13 +344,14 @@ namespace Engine
 				m_SelectedIndex += event.data[1];
 				if (Settings.WrapAround)
 				{
-					m_SelectedIndex += m_LevelNames.size();
-					m_SelectedIndex %= m_LevelNames.size();
+					m_SelectedIndex += m_Catalogue.GetLevelCount();
+					m_SelectedIndex %= m_Catalogue.GetLevelCount();
 				}
 				else
 				{
-					m_SelectedIndex = std::min(std::max(m_SelectedIndex, 0), (int)(m_LevelNames.size() - 1));
+					m_SelectedIndex = std::min(std::max(m_SelectedIndex, 0), (int)(m_Catalogue.GetLevelCount() - 1));
 				}
+				PrefetchAround(m_SelectedIndex);
 				event.handled = true;
 				break;
 			}
@@ -159,6 +375,19 @@ namespace Engine
 
 	void LevelSelection::Update(const float deltaTime)
 	{
+		if (m_RatingWorker.joinable())
+		{
+			if (m_RatingDone)
+			{
+				m_RatingWorker.join();
+				StoreBackgroundRatings(true);
+			}
+			else
+			{
+				StoreBackgroundRatings(false);
+			}
+		}
+
 		if (!m_IsOpen && (m_AnimationDirection == 0))
 		{
 			return;
@@ -194,6 +423,8 @@ namespace Engine
 
 	void LevelSelection::Draw(float widthPercent, float heightPercent, float padding)
 	{
+		PROFILE_SCOPE(LEVEL_SELECTION_DRAW);
+
 		if (!m_IsOpen && (m_AnimationDirection == 0))
 		{
 			return;
@@ -231,7 +462,7 @@ namespace Engine
 			m_DrawOffsetIndex = m_SelectedIndex - (displayCount / 2);
 
 			m_DrawOffsetIndex = std::max(m_DrawOffsetIndex, 0);
-			m_DrawOffsetIndex = std::min(m_DrawOffsetIndex, (int)m_LevelNames.size() - 1);
+			m_DrawOffsetIndex = std::min(m_DrawOffsetIndex, (int)m_Catalogue.GetLevelCount() - 1);
 
 			const int deltaOffset = std::abs(m_DrawOffsetIndex - m_PrevDrawOffsetIndex);
 			if (m_DrawOffsetIndex > m_PrevDrawOffsetIndex)
@@ -250,15 +481,24 @@ namespace Engine
 		}
 
 		BeginScissorMode((int)ClientArea.x, (int)ClientArea.y, (int)ClientArea.width, (int)ClientArea.height);
-		for (int i = std::min(m_PrevDrawOffsetIndex, m_DrawOffsetIndex); i < std::min(std::max(m_PrevDrawOffsetIndex, m_DrawOffsetIndex) + displayCount, (int)m_LevelNames.size()); ++i)
+		for (int i = std::min(m_PrevDrawOffsetIndex, m_DrawOffsetIndex); i < std::min(std::max(m_PrevDrawOffsetIndex, m_DrawOffsetIndex) + displayCount, (int)m_Catalogue.GetLevelCount()); ++i)
 		{
 			float baseY = nextDrawPosition.y + m_Offset;
 
 			ItemStyle style = (i == m_SelectedIndex) ? SelectedItemStyle : NormalItemStyle;
 			DrawRectangle((int)nextDrawPosition.x, (int)baseY, (int)ClientArea.width, Settings.ItemHeight, style.ItemBackground);
-			DrawText(m_LevelNames[i].c_str(),
+			DrawText(m_Catalogue.GetLevelName(i),
 				(int)(nextDrawPosition.x + 10),
 				(int)(baseY + 0.5f * (Settings.ItemHeight - Settings.FontSize)), Settings.FontSize, style.ItemText);
+
+			const uint16_t difficulty = m_Catalogue.GetRecord(i).Difficulty;
+			if (difficulty != 0)
+			{
+				const std::string difficultyText = fmt::format("Difficulty {}", difficulty);
+				DrawText(difficultyText.c_str(),
+					(int)(nextDrawPosition.x + ClientArea.width - 10 - MeasureText(difficultyText.c_str(), Settings.FontSize)),
+					(int)(baseY + 0.5f * (Settings.ItemHeight - Settings.FontSize)), Settings.FontSize, style.ItemText);
+			}
 			nextDrawPosition.y += Settings.ItemHeight + Settings.Separation;
 		}
 		EndScissorMode();
@@ -284,6 +524,46 @@ namespace Engine
 
 	bool LevelSelection::HasLevels() const
 	{
-		return m_LevelNames.size();
+		return m_Catalogue.GetLevelCount();
+	}
+
+	size_t LevelSelection::GetLevelCount() const
+	{
+		return m_Catalogue.GetLevelCount();
+	}
+
+	const LevelPrefetcher& LevelSelection::GetPrefetcher() const
+	{
+		return m_Prefetcher;
+	}
+
+	void LevelSelection::PrefetchAround(int levelIndex)
+	{
+		const int levelCount = (int)m_Catalogue.GetLevelCount();
+		if (levelCount == 0)
+		{
+			return;
+		}
+
+		// The highlighted level first, then its neighbours by distance.
+		std::vector<std::string> paths;
+		for (int distance = 0; distance <= PREFETCH_RADIUS; ++distance)
+		{
+			for (const int index : { levelIndex + distance, levelIndex - distance })
+			{
+				const int wrappedIndex = Settings.WrapAround ? (index + levelCount) % levelCount : index;
+				if (wrappedIndex >= 0 && wrappedIndex < levelCount)
+				{
+					paths.push_back(m_Catalogue.GetLevelPath(wrappedIndex));
+				}
+
+				if (distance == 0)
+				{
+					break;
+				}
+			}
+		}
+
+		m_Prefetcher.Prefetch(paths);
 	}
-}
\ No newline at end of file
+}
@@ -1,11 +1,19 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "Events.h"
 #include "Actions.h"
 
 #include "Serialization/LevelData.h"
+#include "Serialization/LevelCatalogue.h"
+#include "LevelPrefetcher.h"
+#include "Solver/Solver.h"
+#include "Solver/DifficultyRater.h"
 
 namespace Engine
 {
@@ -33,13 +41,37 @@ namespace Engine
 	{
 		const std::string LEVEL_NAME_FMT = "Level{:03}";
 
+		// Levels on either side of the highlighted one that are parsed in the background.
+		static const int PREFETCH_RADIUS = 2;
+
+		// Background ratings are stored in batches, as each store reopens the index.
+		static const size_t RATING_BATCH_SIZE = 64;
+
 	public:
-		void LoadLevelNames(const std::string& directoryPath);
+		~LevelSelection();
+
+		// Opens the level catalogue of the directory; levels are only parsed when selected.
+		void LoadCatalogue(const std::string& directoryPath);
 		bool ParseLevel(size_t levelIndex, Serialization::LevelData& outLevelData);
 		std::string GetLastLoadedLevelPath() const;
 		std::string GetLastLoadedLevelName() const;
 
-		void SaveLevel(const Serialization::LevelData& levelData, bool overwrite = false);
+		// The last loaded or saved level as it is on disk, from the prefetch cache when it is there.
+		bool GetLastLoadedLevelData(Serialization::LevelData& outLevelData);
+
+		// Levels without a solution are not saved; ambiguous ones are saved with a warning. Saved levels
+		// are rated in the background.
+		void SaveLevel(const Serialization::LevelData& levelData, Solver::Uniqueness uniqueness, bool overwrite = false);
+
+		// Rates levels in parallel and stores the ratings in the catalogue. Levels that already have
+		// a rating are skipped unless rerate is set.
+		Solver::RatingBatchStats RateLevels(size_t threadCount = 0, bool rerate = false);
+
+		// Rates the levels that were never tried on one worker thread. Update stores the ratings as
+		// they come in; levels whose file changed in the meantime are left for the next start, or for
+		// the rating queued when the level is saved.
+		void StartBackgroundRating();
+		const Serialization::CatalogueRecord& GetLevelRecord(size_t levelIndex) const;
 		void ShowMenu();
 
 		void ProcessEvents(Event& event);
@@ -51,6 +83,35 @@ namespace Engine
 		bool IsOpen() const;
 
 		bool HasLevels() const;
+		size_t GetLevelCount() const;
+
+		const LevelPrefetcher& GetPrefetcher() const;
+
+	private:
+		// The checksum is the record's when the job was queued; the rating is only stored if the
+		// record at LevelIndex still has it.
+		struct RatingJob
+		{
+			size_t LevelIndex;
+			std::string Path;
+			uint32_t Checksum;
+		};
+
+		struct RatingResult
+		{
+			size_t LevelIndex;
+			uint32_t Checksum;
+			Solver::LevelRating Rating;
+			bool Rated;
+		};
+
+		void PrefetchAround(int levelIndex);
+
+		// Adds the jobs to the running worker's queue, or starts a worker for them.
+		void QueueBackgroundRating(std::vector<RatingJob> jobs);
+		void RatingWorkerLoop();
+		void StoreBackgroundRatings(bool flush);
+		void StopBackgroundRating();
 
 	public:
 		ScrollSettings Settings;
@@ -61,7 +122,15 @@ namespace Engine
 		
 		std::string m_LoadedLevelName;
 		std::string m_DirectoryPath;
-		std::vector<std::string> m_LevelNames;
+		Serialization::LevelCatalogue m_Catalogue;
+		LevelPrefetcher m_Prefetcher;
+
+		std::thread m_RatingWorker;
+		std::mutex m_RatingMutex;
+		std::deque<RatingJob> m_RatingJobs;
+		std::vector<RatingResult> m_RatingResults;
+		std::atomic<bool> m_RatingDone = false;
+		std::atomic<bool> m_StopRating = false;
 
 		int m_DrawOffsetIndex = 0;
 		int m_PrevDrawOffsetIndex = 0;
@@ -0,0 +1,235 @@
+#include "MoveJournal.h"
+#include <algorithm>
+#include <iterator>
+
+#include "Serialization/ByteIO.h"
+
+namespace Engine
+{
+	static const uint8_t MOVE_JOURNAL_MAGIC[4] = { 'F', 'U', 'T', 'J' };
+
+	using Serialization::WriteUInt16;
+	using Serialization::WriteUInt32;
+	using Serialization::ReadUInt16;
+	using Serialization::ReadUInt32;
+
+	// Returns where the first entry goes; the space for entryCount entries is appended as well.
+	static uint8_t* AppendEncodedHeader(uint8_t gridSize, size_t entryCount, size_t undoCount, std::vector<uint8_t>& outBytes)
+	{
+		const size_t start = outBytes.size();
+		outBytes.resize(start + MoveJournal::ENCODED_HEADER_SIZE + entryCount * MoveJournal::ENCODED_ENTRY_SIZE, 0);
+
+		uint8_t* header = outBytes.data() + start;
+		std::copy(std::begin(MOVE_JOURNAL_MAGIC), std::end(MOVE_JOURNAL_MAGIC), header);
+		header[4] = MoveJournal::ENCODED_VERSION;
+		header[5] = gridSize;
+		WriteUInt32(header + 8, (uint32_t)entryCount);
+		WriteUInt32(header + 12, (uint32_t)undoCount);
+		return header + MoveJournal::ENCODED_HEADER_SIZE;
+	}
+
+	static void EncodeEntry(const JournalEntry& entry, uint8_t* dest)
+	{
+		WriteUInt16(dest, entry.Cell);
+		WriteUInt16(dest + 2, entry.OtherCell);
+		WriteUInt16(dest + 4, entry.OldGuesses);
+		WriteUInt16(dest + 6, entry.NewGuesses);
+		dest[8] = entry.OldNumber;
+		dest[9] = entry.NewNumber;
+		dest[10] = (uint8_t)entry.Kind;
+		dest[11] = entry.Flags;
+	}
+
+	MoveJournal::MoveJournal(size_t capacity)
+	{
+		size_t roundedCapacity = MIN_CAPACITY;
+		while (roundedCapacity < capacity)
+		{
+			roundedCapacity <<= 1;
+		}
+
+		m_Entries.resize(roundedCapacity);
+		m_Mask = roundedCapacity - 1;
+	}
+
+	void MoveJournal::Clear()
+	{
+		m_Begin = 0;
+		m_Cursor = 0;
+		m_End = 0;
+		m_StepPending = true;
+	}
+
+	void MoveJournal::BeginStep()
+	{
+		m_StepPending = true;
+	}
+
+	void MoveJournal::Record(JournalEntry entry)
+	{
+		entry.Flags = m_StepPending ? (entry.Flags | JournalEntry::STEP_START) : (entry.Flags & ~JournalEntry::STEP_START);
+		m_StepPending = false;
+
+		m_End = m_Cursor;
+		if (m_End - m_Begin == m_Entries.size())
+		{
+			do
+			{
+				m_Begin++;
+			} while (m_Begin < m_End && !(At(m_Begin).Flags & JournalEntry::STEP_START));
+		}
+
+		At(m_End++) = entry;
+		m_Cursor = m_End;
+	}
+
+	bool MoveJournal::Undo(std::vector<JournalEntry>& outEntries)
+	{
+		outEntries.clear();
+		if (!CanUndo())
+		{
+			return false;
+		}
+
+		do
+		{
+			outEntries.push_back(At(--m_Cursor));
+		} while (m_Cursor > m_Begin && !(outEntries.back().Flags & JournalEntry::STEP_START));
+
+		m_StepPending = true;
+		return true;
+	}
+
+	bool MoveJournal::Redo(std::vector<JournalEntry>& outEntries)
+	{
+		outEntries.clear();
+		if (!CanRedo())
+		{
+			return false;
+		}
+
+		do
+		{
+			outEntries.push_back(At(m_Cursor++));
+		} while (m_Cursor < m_End && !(At(m_Cursor).Flags & JournalEntry::STEP_START));
+
+		m_StepPending = true;
+		return true;
+	}
+
+	bool MoveJournal::CanUndo() const
+	{
+		return m_Cursor > m_Begin;
+	}
+
+	bool MoveJournal::CanRedo() const
+	{
+		return m_Cursor < m_End;
+	}
+
+	size_t MoveJournal::GetEntryCount() const
+	{
+		return (size_t)(m_End - m_Begin);
+	}
+
+	size_t MoveJournal::GetCapacity() const
+	{
+		return m_Entries.size();
+	}
+
+	size_t MoveJournal::GetMemoryUsage() const
+	{
+		return m_Entries.size() * sizeof(JournalEntry);
+	}
+
+	size_t MoveJournal::GetEncodedSize() const
+	{
+		return ENCODED_HEADER_SIZE + GetEntryCount() * ENCODED_ENTRY_SIZE;
+	}
+
+	void MoveJournal::Encode(uint8_t gridSize, std::vector<uint8_t>& outBytes) const
+	{
+		uint8_t* dest = AppendEncodedHeader(gridSize, GetEntryCount(), (size_t)(m_Cursor - m_Begin), outBytes);
+		for (uint64_t position = m_Begin; position < m_End; ++position, dest += ENCODED_ENTRY_SIZE)
+		{
+			EncodeEntry(At(position), dest);
+		}
+	}
+
+	void MoveJournal::CopyEntries(std::vector<JournalEntry>& outEntries, size_t& outUndoCount) const
+	{
+		// The held entries are at most two runs of the ring.
+		const size_t entryCount = GetEntryCount();
+		const size_t first = (size_t)(m_Begin & m_Mask);
+		const size_t firstRun = std::min(entryCount, m_Entries.size() - first);
+
+		outEntries.assign(m_Entries.begin() + first, m_Entries.begin() + first + firstRun);
+		outEntries.insert(outEntries.end(), m_Entries.begin(), m_Entries.begin() + (entryCount - firstRun));
+		outUndoCount = (size_t)(m_Cursor - m_Begin);
+	}
+
+	void MoveJournal::EncodeEntries(uint8_t gridSize, const std::vector<JournalEntry>& entries, size_t undoCount,
+		std::vector<uint8_t>& outBytes)
+	{
+		uint8_t* dest = AppendEncodedHeader(gridSize, entries.size(), undoCount, outBytes);
+		for (const JournalEntry& entry : entries)
+		{
+			EncodeEntry(entry, dest);
+			dest += ENCODED_ENTRY_SIZE;
+		}
+	}
+
+	bool MoveJournal::Decode(const uint8_t* data, size_t size, uint8_t gridSize, bool playOnly)
+	{
+		Clear();
+
+		if (size < ENCODED_HEADER_SIZE
+			|| !std::equal(std::begin(MOVE_JOURNAL_MAGIC), std::end(MOVE_JOURNAL_MAGIC), data)
+			|| data[4] != ENCODED_VERSION
+			|| data[5] != gridSize)
+		{
+			return false;
+		}
+
+		const size_t entryCount = ReadUInt32(data + 8);
+		const size_t undoCount = ReadUInt32(data + 12);
+		if (entryCount > m_Entries.size() || undoCount > entryCount
+			|| size < ENCODED_HEADER_SIZE + entryCount * ENCODED_ENTRY_SIZE)
+		{
+			return false;
+		}
+
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		const uint8_t* src = data + ENCODED_HEADER_SIZE;
+		for (size_t i = 0; i < entryCount; ++i, src += ENCODED_ENTRY_SIZE)
+		{
+			JournalEntry& entry = m_Entries[i];
+			entry.Cell = ReadUInt16(src);
+			entry.OtherCell = ReadUInt16(src + 2);
+			entry.OldGuesses = ReadUInt16(src + 4);
+			entry.NewGuesses = ReadUInt16(src + 6);
+			entry.OldNumber = src[8];
+			entry.NewNumber = src[9];
+			entry.Kind = (JournalEntryKind)src[10];
+			entry.Flags = src[11];
+
+			// Steps must start at the first entry and at the redo position, or undo would split them.
+			const bool mustStartStep = i == 0 || i == undoCount;
+			const bool editorOnly = entry.Kind != JournalEntryKind::CELL
+				|| (entry.Flags & (JournalEntry::OLD_LOCKED | JournalEntry::NEW_LOCKED));
+			if (entry.Cell >= cellCount || entry.OtherCell >= cellCount
+				|| (playOnly && editorOnly)
+				|| entry.OldNumber > gridSize || entry.NewNumber > gridSize
+				|| entry.Kind > JournalEntryKind::CONSTRAINT_FLIP
+				|| (mustStartStep && !(entry.Flags & JournalEntry::STEP_START)))
+			{
+				Clear();
+				return false;
+			}
+		}
+
+		m_End = entryCount;
+		m_Cursor = undoCount;
+		return true;
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace Engine
+{
+	enum class JournalEntryKind : uint8_t
+	{
+		CELL,              // Number, guesses and lock of Cell changed
+		CONSTRAINT_ADD,    // Cell > OtherCell was added
+		CONSTRAINT_REMOVE, // Cell > OtherCell was removed
+		CONSTRAINT_FLIP    // OtherCell > Cell became Cell > OtherCell
+	};
+
+	// One change to the board. Cells are row-major indices, so entries only make sense for the grid size they were recorded on.
+	struct JournalEntry
+	{
+		static const uint8_t STEP_START = 1 << 0; // First entry of an undo step
+		static const uint8_t OLD_LOCKED = 1 << 1;
+		static const uint8_t NEW_LOCKED = 1 << 2;
+
+		uint16_t Cell = 0;
+		uint16_t OtherCell = 0;
+		uint16_t OldGuesses = 0;
+		uint16_t NewGuesses = 0;
+		uint8_t OldNumber = 0;
+		uint8_t NewNumber = 0;
+		JournalEntryKind Kind = JournalEntryKind::CELL;
+		uint8_t Flags = 0;
+	};
+
+	static_assert(sizeof(JournalEntry) == 12, "Journal entries are packed into 12 bytes");
+
+	// Undo history as a ring of board deltas allocated up front. An undo step is the run of entries
+	// from one STEP_START to the next, so a reset is one step however many cells it clears. When the
+	// ring is full, recording drops the oldest step; memory never grows past the capacity.
+	//
+	// Encoded layout (all multi-byte values little endian):
+	//   0  char[4]  "FUTJ"
+	//   4  uint8    version
+	//   5  uint8    grid size the entries were recorded on
+	//   6  uint16   reserved
+	//   8  uint32   entry count
+	//  12  uint32   undo count; the entries after it are redone by Redo
+	//  16  entries, oldest first: uint16 cell, uint16 other cell, uint16 old guesses, uint16 new guesses,
+	//      uint8 old number, uint8 new number, uint8 kind, uint8 flags
+	class MoveJournal
+	{
+	public:
+		static const size_t DEFAULT_CAPACITY = 1 << 16; // Entries, 768 KiB
+		static const size_t MIN_CAPACITY = 1 << 8;      // A reset of the largest grid fits
+		static const uint8_t ENCODED_VERSION = 1;
+		static const size_t ENCODED_HEADER_SIZE = 16;
+		static const size_t ENCODED_ENTRY_SIZE = 12;
+
+		// The capacity is rounded up to a power of two.
+		MoveJournal(size_t capacity = DEFAULT_CAPACITY);
+
+		void Clear();
+
+		// The next recorded entry starts a new undo step; a step that records nothing is not kept.
+		void BeginStep();
+
+		// Drops everything that could be redone.
+		void Record(JournalEntry entry);
+
+		// Moves over one step and copies its entries, newest first for Undo and oldest first for Redo,
+		// into outEntries. Returns false when there is nothing to undo or redo.
+		bool Undo(std::vector<JournalEntry>& outEntries);
+		bool Redo(std::vector<JournalEntry>& outEntries);
+
+		bool CanUndo() const;
+		bool CanRedo() const;
+
+		size_t GetEntryCount() const;
+		size_t GetCapacity() const;
+		size_t GetMemoryUsage() const;
+
+		// Appends the held entries, undoable and redoable.
+		void Encode(uint8_t gridSize, std::vector<uint8_t>& outBytes) const;
+
+		// Copies the held entries, oldest first, and how many of them Undo steps back over. The copy
+		// can be encoded on another thread with EncodeEntries, to the same bytes as Encode.
+		void CopyEntries(std::vector<JournalEntry>& outEntries, size_t& outUndoCount) const;
+		static void EncodeEntries(uint8_t gridSize, const std::vector<JournalEntry>& entries, size_t undoCount,
+			std::vector<uint8_t>& outBytes);
+
+		// Fails, leaving the journal empty, on malformed data, a different grid size or cells outside the grid.
+		// With playOnly set, entries only the editor records (constraints and locks) fail it as well.
+		bool Decode(const uint8_t* data, size_t size, uint8_t gridSize, bool playOnly = false);
+		size_t GetEncodedSize() const;
+
+	private:
+		JournalEntry& At(uint64_t position) { return m_Entries[position & m_Mask]; }
+		const JournalEntry& At(uint64_t position) const { return m_Entries[position & m_Mask]; }
+
+	private:
+		std::vector<JournalEntry> m_Entries;
+		uint64_t m_Mask = 0;
+
+		// Positions count every entry ever recorded; the ring slot is the position masked by the capacity.
+		uint64_t m_Begin = 0;  // Oldest held entry
+		uint64_t m_Cursor = 0; // Entries before it are undone by Undo
+		uint64_t m_End = 0;    // Entries from m_Cursor up to here are redone by Redo
+		bool m_StepPending = true;
+	};
+}
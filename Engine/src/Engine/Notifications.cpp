@@ -2,6 +2,7 @@
 #include "raymath.h"
 
 #include "Animations/Easings.h"
+#include "Profiler.h"
 
 namespace Engine
 {
@@ -29,6 +30,16 @@ namespace Engine
 	void Notifications::AddNotification(TraceLogLevel status, const std::string& text, float duration)
 	{
 		m_Notifications.push_back(Notification{status, text, duration, Style.FadeDuration});
+
+		if (m_EchoToLog)
+		{
+			TraceLog(status, "%s", text.c_str());
+		}
+	}
+
+	void Notifications::SetEchoToLog(bool echoToLog)
+	{
+		m_EchoToLog = echoToLog;
 	}
 
 	void Notifications::Update(const float deltaTime)
@@ -68,6 +79,8 @@ namespace Engine
 
 	void Notifications::Draw(float offsetPercentX, float offsetPercentY, float widthPercent)
 	{
+		PROFILE_SCOPE(NOTIFICATIONS_DRAW);
+
 		if (m_Notifications.empty())
 		{
 			return;
@@ -35,6 +35,9 @@ namespace Engine
 	public:
 		void AddNotification(TraceLogLevel status, const std::string& text, float duration = 1.5f);
 
+		// Also writes every notification to the raylib log, for runs without a window.
+		void SetEchoToLog(bool echoToLog);
+
 		void Update(const float deltaTime);
 
 		void Draw(float offsetPercentX, float offsetPercentY = -1.0f, float widthPercent = -1.0f);
@@ -44,5 +47,6 @@ namespace Engine
 
 	private:
 		std::vector<Notification> m_Notifications;
+		bool m_EchoToLog = false;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "Profiler.h"
+#include <fstream>
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "raylib.h"
+
+namespace Engine
+{
+	const char* ToString(ProfilePhase phase)
+	{
+		switch (phase)
+		{
+		case ProfilePhase::FRAME:
+			return "Frame";
+		case ProfilePhase::GENERATE_EVENTS:
+			return "ActionMap::GenerateEvents";
+		case ProfilePhase::PROCESS_EVENTS:
+			return "Application::ProcessEvents";
+		case ProfilePhase::GRID_UPDATE:
+			return "Grid::Update";
+		case ProfilePhase::GRID_DRAW:
+			return "Grid::Draw";
+		case ProfilePhase::LEVEL_SELECTION_DRAW:
+			return "LevelSelection::Draw";
+		case ProfilePhase::NOTIFICATIONS_DRAW:
+			return "Notifications::Draw";
+		default:
+			return "Unknown";
+		}
+	}
+
+	Profiler& Profiler::Get()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	Profiler::Profiler()
+		: m_StartTime(std::chrono::steady_clock::now())
+	{
+	}
+
+	uint64_t Profiler::Now() const
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_StartTime).count();
+	}
+
+	void Profiler::BeginFrame()
+	{
+		m_CurrentFrame = FrameSample{};
+		m_FrameStartTime = Now();
+	}
+
+	void Profiler::EndFrame()
+	{
+		Record(ProfilePhase::FRAME, m_FrameStartTime, Now());
+
+		m_Frames[m_NextFrame] = m_CurrentFrame;
+		m_NextFrame = (m_NextFrame + 1) % FRAME_CAPACITY;
+		m_FrameCount = std::min(m_FrameCount + 1, FRAME_CAPACITY);
+
+		if (m_ShowOverlay && ++m_FramesSinceRefresh >= OVERLAY_REFRESH_FRAMES)
+		{
+			RefreshOverlayStats();
+		}
+	}
+
+	void Profiler::Record(ProfilePhase phase, uint64_t startTime, uint64_t endTime)
+	{
+		const uint64_t duration = endTime - startTime;
+		m_CurrentFrame.PhaseTimes[(size_t)phase] += duration;
+
+		m_Spans[m_NextSpan] = ProfileSpan{ startTime, (uint32_t)std::min<uint64_t>(duration, UINT32_MAX), phase };
+		m_NextSpan = (m_NextSpan + 1) % SPAN_CAPACITY;
+		m_SpanCount = std::min(m_SpanCount + 1, SPAN_CAPACITY);
+	}
+
+	size_t Profiler::GetFrameCount() const
+	{
+		return m_FrameCount;
+	}
+
+	const FrameSample& Profiler::GetFrame(size_t frameIndex) const
+	{
+		return m_Frames[(m_NextFrame + FRAME_CAPACITY - m_FrameCount + frameIndex) % FRAME_CAPACITY];
+	}
+
+	PhaseStats Profiler::ComputePhaseStats(ProfilePhase phase) const
+	{
+		if (m_FrameCount == 0)
+		{
+			return PhaseStats{};
+		}
+
+		uint64_t times[FRAME_CAPACITY];
+		for (size_t i = 0; i < m_FrameCount; ++i)
+		{
+			times[i] = GetFrame(i).PhaseTimes[(size_t)phase];
+		}
+
+		// Nearest rank
+		const auto percentile = [&](size_t percent)
+		{
+			const size_t rank = std::max<size_t>((percent * m_FrameCount + 99) / 100, 1) - 1;
+			std::nth_element(times, times + rank, times + m_FrameCount);
+			return times[rank] / 1.0e6;
+		};
+
+		PhaseStats stats;
+		stats.P50 = percentile(50);
+		stats.P99 = percentile(99);
+		return stats;
+	}
+
+	bool Profiler::WriteChromeTrace(const std::string& path) const
+	{
+		std::ofstream file(path, std::ofstream::out | std::ofstream::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		for (size_t i = 0; i < m_SpanCount; ++i)
+		{
+			const ProfileSpan& span = m_Spans[(m_NextSpan + SPAN_CAPACITY - m_SpanCount + i) % SPAN_CAPACITY];
+			file << fmt::format("{}\n{{\"name\":\"{}\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":1}}",
+				i == 0 ? "" : ",", ToString(span.Phase), span.StartTime / 1.0e3, span.Duration / 1.0e3);
+		}
+		file << "\n]}\n";
+
+		return file.good();
+	}
+
+	void Profiler::ToggleOverlay()
+	{
+		m_ShowOverlay = !m_ShowOverlay;
+		m_FramesSinceRefresh = OVERLAY_REFRESH_FRAMES;
+	}
+
+	bool Profiler::IsOverlayVisible() const
+	{
+		return m_ShowOverlay;
+	}
+
+	void Profiler::DrawOverlay(int rightX, int topY)
+	{
+		if (!m_ShowOverlay)
+		{
+			return;
+		}
+
+		if (m_FramesSinceRefresh >= OVERLAY_REFRESH_FRAMES)
+		{
+			RefreshOverlayStats();
+		}
+
+		const int fontSize = 16;
+		const int lineHeight = fontSize + 4;
+		const int nameWidth = 230;
+		const int columnWidth = 70;
+		const int padding = 8;
+		const int width = nameWidth + 2 * columnWidth + 2 * padding;
+		const int height = (1 + (int)ProfilePhase::COUNT) * lineHeight + 2 * padding;
+
+		const int x = rightX - width;
+		const int y = topY;
+
+		DrawRectangle(x, y, width, height, Fade(LIGHTGRAY, 0.85f));
+
+		int startX = x + padding;
+		int startY = y + padding;
+		DrawText(fmt::format("{} frames", m_FrameCount).c_str(), startX, startY, fontSize, DARKGRAY);
+		DrawText("p50 ms", startX + nameWidth, startY, fontSize, DARKGRAY);
+		DrawText("p99 ms", startX + nameWidth + columnWidth, startY, fontSize, DARKGRAY);
+
+		for (size_t i = 0; i < (size_t)ProfilePhase::COUNT; ++i)
+		{
+			startY += lineHeight;
+			DrawText(ToString((ProfilePhase)i), startX, startY, fontSize, DARKGRAY);
+			DrawText(fmt::format("{:.3f}", m_OverlayStats[i].P50).c_str(), startX + nameWidth, startY, fontSize, DARKGRAY);
+			DrawText(fmt::format("{:.3f}", m_OverlayStats[i].P99).c_str(), startX + nameWidth + columnWidth, startY, fontSize, DARKGRAY);
+		}
+	}
+
+	void Profiler::RefreshOverlayStats()
+	{
+		for (size_t i = 0; i < (size_t)ProfilePhase::COUNT; ++i)
+		{
+			m_OverlayStats[i] = ComputePhaseStats((ProfilePhase)i);
+		}
+		m_FramesSinceRefresh = 0;
+	}
+
+	ScopedTimer::ScopedTimer(ProfilePhase phase)
+		: m_Phase(phase)
+		, m_StartTime(Profiler::Get().Now())
+	{
+	}
+
+	ScopedTimer::~ScopedTimer()
+	{
+		Profiler& profiler = Profiler::Get();
+		profiler.Record(m_Phase, m_StartTime, profiler.Now());
+	}
+
+	ScopedFrame::ScopedFrame()
+	{
+		Profiler::Get().BeginFrame();
+	}
+
+	ScopedFrame::~ScopedFrame()
+	{
+		Profiler::Get().EndFrame();
+	}
+}
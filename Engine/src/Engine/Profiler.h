@@ -0,0 +1,129 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <chrono>
+
+// Scoped timers are compiled out of Release builds.
+#ifndef BUILD_RELEASE
+#define PROFILER_ENABLED 1
+#else
+#define PROFILER_ENABLED 0
+#endif
+
+namespace Engine
+{
+	enum class ProfilePhase : uint8_t
+	{
+		FRAME = 0,
+		GENERATE_EVENTS,
+		PROCESS_EVENTS,
+		GRID_UPDATE,
+		GRID_DRAW,
+		LEVEL_SELECTION_DRAW,
+		NOTIFICATIONS_DRAW,
+		COUNT
+	};
+
+	const char* ToString(ProfilePhase phase);
+
+	// Time spent in each phase during one frame, in nanoseconds. Phases entered several times are summed.
+	struct FrameSample
+	{
+		uint64_t PhaseTimes[(size_t)ProfilePhase::COUNT];
+	};
+
+	// One timed scope, kept for the trace dump.
+	struct ProfileSpan
+	{
+		uint64_t StartTime;
+		uint32_t Duration;
+		ProfilePhase Phase;
+	};
+
+	// In milliseconds.
+	struct PhaseStats
+	{
+		double P50 = 0.0;
+		double P99 = 0.0;
+	};
+
+	// Collects the timings of the last FRAME_CAPACITY frames. Only used from the main thread.
+	class Profiler
+	{
+	public:
+		static const size_t FRAME_CAPACITY = 600;
+		static const size_t SPAN_CAPACITY = FRAME_CAPACITY * 16;
+		static const size_t OVERLAY_REFRESH_FRAMES = 30;
+
+		static Profiler& Get();
+
+		// Nanoseconds since the profiler was created.
+		uint64_t Now() const;
+
+		void BeginFrame();
+		void EndFrame();
+		void Record(ProfilePhase phase, uint64_t startTime, uint64_t endTime);
+
+		size_t GetFrameCount() const;
+		const FrameSample& GetFrame(size_t frameIndex) const; // 0 is the oldest frame still in the buffer
+		PhaseStats ComputePhaseStats(ProfilePhase phase) const;
+
+		// Writes the recorded spans in the Chrome trace event format (chrome://tracing, Perfetto).
+		bool WriteChromeTrace(const std::string& path) const;
+
+		void ToggleOverlay();
+		bool IsOverlayVisible() const;
+		void DrawOverlay(int rightX, int topY); // p50/p99 per phase, anchored at its top right corner
+
+	private:
+		Profiler();
+
+		void RefreshOverlayStats();
+
+	private:
+		const std::chrono::steady_clock::time_point m_StartTime;
+
+		FrameSample m_Frames[FRAME_CAPACITY];
+		size_t m_NextFrame = 0;
+		size_t m_FrameCount = 0;
+		FrameSample m_CurrentFrame{};
+		uint64_t m_FrameStartTime = 0;
+
+		ProfileSpan m_Spans[SPAN_CAPACITY];
+		size_t m_NextSpan = 0;
+		size_t m_SpanCount = 0;
+
+		bool m_ShowOverlay = false;
+		size_t m_FramesSinceRefresh = OVERLAY_REFRESH_FRAMES;
+		PhaseStats m_OverlayStats[(size_t)ProfilePhase::COUNT];
+	};
+
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(ProfilePhase phase);
+		~ScopedTimer();
+
+	private:
+		const ProfilePhase m_Phase;
+		const uint64_t m_StartTime;
+	};
+
+	class ScopedFrame
+	{
+	public:
+		ScopedFrame();
+		~ScopedFrame();
+	};
+}
+
+#if PROFILER_ENABLED
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ::Engine::ScopedTimer PROFILER_CONCAT(profileScope, __LINE__)(::Engine::ProfilePhase::phase)
+#define PROFILE_FRAME() ::Engine::ScopedFrame PROFILER_CONCAT(profileFrame, __LINE__)
+#else
+#define PROFILE_SCOPE(phase)
+#define PROFILE_FRAME()
+#endif
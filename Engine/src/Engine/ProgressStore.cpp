@@ -0,0 +1,293 @@
+#include "ProgressStore.h"
+#include <filesystem>
+
+namespace Engine
+{
+	ProgressStore::~ProgressStore()
+	{
+		Stop();
+	}
+
+	bool ProgressStore::Open(const std::string& directoryPath)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(directoryPath, error);
+		if (error)
+		{
+			m_DirectoryPath.clear();
+			return false;
+		}
+
+		m_DirectoryPath = directoryPath;
+		return true;
+	}
+
+	bool ProgressStore::IsOpen() const
+	{
+		return !m_DirectoryPath.empty();
+	}
+
+	void ProgressStore::BeginLevel(const std::string& levelName, const Serialization::LevelData& levelData)
+	{
+		CancelRead();
+		if (m_State == LevelState::SAVING)
+		{
+			Job job;
+			job.Type = JobType::CLOSE;
+			Push(std::move(job));
+		}
+		m_State = LevelState::IDLE;
+
+		if (!IsOpen() || levelName.empty())
+		{
+			return;
+		}
+
+		m_SavePath = GetSavePath(levelName);
+		m_LevelHash = Serialization::ComputeLevelHash(levelData);
+		m_State = LevelState::READING;
+
+		Job job;
+		job.Type = JobType::READ;
+		job.Path = m_SavePath;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			job.Generation = m_Generation;
+		}
+		Push(std::move(job));
+	}
+
+	bool ProgressStore::Update(GridModel& model)
+	{
+		if (m_State == LevelState::READING)
+		{
+			Serialization::SaveGameData saveGame;
+			bool read = false;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (!m_ReadDone)
+				{
+					return false;
+				}
+
+				m_ReadDone = false;
+				read = m_ReadSucceeded;
+				saveGame = std::move(m_ReadSaveGame);
+			}
+
+			m_State = LevelState::SAVING;
+			if (!model.HasValidData())
+			{
+				m_State = LevelState::IDLE;
+				return false;
+			}
+
+			// Progress on an older version of the level is dropped; the snapshot below replaces it. Restored
+			// progress replaces moves made while the file was being read.
+			const bool restored = read && saveGame.LevelHash == m_LevelHash && model.RestoreProgress(saveGame);
+			QueueSnapshot(JobType::OPEN, model);
+			return restored;
+		}
+
+		if (m_State != LevelState::SAVING || model.GetGridState().EditMode)
+		{
+			return false;
+		}
+
+		const Serialization::BoardData& board = model.GetBoard();
+		if (board.Numbers == m_QueuedBoard.Numbers && board.Guesses == m_QueuedBoard.Guesses)
+		{
+			return false;
+		}
+
+		m_QueuedBoard.Numbers = board.Numbers;
+		m_QueuedBoard.Guesses = board.Guesses;
+
+		Job job;
+		job.Type = JobType::APPEND;
+		job.LevelHash = m_LevelHash;
+		job.Board = board;
+		Push(std::move(job));
+		return false;
+	}
+
+	void ProgressStore::EndLevel(const GridModel& model)
+	{
+		if (m_State == LevelState::READING)
+		{
+			CancelRead();
+		}
+		else if (m_State == LevelState::SAVING)
+		{
+			if (model.GetGridState().EditMode)
+			{
+				Job job;
+				job.Type = JobType::CLOSE;
+				Push(std::move(job));
+			}
+			else
+			{
+				QueueSnapshot(JobType::CLOSE, model);
+			}
+		}
+
+		m_State = LevelState::IDLE;
+	}
+
+	void ProgressStore::Flush()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Idle.wait(lock, [this]() { return m_Jobs.empty() && !m_Busy; });
+	}
+
+	std::string ProgressStore::GetSavePath(const std::string& levelName) const
+	{
+		return m_DirectoryPath + levelName + Serialization::SAVE_GAME_EXTENSION;
+	}
+
+	void ProgressStore::QueueSnapshot(JobType type, const GridModel& model)
+	{
+		Job job;
+		job.Type = type;
+		job.Path = m_SavePath;
+		job.LevelHash = m_LevelHash;
+		job.Board = model.GetBoard();
+		model.GetJournal().CopyEntries(job.Journal, job.UndoCount);
+
+		m_QueuedBoard.Numbers = job.Board.Numbers;
+		m_QueuedBoard.Guesses = job.Board.Guesses;
+		Push(std::move(job));
+	}
+
+	void ProgressStore::Push(Job&& job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Jobs.push_back(std::move(job));
+
+			if (!m_Worker.joinable())
+			{
+				m_Stopping = false;
+				m_Worker = std::thread(&ProgressStore::WorkerLoop, this);
+			}
+		}
+
+		m_WakeWorker.notify_one();
+	}
+
+	void ProgressStore::CancelRead()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Generation++;
+		m_ReadDone = false;
+	}
+
+	void ProgressStore::WorkerLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		while (true)
+		{
+			m_WakeWorker.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+			if (m_Jobs.empty())
+			{
+				break;
+			}
+
+			Job job = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+
+			if (job.Type == JobType::READ && job.Generation != m_Generation)
+			{
+				continue;
+			}
+
+			m_Busy = true;
+			lock.unlock();
+
+			const bool succeeded = RunJob(job);
+
+			lock.lock();
+			m_Busy = false;
+
+			if (job.Type == JobType::READ && job.Generation == m_Generation)
+			{
+				m_ReadSucceeded = succeeded;
+				std::swap(m_ReadSaveGame, m_Snapshot);
+				m_ReadDone = true;
+			}
+
+			if (m_Jobs.empty())
+			{
+				m_Idle.notify_all();
+			}
+		}
+
+		m_Busy = false;
+		m_Idle.notify_all();
+	}
+
+	bool ProgressStore::RunJob(const Job& job)
+	{
+		switch (job.Type)
+		{
+		case JobType::READ:
+			return Serialization::ReadSaveGame(job.Path, m_Snapshot);
+
+		case JobType::OPEN:
+			return m_Writer.Open(job.Path, TakeSnapshot(job, true));
+
+		case JobType::APPEND:
+			m_Writer.Append(job.Board);
+
+			// Moves queued meanwhile are appended to the new file once it has been renamed over the old one.
+			// The undo history is left out, as the records after it would drop it on reading anyway.
+			if (m_Writer.NeedsCompaction())
+			{
+				return m_Writer.Open(m_Writer.GetPath(), TakeSnapshot(job, false));
+			}
+			return m_Writer.IsOpen();
+
+		case JobType::CLOSE:
+		{
+			const bool written = m_Writer.IsOpen() && job.Board.GridSize != 0 && m_Writer.Open(job.Path, TakeSnapshot(job, true));
+			m_Writer.Close();
+			return written;
+		}
+		}
+
+		return false;
+	}
+
+	const Serialization::SaveGameData& ProgressStore::TakeSnapshot(const Job& job, bool withJournal)
+	{
+		m_Snapshot.GridSize = job.Board.GridSize;
+		m_Snapshot.LevelHash = job.LevelHash;
+		m_Snapshot.Numbers = job.Board.Numbers;
+		m_Snapshot.Guesses = job.Board.Guesses;
+
+		m_Snapshot.Journal.clear();
+		if (withJournal)
+		{
+			MoveJournal::EncodeEntries(job.Board.GridSize, job.Journal, job.UndoCount, m_Snapshot.Journal);
+		}
+
+		return m_Snapshot;
+	}
+
+	void ProgressStore::Stop()
+	{
+		// Queued writes are finished first; a pending read is not needed any more.
+		CancelRead();
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Stopping = true;
+		}
+
+		m_WakeWorker.notify_all();
+		if (m_Worker.joinable())
+		{
+			m_Worker.join();
+		}
+	}
+}
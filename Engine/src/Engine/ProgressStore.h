@@ -0,0 +1,116 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Serialization/LevelData.h"
+#include "Serialization/BoardData.h"
+#include "Serialization/SaveGame.h"
+#include "GridModel.h"
+#include "MoveJournal.h"
+
+namespace Engine
+{
+	// Keeps the player's progress on each level in "<directory><level name>.save". Every frame with a
+	// move appends the changed cells to the open file; the file is rewritten with the undo history
+	// when the level is left. All reads and writes happen on a writer thread, in the order they were
+	// asked for, so the calling thread only copies the board.
+	class ProgressStore
+	{
+	public:
+		ProgressStore() = default;
+		~ProgressStore();
+
+		ProgressStore(const ProgressStore&) = delete;
+		ProgressStore& operator=(const ProgressStore&) = delete;
+
+		// Creates the directory. Nothing is read or written before this is called.
+		bool Open(const std::string& directoryPath);
+		bool IsOpen() const;
+
+		// Starts reading the progress saved for this version of the level. Update restores it once it
+		// has been read, and starts saving.
+		void BeginLevel(const std::string& levelName, const Serialization::LevelData& levelData);
+
+		// Restores the progress once it has been read, and afterwards queues the moves made since the
+		// last call. Cheap enough to call every frame. Returns true on the call that restored progress.
+		bool Update(GridModel& model);
+
+		// Queues the board with its undo history and stops saving, e.g. before another level is loaded.
+		// Progress that was not read yet is left as it is on disk.
+		void EndLevel(const GridModel& model);
+
+		// Blocks until everything queued is on disk.
+		void Flush();
+
+		std::string GetSavePath(const std::string& levelName) const;
+
+	private:
+		enum class JobType : uint8_t
+		{
+			READ,   // Reads the save game at Path
+			OPEN,   // Writes a snapshot of Board with the journal to Path and keeps it open for appending
+			APPEND, // Appends the cells of Board that changed, and compacts the file when it is due
+			CLOSE   // Writes a snapshot like OPEN when Board is set, then closes the file
+		};
+
+		struct Job
+		{
+			JobType Type = JobType::READ;
+			std::string Path;
+			uint32_t LevelHash = 0;
+			Serialization::BoardData Board;
+			std::vector<JournalEntry> Journal;
+			size_t UndoCount = 0;
+			size_t Generation = 0;
+		};
+
+		enum class LevelState : uint8_t
+		{
+			IDLE,
+			READING,
+			SAVING
+		};
+
+		void QueueSnapshot(JobType type, const GridModel& model);
+		void Push(Job&& job);
+		void CancelRead();
+
+		void WorkerLoop();
+		bool RunJob(const Job& job);
+		const Serialization::SaveGameData& TakeSnapshot(const Job& job, bool withJournal);
+		void Stop();
+
+	private:
+		std::string m_DirectoryPath;
+
+		// Calling thread.
+		LevelState m_State = LevelState::IDLE;
+		std::string m_SavePath;
+		uint32_t m_LevelHash = 0;
+		Serialization::BoardData m_QueuedBoard; // As of the last queued job
+
+		// Writer thread.
+		Serialization::SaveGameWriter m_Writer;
+		Serialization::SaveGameData m_Snapshot;
+
+		// Shared, under m_Mutex. Reads queued before the generation changed are dropped.
+		std::deque<Job> m_Jobs;
+		bool m_Busy = false;
+		size_t m_Generation = 0;
+		bool m_ReadDone = false;
+		bool m_ReadSucceeded = false;
+		Serialization::SaveGameData m_ReadSaveGame;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_WakeWorker;
+		std::condition_variable m_Idle;
+		std::thread m_Worker;
+		bool m_Stopping = false;
+	};
+}
@@ -1,27 +1,29 @@
+#include <string>
+#include <vector>
 #include "Engine/Application.h"
 
-#ifdef BUILD_DEBUG
+#if defined(BUILD_RELEASE) && defined(_WIN32)
 
-int main(int argc, char* argv[])
-
-#elif BUILD_RELEASE
-
-#if defined(_WIN32)           
 #define NOGDI             // All GDI defines and routines
 #define NOUSER            // All USER defines and routines
-#endif
 
 #include <Windows.h> // or any library that uses Windows.h
 
-#if defined(_WIN32)           // raylib uses these names as function parameters
-#undef near
+#undef near               // raylib uses these names as function parameters
 #undef far
-#endif
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, char* pCmdLine, int nCmdShow)
-#endif 
+{
+	const int argc = __argc;
+	char** argv = __argv;
+
+#else
 
+int main(int argc, char* argv[])
 {
+
+#endif
+
 	Engine::ApplicationProps props{
 		1280,
 		720,
@@ -29,6 +31,27 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, char* pCmdLine,
 	};
 
 	Engine::Application app(props);
+
+	// --headless <command> [args...] runs the game logic without opening a window.
+	if (argc > 1 && std::string(argv[1]) == "--headless")
+	{
+		return app.RunHeadless(std::vector<std::string>(argv + 2, argv + argc));
+	}
+
+	// --record <file> writes the session's input to a file, --replay <file> plays one back.
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const std::string option(argv[i]);
+		if (option == "--record" && !app.StartRecording(argv[i + 1]))
+		{
+			return 1;
+		}
+		else if (option == "--replay" && !app.StartPlayback(argv[i + 1]))
+		{
+			return 1;
+		}
+	}
+
 	app.Run();
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,269 @@
+#include "BinaryFormat.h"
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+
+namespace Serialization
+{
+	static const uint8_t BINARY_LEVEL_MAGIC[4] = { 'F', 'U', 'T', 'L' };
+
+	static const uint8_t EDGE_NONE = 0;
+	static const uint8_t EDGE_GREATER = 1;
+	static const uint8_t EDGE_SMALLER = 2;
+
+	static const uint8_t RIGHT_EDGE_SHIFT = 0;
+	static const uint8_t DOWN_EDGE_SHIFT = 2;
+
+	static void SetEdge(uint8_t& edges, uint8_t shift, uint8_t edge)
+	{
+		edges = (edges & ~(3u << shift)) | (edge << shift);
+	}
+
+	static bool AddEdgeConstraint(LevelData& levelData, uint8_t x, uint8_t y, uint8_t dx, uint8_t dy, uint8_t edge)
+	{
+		if (edge == EDGE_NONE)
+		{
+			return true;
+		}
+
+		if (edge != EDGE_GREATER && edge != EDGE_SMALLER)
+		{
+			return false;
+		}
+
+		if (x + dx >= levelData.GridSize || y + dy >= levelData.GridSize)
+		{
+			return false;
+		}
+
+		GreaterThanConstraint& constraint = levelData.GreaterThanConstraints.emplace_back();
+		if (edge == EDGE_GREATER)
+		{
+			constraint = GreaterThanConstraint{ x, y, (uint8_t)(x + dx), (uint8_t)(y + dy) };
+		}
+		else
+		{
+			constraint = GreaterThanConstraint{ (uint8_t)(x + dx), (uint8_t)(y + dy), x, y };
+		}
+
+		return true;
+	}
+
+	size_t GetBinaryLevelSize(uint8_t gridSize, size_t lockedCount)
+	{
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		return BINARY_LEVEL_HEADER_SIZE
+			+ (cellCount + 7) / 8
+			+ (lockedCount + 1) / 2
+			+ (cellCount + 1) / 2;
+	}
+
+	bool EncodeBinaryLevel(const LevelData& levelData, std::vector<uint8_t>& outBytes)
+	{
+		const uint8_t gridSize = levelData.GridSize;
+		if (gridSize == 0 || gridSize > BINARY_LEVEL_MAX_GRID_SIZE)
+		{
+			return false;
+		}
+
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		uint8_t values[BINARY_LEVEL_MAX_GRID_SIZE * BINARY_LEVEL_MAX_GRID_SIZE] = { 0 };
+		uint8_t edges[BINARY_LEVEL_MAX_GRID_SIZE * BINARY_LEVEL_MAX_GRID_SIZE] = { 0 };
+
+		// Later entries for the same cell win, as they do when the grid loads the level.
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (lockedCell.X >= gridSize || lockedCell.Y >= gridSize || lockedCell.Val == 0 || lockedCell.Val > gridSize)
+			{
+				return false;
+			}
+
+			values[lockedCell.Y * gridSize + lockedCell.X] = lockedCell.Val;
+		}
+
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			if (constraint.X1 >= gridSize || constraint.Y1 >= gridSize || constraint.X2 >= gridSize || constraint.Y2 >= gridSize)
+			{
+				return false;
+			}
+
+			const size_t cell1 = constraint.Y1 * gridSize + constraint.X1;
+			const size_t cell2 = constraint.Y2 * gridSize + constraint.X2;
+
+			if (constraint.Y1 == constraint.Y2 && constraint.X2 == constraint.X1 + 1)
+			{
+				SetEdge(edges[cell1], RIGHT_EDGE_SHIFT, EDGE_GREATER);
+			}
+			else if (constraint.Y1 == constraint.Y2 && constraint.X1 == constraint.X2 + 1)
+			{
+				SetEdge(edges[cell2], RIGHT_EDGE_SHIFT, EDGE_SMALLER);
+			}
+			else if (constraint.X1 == constraint.X2 && constraint.Y2 == constraint.Y1 + 1)
+			{
+				SetEdge(edges[cell1], DOWN_EDGE_SHIFT, EDGE_GREATER);
+			}
+			else if (constraint.X1 == constraint.X2 && constraint.Y1 == constraint.Y2 + 1)
+			{
+				SetEdge(edges[cell2], DOWN_EDGE_SHIFT, EDGE_SMALLER);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		size_t lockedCount = 0;
+		for (size_t i = 0; i < cellCount; ++i)
+		{
+			lockedCount += values[i] != 0;
+		}
+
+		const size_t start = outBytes.size();
+		outBytes.resize(start + GetBinaryLevelSize(gridSize, lockedCount), 0);
+
+		uint8_t* header = outBytes.data() + start;
+		std::copy(std::begin(BINARY_LEVEL_MAGIC), std::end(BINARY_LEVEL_MAGIC), header);
+		header[4] = BINARY_LEVEL_VERSION;
+		header[5] = gridSize;
+		header[6] = (uint8_t)(lockedCount & 0xFF);
+		header[7] = (uint8_t)(lockedCount >> 8);
+
+		uint8_t* lockedMask = header + BINARY_LEVEL_HEADER_SIZE;
+		uint8_t* lockedValues = lockedMask + (cellCount + 7) / 8;
+		uint8_t* edgeNibbles = lockedValues + (lockedCount + 1) / 2;
+
+		size_t lockedIndex = 0;
+		for (size_t i = 0; i < cellCount; ++i)
+		{
+			if (values[i])
+			{
+				lockedMask[i >> 3] |= 1u << (i & 7);
+				lockedValues[lockedIndex >> 1] |= (values[i] - 1) << ((lockedIndex & 1) * 4);
+				lockedIndex++;
+			}
+
+			edgeNibbles[i >> 1] |= edges[i] << ((i & 1) * 4);
+		}
+
+		return true;
+	}
+
+	static bool DecodeBinaryLevelInternal(const uint8_t* data, size_t size, LevelData& outLevelData)
+	{
+		if (size < BINARY_LEVEL_HEADER_SIZE
+			|| !std::equal(std::begin(BINARY_LEVEL_MAGIC), std::end(BINARY_LEVEL_MAGIC), data)
+			|| data[4] != BINARY_LEVEL_VERSION)
+		{
+			return false;
+		}
+
+		const uint8_t gridSize = data[5];
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		const size_t lockedCount = data[6] | (data[7] << 8);
+
+		if (gridSize == 0 || gridSize > BINARY_LEVEL_MAX_GRID_SIZE
+			|| lockedCount > cellCount
+			|| size < GetBinaryLevelSize(gridSize, lockedCount))
+		{
+			return false;
+		}
+
+		outLevelData.GridSize = gridSize;
+
+		const uint8_t* lockedMask = data + BINARY_LEVEL_HEADER_SIZE;
+		const uint8_t* lockedValues = lockedMask + (cellCount + 7) / 8;
+		const uint8_t* edgeNibbles = lockedValues + (lockedCount + 1) / 2;
+
+		size_t lockedIndex = 0;
+		for (size_t i = 0; i < cellCount; ++i)
+		{
+			if (!(lockedMask[i >> 3] & (1u << (i & 7))))
+			{
+				continue;
+			}
+
+			if (lockedIndex == lockedCount)
+			{
+				return false;
+			}
+
+			const uint8_t value = ((lockedValues[lockedIndex >> 1] >> ((lockedIndex & 1) * 4)) & 0xF) + 1;
+			if (value > gridSize)
+			{
+				return false;
+			}
+
+			outLevelData.LockedCells.push_back(LockedNumber{ (uint8_t)(i % gridSize), (uint8_t)(i / gridSize), value });
+			lockedIndex++;
+		}
+
+		if (lockedIndex != lockedCount)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < cellCount; ++i)
+		{
+			const uint8_t edges = (edgeNibbles[i >> 1] >> ((i & 1) * 4)) & 0xF;
+			const uint8_t x = (uint8_t)(i % gridSize);
+			const uint8_t y = (uint8_t)(i / gridSize);
+
+			if (!AddEdgeConstraint(outLevelData, x, y, 1, 0, (edges >> RIGHT_EDGE_SHIFT) & 3)
+				|| !AddEdgeConstraint(outLevelData, x, y, 0, 1, (edges >> DOWN_EDGE_SHIFT) & 3))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool DecodeBinaryLevel(const uint8_t* data, size_t size, LevelData& outLevelData)
+	{
+		outLevelData.GridSize = 0;
+		outLevelData.LockedCells.clear();
+		outLevelData.GreaterThanConstraints.clear();
+
+		if (!DecodeBinaryLevelInternal(data, size, outLevelData))
+		{
+			outLevelData.GridSize = 0;
+			return false;
+		}
+
+		return true;
+	}
+
+	LevelData ParseBinary(const std::string& filepath)
+	{
+		std::ifstream file(filepath, std::ifstream::binary);
+		if (!file.is_open())
+		{
+			return LevelData();
+		}
+
+		const std::vector<uint8_t> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+		LevelData data;
+		DecodeBinaryLevel(bytes.data(), bytes.size(), data);
+		return data;
+	}
+
+	bool WriteBinary(const LevelData& levelData, const std::string& filepath)
+	{
+		std::vector<uint8_t> bytes;
+		if (!EncodeBinaryLevel(levelData, bytes))
+		{
+			return false;
+		}
+
+		std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write((const char*)bytes.data(), bytes.size());
+		return file.good();
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "LevelData.h"
+
+namespace Serialization
+{
+	// Binary level layout (all multi-byte values little endian):
+	//   0  char[4]  "FUTL"
+	//   4  uint8    version
+	//   5  uint8    grid size (1-16)
+	//   6  uint16   locked cell count
+	//   8  locked mask, one bit per cell in row-major order
+	//      locked values, one nibble (value - 1) per locked cell, low nibble first
+	//      constraint edges, one nibble per cell: bits 0-1 right edge, bits 2-3 down edge
+	// An edge is 0 when unconstrained, 1 when the cell is greater than its neighbour and 2 when it is smaller.
+	static const uint8_t BINARY_LEVEL_VERSION = 1;
+	static const uint8_t BINARY_LEVEL_MAX_GRID_SIZE = 16;
+	static const size_t BINARY_LEVEL_HEADER_SIZE = 8;
+
+	static const char* const TEXT_LEVEL_EXTENSION = ".data";
+	static const char* const BINARY_LEVEL_EXTENSION = ".lvl";
+
+	size_t GetBinaryLevelSize(uint8_t gridSize, size_t lockedCount);
+
+	// Appends the encoded level to outBytes. Fails for levels the format cannot represent:
+	// cells out of the grid, values outside 1-16 and constraints between non-orthogonal neighbours.
+	bool EncodeBinaryLevel(const LevelData& levelData, std::vector<uint8_t>& outBytes);
+
+	// Reuses the capacity of outLevelData. Locked cells come out in row-major order and
+	// constraints as right edges before down edges, cell by cell.
+	bool DecodeBinaryLevel(const uint8_t* data, size_t size, LevelData& outLevelData);
+
+	LevelData ParseBinary(const std::string& filepath);
+	bool WriteBinary(const LevelData& levelData, const std::string& filepath);
+}
@@ -0,0 +1,79 @@
+#include "BoardData.h"
+#include <algorithm>
+
+namespace Serialization
+{
+	void BoardData::Resize(uint8_t gridSize)
+	{
+		GridSize = std::min(gridSize, MAX_GRID_SIZE);
+		Numbers.assign(GetCellCount(), 0);
+		Guesses.assign(GetCellCount(), 0);
+		LockedRows.fill(0);
+	}
+
+	void BoardData::Clear()
+	{
+		std::fill(Numbers.begin(), Numbers.end(), 0);
+		std::fill(Guesses.begin(), Guesses.end(), 0);
+		LockedRows.fill(0);
+	}
+
+	void BoardData::SetLocked(uint8_t x, uint8_t y, bool locked)
+	{
+		const uint16_t bit = (uint16_t)(1u << x);
+		LockedRows[y] = locked ? (uint16_t)(LockedRows[y] | bit) : (uint16_t)(LockedRows[y] & ~bit);
+	}
+
+	size_t BoardData::GetLockedCount() const
+	{
+		size_t lockedCount = 0;
+		for (uint8_t y = 0; y < GridSize; ++y)
+		{
+			for (uint16_t row = LockedRows[y]; row; row &= row - 1)
+			{
+				lockedCount++;
+			}
+		}
+		return lockedCount;
+	}
+
+	bool LoadLockedCells(const LevelData& levelData, BoardData& outBoard)
+	{
+		if (levelData.GridSize > BoardData::MAX_GRID_SIZE)
+		{
+			outBoard.Resize(0);
+			return false;
+		}
+
+		outBoard.Resize(levelData.GridSize);
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (lockedCell.X >= outBoard.GridSize || lockedCell.Y >= outBoard.GridSize)
+			{
+				outBoard.Clear();
+				return false;
+			}
+
+			outBoard.Numbers[outBoard.GetIndex(lockedCell.X, lockedCell.Y)] = lockedCell.Val;
+			outBoard.SetLocked(lockedCell.X, lockedCell.Y, true);
+		}
+
+		return true;
+	}
+
+	void StoreLockedCells(const BoardData& board, std::vector<LockedNumber>& outLockedCells)
+	{
+		for (uint8_t y = 0; y < board.GridSize; ++y)
+		{
+			for (uint16_t row = board.LockedRows[y]; row; row &= row - 1)
+			{
+				uint8_t x = 0;
+				while (!((row >> x) & 1))
+				{
+					x++;
+				}
+				outLockedCells.push_back(LockedNumber{ x, y, board.GetNumber(x, y) });
+			}
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <array>
+#include "LevelData.h"
+
+namespace Serialization
+{
+	// Cell state of a board as structure of arrays, so that a scan only pulls in the array it reads:
+	// validation touches Numbers alone, one byte per cell.
+	struct BoardData
+	{
+		static const uint8_t MAX_GRID_SIZE = 16;
+
+		uint8_t GridSize = 0;
+		std::vector<uint8_t> Numbers;                       // Row major, 0 when empty
+		std::vector<uint16_t> Guesses;                      // Row major, digit n is bit (n - 1)
+		std::array<uint16_t, MAX_GRID_SIZE> LockedRows{};   // Bit x of LockedRows[y] is set when the cell is locked
+
+		// Empties every cell.
+		void Resize(uint8_t gridSize);
+		void Clear();
+
+		size_t GetCellCount() const { return (size_t)GridSize * GridSize; }
+		size_t GetIndex(uint8_t x, uint8_t y) const { return (size_t)y * GridSize + x; }
+
+		uint8_t GetNumber(uint8_t x, uint8_t y) const { return Numbers[GetIndex(x, y)]; }
+		bool IsLocked(uint8_t x, uint8_t y) const { return (LockedRows[y] >> x) & 1; }
+		void SetLocked(uint8_t x, uint8_t y, bool locked);
+		size_t GetLockedCount() const;
+	};
+
+	// Board holding the level's locked cells. Fails, leaving the board empty, on cells outside the grid.
+	bool LoadLockedCells(const LevelData& levelData, BoardData& outBoard);
+
+	// Appends the locked cells in row-major order.
+	void StoreLockedCells(const BoardData& board, std::vector<LockedNumber>& outLockedCells);
+}
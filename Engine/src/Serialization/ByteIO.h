@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Serialization
+{
+	// Little-endian reads and writes for the binary formats, independent of the host byte order.
+	inline void WriteUInt16(uint8_t* dest, uint16_t value)
+	{
+		dest[0] = (uint8_t)(value);
+		dest[1] = (uint8_t)(value >> 8);
+	}
+
+	inline void WriteUInt32(uint8_t* dest, uint32_t value)
+	{
+		dest[0] = (uint8_t)(value);
+		dest[1] = (uint8_t)(value >> 8);
+		dest[2] = (uint8_t)(value >> 16);
+		dest[3] = (uint8_t)(value >> 24);
+	}
+
+	inline uint16_t ReadUInt16(const uint8_t* src)
+	{
+		return (uint16_t)(src[0] | (src[1] << 8));
+	}
+
+	inline uint32_t ReadUInt32(const uint8_t* src)
+	{
+		return (uint32_t)src[0]
+			| ((uint32_t)src[1] << 8)
+			| ((uint32_t)src[2] << 16)
+			| ((uint32_t)src[3] << 24);
+	}
+
+	static const uint32_t FNV_OFFSET_BASIS = 2166136261u;
+
+	// FNV-1a. Pass the previous result as hash to continue over more bytes.
+	inline uint32_t HashBytes(const void* data, size_t size, uint32_t hash = FNV_OFFSET_BASIS)
+	{
+		const uint8_t* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+}
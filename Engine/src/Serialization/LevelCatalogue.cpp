@@ -0,0 +1,402 @@
+#include "LevelCatalogue.h"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+#include <string.h>
+
+#include "BinaryFormat.h"
+#include "ByteIO.h"
+
+namespace Serialization
+{
+	namespace fs = std::filesystem;
+
+	static const char INDEX_MAGIC[4] = { 'F', 'U', 'T', 'C' };
+	static const uint32_t INDEX_VERSION = 1;
+
+	// Techniques, Difficulty and Rating.
+	static const size_t RATING_FIELDS_OFFSET = offsetof(CatalogueRecord, Techniques);
+	static const size_t RATING_FIELDS_SIZE = offsetof(CatalogueRecord, Reserved) - RATING_FIELDS_OFFSET;
+
+	static int64_t GetModifiedTime(const std::string& path)
+	{
+		std::error_code error;
+		const fs::file_time_type time = fs::last_write_time(path, error);
+		return error ? 0 : (int64_t)time.time_since_epoch().count();
+	}
+
+	// Shorter names first, so that Level999 comes before Level1000.
+	static bool CompareRecords(const CatalogueRecord& a, const CatalogueRecord& b)
+	{
+		const size_t lengthA = strlen(a.Name);
+		const size_t lengthB = strlen(b.Name);
+		return lengthA != lengthB ? lengthA < lengthB : strcmp(a.Name, b.Name) < 0;
+	}
+
+	bool LevelCatalogue::Open(const std::string& directoryPath)
+	{
+		Close();
+		m_DirectoryPath = directoryPath;
+
+		if (MapIndex() && IsIndexCurrent())
+		{
+			return true;
+		}
+
+		return Rescan();
+	}
+
+	void LevelCatalogue::Close()
+	{
+		m_Index.Close();
+	}
+
+	size_t LevelCatalogue::GetLevelCount() const
+	{
+		const IndexHeader* header = GetHeader();
+		return header ? header->LevelCount : 0;
+	}
+
+	const CatalogueRecord& LevelCatalogue::GetRecord(size_t levelIndex) const
+	{
+		const CatalogueRecord* records = (const CatalogueRecord*)(m_Index.GetData() + sizeof(IndexHeader));
+		return records[levelIndex];
+	}
+
+	const char* LevelCatalogue::GetLevelName(size_t levelIndex) const
+	{
+		if (levelIndex >= GetLevelCount())
+		{
+			return "";
+		}
+
+		const CatalogueRecord& record = GetRecord(levelIndex);
+		return record.Name[MAX_NAME_LENGTH] == '\0' ? record.Name : "";
+	}
+
+	std::string LevelCatalogue::GetLevelPath(size_t levelIndex) const
+	{
+		return m_DirectoryPath + GetLevelName(levelIndex) + TEXT_LEVEL_EXTENSION;
+	}
+
+	size_t LevelCatalogue::FindLevel(const std::string& levelName) const
+	{
+		const size_t levelCount = GetLevelCount();
+		for (size_t i = 0; i < levelCount; ++i)
+		{
+			if (levelName == GetLevelName(i))
+			{
+				return i;
+			}
+		}
+
+		return levelCount;
+	}
+
+	bool LevelCatalogue::LoadLevel(size_t levelIndex, LevelData& outLevelData, ParseError* outError)
+	{
+		if (levelIndex >= GetLevelCount())
+		{
+			if (outError)
+			{
+				*outError = ParseError{ 0, 0, "no such level" };
+			}
+			outLevelData = LevelData();
+			return false;
+		}
+
+		// Copied, the record is remapped if it has to be refreshed.
+		const CatalogueRecord record = GetRecord(levelIndex);
+
+		CatalogueRecord currentRecord;
+		if (!IndexLevelFile(GetLevelName(levelIndex), currentRecord, &outLevelData, outError))
+		{
+			return false;
+		}
+
+		if (currentRecord.FileSize != record.FileSize
+			|| currentRecord.Checksum != record.Checksum
+			|| currentRecord.ModifiedTime != record.ModifiedTime
+			|| currentRecord.GridSize != record.GridSize)
+		{
+			WriteRecord(levelIndex, currentRecord);
+		}
+
+		return outLevelData.GridSize != 0;
+	}
+
+	bool LevelCatalogue::SaveLevel(const std::string& levelName, const LevelData& levelData, size_t& outLevelIndex)
+	{
+		if (levelName.empty() || levelName.size() > MAX_NAME_LENGTH)
+		{
+			return false;
+		}
+
+		if (!Write(levelData, m_DirectoryPath + levelName + TEXT_LEVEL_EXTENSION))
+		{
+			return false;
+		}
+
+		CatalogueRecord record;
+		if (!IndexLevelFile(levelName, record))
+		{
+			return false;
+		}
+
+		outLevelIndex = FindLevel(levelName);
+		return WriteRecord(outLevelIndex, record);
+	}
+
+	bool LevelCatalogue::StoreRatings(const std::vector<CatalogueRating>& ratings)
+	{
+		const size_t levelCount = GetLevelCount();
+		for (const CatalogueRating& rating : ratings)
+		{
+			if (rating.LevelIndex >= levelCount)
+			{
+				return false;
+			}
+		}
+
+		m_Index.Close();
+
+		{
+			std::fstream file(GetIndexPath(), std::fstream::in | std::fstream::out | std::fstream::binary);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			// Only the rating fields are written; they follow each other in the record.
+			for (const CatalogueRating& rating : ratings)
+			{
+				CatalogueRecord record{};
+				record.Techniques = rating.Techniques;
+				record.Difficulty = rating.Difficulty;
+				record.Rating = rating.Rating;
+
+				file.seekp(sizeof(IndexHeader) + rating.LevelIndex * sizeof(CatalogueRecord) + RATING_FIELDS_OFFSET);
+				file.write((const char*)&record + RATING_FIELDS_OFFSET, RATING_FIELDS_SIZE);
+			}
+
+			if (!file.good())
+			{
+				return false;
+			}
+		}
+
+		return MapIndex();
+	}
+
+	size_t LevelCatalogue::GetRescanCount() const
+	{
+		return m_RescanCount;
+	}
+
+	const LevelCatalogue::IndexHeader* LevelCatalogue::GetHeader() const
+	{
+		return m_Index.IsOpen() ? (const IndexHeader*)m_Index.GetData() : nullptr;
+	}
+
+	std::string LevelCatalogue::GetIndexPath() const
+	{
+		return m_DirectoryPath + INDEX_FILENAME;
+	}
+
+	bool LevelCatalogue::MapIndex()
+	{
+		if (!m_Index.Open(GetIndexPath()))
+		{
+			return false;
+		}
+
+		const IndexHeader* header = GetHeader();
+		if (m_Index.GetSize() < sizeof(IndexHeader)
+			|| !std::equal(std::begin(INDEX_MAGIC), std::end(INDEX_MAGIC), header->Magic)
+			|| header->Version != INDEX_VERSION
+			|| (m_Index.GetSize() - sizeof(IndexHeader)) / sizeof(CatalogueRecord) < header->LevelCount)
+		{
+			m_Index.Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool LevelCatalogue::IsIndexCurrent() const
+	{
+		const IndexHeader* header = GetHeader();
+		return header && header->DirectoryTime == GetModifiedTime(m_DirectoryPath);
+	}
+
+	bool LevelCatalogue::Rescan()
+	{
+		m_RescanCount++;
+
+		// Records of files that have not changed are carried over without reading the file again.
+		std::unordered_map<std::string, CatalogueRecord> knownRecords;
+		for (size_t i = 0; i < GetLevelCount(); ++i)
+		{
+			knownRecords.emplace(GetLevelName(i), GetRecord(i));
+		}
+		m_Index.Close();
+
+		std::error_code error;
+		fs::directory_iterator directory(m_DirectoryPath, error);
+		if (error)
+		{
+			return false;
+		}
+
+		std::vector<CatalogueRecord> records;
+		for (const auto& entry : directory)
+		{
+			if (!entry.is_regular_file(error) || entry.path().extension().string() != TEXT_LEVEL_EXTENSION)
+			{
+				continue;
+			}
+
+			const std::string levelName = entry.path().stem().string();
+			if (levelName.size() > MAX_NAME_LENGTH)
+			{
+				continue;
+			}
+
+			const auto known = knownRecords.find(levelName);
+			if (known != knownRecords.end()
+				&& known->second.FileSize == entry.file_size(error)
+				&& known->second.ModifiedTime == GetModifiedTime(entry.path().string()))
+			{
+				records.push_back(known->second);
+				continue;
+			}
+
+			CatalogueRecord& record = records.emplace_back();
+			if (!IndexLevelFile(levelName, record))
+			{
+				records.pop_back();
+			}
+		}
+
+		std::sort(records.begin(), records.end(), CompareRecords);
+		return WriteIndex(records);
+	}
+
+	bool LevelCatalogue::WriteIndex(const std::vector<CatalogueRecord>& records)
+	{
+		m_Index.Close();
+
+		IndexHeader header{};
+		std::copy(std::begin(INDEX_MAGIC), std::end(INDEX_MAGIC), header.Magic);
+		header.Version = INDEX_VERSION;
+		header.LevelCount = (uint32_t)records.size();
+
+		{
+			std::ofstream file(GetIndexPath(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			file.write((const char*)&header, sizeof(header));
+			file.write((const char*)records.data(), records.size() * sizeof(CatalogueRecord));
+			if (!file.good())
+			{
+				return false;
+			}
+		}
+
+		// Creating the index changes the directory time, so it is recorded afterwards.
+		return WriteDirectoryTime() && MapIndex();
+	}
+
+	bool LevelCatalogue::WriteRecord(size_t levelIndex, const CatalogueRecord& record)
+	{
+		const size_t levelCount = GetLevelCount();
+		if (levelIndex > levelCount)
+		{
+			return false;
+		}
+
+		m_Index.Close();
+
+		{
+			std::fstream file(GetIndexPath(), std::fstream::in | std::fstream::out | std::fstream::binary);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			file.seekp(sizeof(IndexHeader) + levelIndex * sizeof(CatalogueRecord));
+			file.write((const char*)&record, sizeof(record));
+
+			if (levelIndex == levelCount)
+			{
+				const uint32_t newLevelCount = (uint32_t)(levelCount + 1);
+				file.seekp(offsetof(IndexHeader, LevelCount));
+				file.write((const char*)&newLevelCount, sizeof(newLevelCount));
+			}
+
+			if (!file.good())
+			{
+				return false;
+			}
+		}
+
+		// A new level file changed the directory time; the index already knows about it.
+		return WriteDirectoryTime() && MapIndex();
+	}
+
+	bool LevelCatalogue::WriteDirectoryTime()
+	{
+		const int64_t directoryTime = GetModifiedTime(m_DirectoryPath);
+
+		std::fstream file(GetIndexPath(), std::fstream::in | std::fstream::out | std::fstream::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.seekp(offsetof(IndexHeader, DirectoryTime));
+		file.write((const char*)&directoryTime, sizeof(directoryTime));
+		return file.good();
+	}
+
+	bool LevelCatalogue::IndexLevelFile(const std::string& levelName, CatalogueRecord& outRecord, LevelData* outLevelData,
+		ParseError* outError) const
+	{
+		thread_local std::vector<char> buffer;
+		thread_local LevelData scratchLevelData;
+
+		LevelData& levelData = outLevelData ? *outLevelData : scratchLevelData;
+		const std::string path = m_DirectoryPath + levelName + TEXT_LEVEL_EXTENSION;
+
+		std::ifstream file(path, std::ifstream::binary | std::ifstream::ate);
+		if (!file.is_open())
+		{
+			levelData = LevelData();
+			if (outError)
+			{
+				*outError = ParseError{ 0, 0, "could not open file" };
+			}
+			return false;
+		}
+
+		const std::streamoff size = file.tellg();
+		file.seekg(0);
+		buffer.resize((size_t)std::max<std::streamoff>(size, 0));
+		file.read(buffer.data(), buffer.size());
+		const size_t readSize = (size_t)file.gcount();
+
+		ParseBuffer(buffer.data(), readSize, levelData, outError);
+
+		outRecord = CatalogueRecord{};
+		levelName.copy(outRecord.Name, MAX_NAME_LENGTH);
+		outRecord.FileSize = (uint32_t)readSize;
+		outRecord.Checksum = HashBytes(buffer.data(), readSize);
+		outRecord.ModifiedTime = GetModifiedTime(path);
+		outRecord.GridSize = levelData.GridSize;
+		return true;
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "LevelData.h"
+#include "Parser.h"
+#include "MappedFile.h"
+
+namespace Serialization
+{
+	enum class RatingState : uint8_t
+	{
+		UNRATED,  // Not tried yet, or the file changed since
+		RATED,
+		UNRATABLE // Malformed or without a solution; not tried again until the file changes
+	};
+
+	// One level in the catalogue index. Stored as-is in the index file (native byte order).
+	struct CatalogueRecord
+	{
+		char Name[40];
+		uint32_t FileSize;
+		uint32_t Checksum;
+		int64_t ModifiedTime;
+		uint8_t GridSize;
+		uint8_t Techniques;  // Difficulty rating, see Solver/DifficultyRater.h. Both are 0 until the level
+		uint16_t Difficulty; // is rated, and again once its file changes.
+		RatingState Rating;
+		uint8_t Reserved[3];
+	};
+
+	static_assert(sizeof(CatalogueRecord) == 64, "CatalogueRecord is stored on disk");
+
+	struct CatalogueRating
+	{
+		size_t LevelIndex;
+		uint16_t Difficulty;
+		uint8_t Techniques;
+		RatingState Rating = RatingState::RATED;
+	};
+
+	// Index of the .data levels in a directory, kept in "levels.index" next to them. The index is
+	// memory mapped, so opening a directory whose index is up to date costs the same for any number
+	// of levels. The directory is only rescanned when its modification time no longer matches the
+	// one recorded in the index, and level files are only parsed when a level is loaded.
+	class LevelCatalogue
+	{
+	public:
+		static constexpr const char* INDEX_FILENAME = "levels.index";
+		static const size_t MAX_NAME_LENGTH = sizeof(CatalogueRecord::Name) - 1;
+
+		bool Open(const std::string& directoryPath);
+		void Close();
+
+		size_t GetLevelCount() const;
+		const CatalogueRecord& GetRecord(size_t levelIndex) const;
+		const char* GetLevelName(size_t levelIndex) const;
+		std::string GetLevelPath(size_t levelIndex) const;
+
+		// Returns the index of the level, or GetLevelCount() when there is none with that name.
+		size_t FindLevel(const std::string& levelName) const;
+
+		// Parses a level, refreshing its record first when the file changed since it was indexed.
+		bool LoadLevel(size_t levelIndex, LevelData& outLevelData, ParseError* outError = nullptr);
+
+		// Writes the level file and adds or updates its record.
+		bool SaveLevel(const std::string& levelName, const LevelData& levelData, size_t& outLevelIndex);
+
+		// Stores ratings in the records of the levels. Only their rating fields are written, in place.
+		bool StoreRatings(const std::vector<CatalogueRating>& ratings);
+
+		// Number of directory scans since the catalogue was created; 0 while the index stays warm.
+		size_t GetRescanCount() const;
+
+	private:
+		struct IndexHeader
+		{
+			char Magic[4];
+			uint32_t Version;
+			uint32_t LevelCount;
+			uint32_t Reserved;
+			int64_t DirectoryTime;
+		};
+
+		static_assert(sizeof(IndexHeader) == 24, "IndexHeader is stored on disk");
+
+		const IndexHeader* GetHeader() const;
+		std::string GetIndexPath() const;
+
+		bool MapIndex();
+		bool IsIndexCurrent() const;
+		bool Rescan();
+		bool WriteIndex(const std::vector<CatalogueRecord>& records);
+		bool WriteRecord(size_t levelIndex, const CatalogueRecord& record);
+		bool WriteDirectoryTime();
+
+		bool IndexLevelFile(const std::string& levelName, CatalogueRecord& outRecord, LevelData* outLevelData = nullptr,
+			ParseError* outError = nullptr) const;
+
+	private:
+		std::string m_DirectoryPath;
+		MappedFile m_Index;
+		size_t m_RescanCount = 0;
+	};
+}
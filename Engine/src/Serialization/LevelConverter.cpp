@@ -0,0 +1,112 @@
+#include "LevelConverter.h"
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+#include <fmt/core.h>
+
+#include "Parser.h"
+#include "BinaryFormat.h"
+#include "LevelPack.h"
+
+namespace Serialization
+{
+	namespace fs = std::filesystem;
+
+	static bool IsLevelFile(const fs::path& path)
+	{
+		const std::string extension = path.extension().string();
+		return extension == TEXT_LEVEL_EXTENSION || extension == BINARY_LEVEL_EXTENSION;
+	}
+
+	LevelData LoadLevelFile(const std::string& filepath)
+	{
+		if (fs::path(filepath).extension().string() == BINARY_LEVEL_EXTENSION)
+		{
+			return ParseBinary(filepath);
+		}
+
+		return Parse(filepath);
+	}
+
+	bool SaveLevelFile(const LevelData& levelData, const std::string& filepath)
+	{
+		if (fs::path(filepath).extension().string() == BINARY_LEVEL_EXTENSION)
+		{
+			return WriteBinary(levelData, filepath);
+		}
+
+		return Write(levelData, filepath);
+	}
+
+	static size_t PackDirectory(const std::string& directoryPath, const std::string& packPath)
+	{
+		std::vector<fs::path> levelFiles;
+		for (const auto& entry : fs::directory_iterator(directoryPath))
+		{
+			if (entry.is_regular_file() && IsLevelFile(entry.path()))
+			{
+				levelFiles.push_back(entry.path());
+			}
+		}
+
+		std::sort(levelFiles.begin(), levelFiles.end());
+
+		std::vector<LevelData> levels;
+		levels.reserve(levelFiles.size());
+		for (const auto& levelFile : levelFiles)
+		{
+			levels.push_back(LoadLevelFile(levelFile.string()));
+		}
+
+		return WriteLevelPack(levels, packPath) ? levels.size() : 0;
+	}
+
+	static size_t UnpackToDirectory(const std::string& packPath, const std::string& directoryPath)
+	{
+		LevelPack pack;
+		if (!pack.Open(packPath))
+		{
+			return 0;
+		}
+
+		std::error_code error;
+		fs::create_directories(directoryPath, error);
+
+		size_t written = 0;
+		LevelData levelData;
+		for (size_t i = 0; i < pack.GetLevelCount(); ++i)
+		{
+			const fs::path levelPath = fs::path(directoryPath) / fmt::format("Level{:03}{}", i + 1, TEXT_LEVEL_EXTENSION);
+			if (pack.ReadLevel(i, levelData) && Write(levelData, levelPath.string()))
+			{
+				written++;
+			}
+		}
+
+		return written;
+	}
+
+	size_t ConvertLevels(const std::string& inputPath, const std::string& outputPath)
+	{
+		const std::string outputExtension = fs::path(outputPath).extension().string();
+
+		if (fs::is_directory(inputPath))
+		{
+			return outputExtension == LEVEL_PACK_EXTENSION ? PackDirectory(inputPath, outputPath) : 0;
+		}
+
+		if (fs::path(inputPath).extension().string() == LEVEL_PACK_EXTENSION)
+		{
+			return UnpackToDirectory(inputPath, outputPath);
+		}
+
+		if (!IsLevelFile(inputPath) || !IsLevelFile(outputPath))
+		{
+			return 0;
+		}
+
+		const LevelData levelData = LoadLevelFile(inputPath);
+		return (levelData.GridSize && SaveLevelFile(levelData, outputPath)) ? 1 : 0;
+	}
+}
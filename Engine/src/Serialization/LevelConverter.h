@@ -0,0 +1,15 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include "LevelData.h"
+
+namespace Serialization
+{
+	// Reads or writes a text (.data) or binary (.lvl) level, chosen by the file extension.
+	LevelData LoadLevelFile(const std::string& filepath);
+	bool SaveLevelFile(const LevelData& levelData, const std::string& filepath);
+
+	// Converts a level between the text and binary formats, a directory of levels into a
+	// .pack, or a .pack into a directory of text levels. Returns the number of levels written.
+	size_t ConvertLevels(const std::string& inputPath, const std::string& outputPath);
+}
@@ -0,0 +1,124 @@
+#include "LevelPack.h"
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+
+#include "BinaryFormat.h"
+#include "ByteIO.h"
+
+namespace Serialization
+{
+	static const uint8_t LEVEL_PACK_MAGIC[4] = { 'F', 'U', 'T', 'P' };
+
+	bool WriteLevelPack(const std::vector<LevelData>& levels, const std::string& filepath)
+	{
+		const size_t dataStart = LEVEL_PACK_HEADER_SIZE + levels.size() * LEVEL_PACK_INDEX_ENTRY_SIZE;
+
+		std::vector<uint8_t> bytes(dataStart, 0);
+		std::copy(std::begin(LEVEL_PACK_MAGIC), std::end(LEVEL_PACK_MAGIC), bytes.data());
+		WriteUInt32(bytes.data() + 4, LEVEL_PACK_VERSION);
+		WriteUInt32(bytes.data() + 8, (uint32_t)levels.size());
+
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			const size_t offset = bytes.size();
+			if (!EncodeBinaryLevel(levels[i], bytes))
+			{
+				return false;
+			}
+
+			uint8_t* indexEntry = bytes.data() + LEVEL_PACK_HEADER_SIZE + i * LEVEL_PACK_INDEX_ENTRY_SIZE;
+			WriteUInt32(indexEntry, (uint32_t)offset);
+			WriteUInt32(indexEntry + 4, (uint32_t)(bytes.size() - offset));
+		}
+
+		std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write((const char*)bytes.data(), bytes.size());
+		return file.good();
+	}
+
+	bool LevelPack::Open(const std::string& filepath)
+	{
+		Close();
+
+		if (!m_File.Open(filepath))
+		{
+			return false;
+		}
+
+		const uint8_t* data = m_File.GetData();
+		const size_t size = m_File.GetSize();
+		if (size < LEVEL_PACK_HEADER_SIZE
+			|| !std::equal(std::begin(LEVEL_PACK_MAGIC), std::end(LEVEL_PACK_MAGIC), data)
+			|| ReadUInt32(data + 4) != LEVEL_PACK_VERSION)
+		{
+			Close();
+			return false;
+		}
+
+		const size_t levelCount = ReadUInt32(data + 8);
+		if ((size - LEVEL_PACK_HEADER_SIZE) / LEVEL_PACK_INDEX_ENTRY_SIZE < levelCount)
+		{
+			Close();
+			return false;
+		}
+
+		m_LevelCount = levelCount;
+		return true;
+	}
+
+	void LevelPack::Close()
+	{
+		m_File.Close();
+		m_LevelCount = 0;
+	}
+
+	bool LevelPack::IsOpen() const
+	{
+		return m_File.IsOpen();
+	}
+
+	size_t LevelPack::GetLevelCount() const
+	{
+		return m_LevelCount;
+	}
+
+	bool LevelPack::GetLevelBytes(size_t levelIndex, const uint8_t*& outData, size_t& outSize) const
+	{
+		if (levelIndex >= m_LevelCount)
+		{
+			return false;
+		}
+
+		const uint8_t* indexEntry = m_File.GetData() + LEVEL_PACK_HEADER_SIZE + levelIndex * LEVEL_PACK_INDEX_ENTRY_SIZE;
+		const size_t offset = ReadUInt32(indexEntry);
+		const size_t size = ReadUInt32(indexEntry + 4);
+
+		if (offset > m_File.GetSize() || size > m_File.GetSize() - offset)
+		{
+			return false;
+		}
+
+		outData = m_File.GetData() + offset;
+		outSize = size;
+		return true;
+	}
+
+	bool LevelPack::ReadLevel(size_t levelIndex, LevelData& outLevelData) const
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		if (!GetLevelBytes(levelIndex, data, size))
+		{
+			outLevelData.GridSize = 0;
+			return false;
+		}
+
+		return DecodeBinaryLevel(data, size, outLevelData);
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "LevelData.h"
+#include "MappedFile.h"
+
+namespace Serialization
+{
+	// Level pack layout (all values little endian uint32):
+	//   0   "FUTP", version, level count, reserved
+	//   16  index of (offset, size) pairs, offsets from the start of the file
+	//       binary levels, see BinaryFormat.h
+	static const uint32_t LEVEL_PACK_VERSION = 1;
+	static const size_t LEVEL_PACK_HEADER_SIZE = 16;
+	static const size_t LEVEL_PACK_INDEX_ENTRY_SIZE = 8;
+
+	static const char* const LEVEL_PACK_EXTENSION = ".pack";
+
+	bool WriteLevelPack(const std::vector<LevelData>& levels, const std::string& filepath);
+
+	// Read-only view of a level pack mapped into memory. Levels are decoded straight from the mapping.
+	class LevelPack
+	{
+	public:
+		bool Open(const std::string& filepath);
+		void Close();
+
+		bool IsOpen() const;
+		size_t GetLevelCount() const;
+
+		// The returned bytes point into the mapping and stay valid until the pack is closed.
+		bool GetLevelBytes(size_t levelIndex, const uint8_t*& outData, size_t& outSize) const;
+		bool ReadLevel(size_t levelIndex, LevelData& outLevelData) const;
+
+	private:
+		MappedFile m_File;
+		size_t m_LevelCount = 0;
+	};
+}
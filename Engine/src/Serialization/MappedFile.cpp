@@ -0,0 +1,146 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Serialization
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_Data != nullptr;
+	}
+
+	const uint8_t* MappedFile::GetData() const
+	{
+		return m_Data;
+	}
+
+	size_t MappedFile::GetSize() const
+	{
+		return m_Size;
+	}
+
+#ifdef _WIN32
+	bool MappedFile::Open(const std::string& filepath)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_FileHandle = file;
+		m_MappingHandle = mapping;
+		m_Data = (const uint8_t*)view;
+		m_Size = (size_t)fileSize.QuadPart;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			UnmapViewOfFile(m_Data);
+		}
+
+		if (m_MappingHandle)
+		{
+			CloseHandle((HANDLE)m_MappingHandle);
+		}
+
+		if (m_FileHandle)
+		{
+			CloseHandle((HANDLE)m_FileHandle);
+		}
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+	}
+#else
+	bool MappedFile::Open(const std::string& filepath)
+	{
+		Close();
+
+		const int fileDescriptor = open(filepath.c_str(), O_RDONLY);
+		if (fileDescriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStat;
+		if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+		if (view == MAP_FAILED)
+		{
+			close(fileDescriptor);
+			return false;
+		}
+
+		m_FileDescriptor = fileDescriptor;
+		m_Data = (const uint8_t*)view;
+		m_Size = (size_t)fileStat.st_size;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			munmap((void*)m_Data, m_Size);
+		}
+
+		if (m_FileDescriptor >= 0)
+		{
+			close(m_FileDescriptor);
+		}
+
+		m_Data = nullptr;
+		m_Size = 0;
+		m_FileDescriptor = -1;
+	}
+#endif
+}
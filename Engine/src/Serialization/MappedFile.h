@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+namespace Serialization
+{
+	// Read-only memory mapping of a whole file.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Empty files cannot be mapped and fail to open.
+		bool Open(const std::string& filepath);
+		void Close();
+
+		bool IsOpen() const;
+		const uint8_t* GetData() const;
+		size_t GetSize() const;
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+#ifdef _WIN32
+		void* m_FileHandle = nullptr;
+		void* m_MappingHandle = nullptr;
+#else
+		int m_FileDescriptor = -1;
+#endif
+	};
+}
@@ -1,101 +1,226 @@
 #include "Parser.h"
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 
 #include <fmt/core.h>
 
 namespace Serialization
 {
-	LevelData Parse(const std::string& filepath)
+	struct Tokenizer
 	{
-		LevelData data;
-		std::ifstream file(filepath);
-		if (!file.is_open())
+		const char* Cursor;
+		const char* End;
+		const char* LineStart;
+		size_t Line;
+	};
+
+	static bool IsSpace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	static bool IsDigit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+
+	static bool AtLineEnd(const Tokenizer& tokenizer)
+	{
+		return tokenizer.Cursor == tokenizer.End || *tokenizer.Cursor == '\n';
+	}
+
+	static void SkipSpaces(Tokenizer& tokenizer)
+	{
+		while (tokenizer.Cursor != tokenizer.End && IsSpace(*tokenizer.Cursor))
+		{
+			tokenizer.Cursor++;
+		}
+	}
+
+	static bool Fail(const Tokenizer& tokenizer, const char* position, const char* message, ParseError* outError)
+	{
+		if (outError)
 		{
-			return LevelData();
+			outError->Line = tokenizer.Line;
+			outError->Column = (size_t)(position - tokenizer.LineStart) + 1;
+			outError->Message = message;
 		}
+		return false;
+	}
 
-		std::string line;
+	static bool ReadNumber(Tokenizer& tokenizer, uint8_t& outValue, ParseError* outError)
+	{
+		SkipSpaces(tokenizer);
 
-		while (getline(file, line))
+		const char* start = tokenizer.Cursor;
+		uint32_t value = 0;
+		while (tokenizer.Cursor != tokenizer.End && IsDigit(*tokenizer.Cursor))
 		{
-			std::stringstream ss(line);
-			std::string word;
+			value = value * 10 + (*tokenizer.Cursor - '0');
+			if (value > UINT8_MAX)
+			{
+				return Fail(tokenizer, start, "number out of range", outError);
+			}
+			tokenizer.Cursor++;
+		}
 
-			bool parseSize = false;
-			bool parseNumber = false;
-			bool parseConstraint = false;
+		if (tokenizer.Cursor == start || !(AtLineEnd(tokenizer) || IsSpace(*tokenizer.Cursor)))
+		{
+			return Fail(tokenizer, start, "expected a number", outError);
+		}
+
+		outValue = (uint8_t)value;
+		return true;
+	}
 
-			size_t numberCounter = 0;
-			size_t constraintCounter = 0;
+	// Parses one "S", "N" or "C" record; the cursor is on the tag.
+	static bool ParseRecord(Tokenizer& tokenizer, LevelData& outLevelData, ParseError* outError)
+	{
+		const char* tagStart = tokenizer.Cursor;
+		const char tag = *tokenizer.Cursor++;
+		if (!(AtLineEnd(tokenizer) || IsSpace(*tokenizer.Cursor)))
+		{
+			return Fail(tokenizer, tagStart, "unknown record, expected S, N or C", outError);
+		}
 
-			while (ss >> word)
+		switch (tag)
+		{
+		case 'S':
+		case 's':
+		{
+			return ReadNumber(tokenizer, outLevelData.GridSize, outError);
+		}
+		case 'N':
+		case 'n':
+		{
+			LockedNumber lockedCell;
+			if (!ReadNumber(tokenizer, lockedCell.X, outError)
+				|| !ReadNumber(tokenizer, lockedCell.Y, outError)
+				|| !ReadNumber(tokenizer, lockedCell.Val, outError))
 			{
-				if (parseSize)
-				{
-					data.GridSize = std::stoi(word);
-					parseSize = false;
-				}
-				else if (parseNumber)
-				{
-					switch (numberCounter)
-					{
-					case 0:
-						data.LockedCells.back().X = std::stoi(word);
-						break;
-					case 1:
-						data.LockedCells.back().Y = std::stoi(word);
-						break;
-					case 2:
-						data.LockedCells.back().Val = std::stoi(word);
-						parseNumber = false;
-						break;
-					}
-					numberCounter++;
-				}
-				else if (parseConstraint)
-				{
-					switch (constraintCounter)
-					{
-					case 0:
-						data.GreaterThanConstraints.back().X1 = std::stoi(word);
-						break;
-					case 1:
-						data.GreaterThanConstraints.back().Y1 = std::stoi(word);
-						break;
-					case 2:
-						data.GreaterThanConstraints.back().X2 = std::stoi(word);
-						break;
-					case 3:
-						data.GreaterThanConstraints.back().Y2 = std::stoi(word);
-						parseConstraint = false;
-						break;
-					}
-					constraintCounter++;
-				}
+				return false;
+			}
 
-				if (word == "S" || word == "s")
-				{
-					parseSize = true;
-				}
-				else if (word == "N" || word == "n")
+			outLevelData.LockedCells.push_back(lockedCell);
+			return true;
+		}
+		case 'C':
+		case 'c':
+		{
+			GreaterThanConstraint constraint;
+			if (!ReadNumber(tokenizer, constraint.X1, outError)
+				|| !ReadNumber(tokenizer, constraint.Y1, outError)
+				|| !ReadNumber(tokenizer, constraint.X2, outError)
+				|| !ReadNumber(tokenizer, constraint.Y2, outError))
+			{
+				return false;
+			}
+
+			outLevelData.GreaterThanConstraints.push_back(constraint);
+			return true;
+		}
+		default:
+			return Fail(tokenizer, tagStart, "unknown record, expected S, N or C", outError);
+		}
+	}
+
+	static bool ParseBufferInternal(const char* data, size_t size, LevelData& outLevelData, ParseError* outError)
+	{
+		Tokenizer tokenizer{ data, data + size, data, 1 };
+
+		while (tokenizer.Cursor != tokenizer.End)
+		{
+			SkipSpaces(tokenizer);
+			if (!AtLineEnd(tokenizer))
+			{
+				if (!ParseRecord(tokenizer, outLevelData, outError))
 				{
-					parseNumber = true;
-					data.LockedCells.emplace_back();
-					numberCounter = 0;
+					return false;
 				}
-				else if (word == "C" || word == "c")
+
+				SkipSpaces(tokenizer);
+				if (!AtLineEnd(tokenizer))
 				{
-					parseConstraint = true;
-					data.GreaterThanConstraints.emplace_back();
-					constraintCounter = 0;
+					return Fail(tokenizer, tokenizer.Cursor, "unexpected token at end of line", outError);
 				}
 			}
+
+			if (tokenizer.Cursor != tokenizer.End)
+			{
+				tokenizer.Cursor++;
+				tokenizer.Line++;
+				tokenizer.LineStart = tokenizer.Cursor;
+			}
+		}
+
+		if (outLevelData.GridSize == 0)
+		{
+			return Fail(tokenizer, tokenizer.Cursor, "missing grid size", outError);
+		}
+
+		return true;
+	}
+
+	bool ParseBuffer(const char* data, size_t size, LevelData& outLevelData, ParseError* outError)
+	{
+		outLevelData.GridSize = 0;
+		outLevelData.LockedCells.clear();
+		outLevelData.GreaterThanConstraints.clear();
+
+		if (!ParseBufferInternal(data, size, outLevelData, outError))
+		{
+			outLevelData.GridSize = 0;
+			outLevelData.LockedCells.clear();
+			outLevelData.GreaterThanConstraints.clear();
+			return false;
 		}
 
+		return true;
+	}
+
+	bool Parse(const std::string& filepath, LevelData& outLevelData, ParseError* outError)
+	{
+		// Reused between calls so that steady-state parsing does not allocate.
+		thread_local std::vector<char> buffer;
+
+		std::ifstream file(filepath, std::ifstream::binary | std::ifstream::ate);
+		if (!file.is_open())
+		{
+			outLevelData = LevelData();
+			if (outError)
+			{
+				*outError = ParseError{ 0, 0, "could not open file" };
+			}
+			return false;
+		}
+
+		const std::streamoff size = file.tellg();
+		file.seekg(0);
+		buffer.resize((size_t)std::max<std::streamoff>(size, 0));
+		file.read(buffer.data(), buffer.size());
+
+		return ParseBuffer(buffer.data(), (size_t)file.gcount(), outLevelData, outError);
+	}
+
+	LevelData Parse(const std::string& filepath)
+	{
+		LevelData data;
+		Parse(filepath, data);
 		return data;
 	}
 
+	std::string ToString(const ParseError& error)
+	{
+		if (error.Line == 0)
+		{
+			return error.Message;
+		}
+
+		return fmt::format("line {}, column {}: {}", error.Line, error.Column, error.Message);
+	}
+
 	bool Write(const LevelData& levelData, const std::string& filepath)
 	{
 		std::ofstream file(filepath, std::ofstream::out);
@@ -1,9 +1,26 @@
 #pragma once
+#include <stddef.h>
 #include <string>
 #include "LevelData.h"
 
 namespace Serialization
 {
+	struct ParseError
+	{
+		// 1-based; both are 0 when the file could not be read at all.
+		size_t Line = 0;
+		size_t Column = 0;
+		const char* Message = "";
+	};
+
+	// Returns an empty LevelData (GridSize 0) when the file is missing or malformed.
 	LevelData Parse(const std::string& filepath);
+	bool Parse(const std::string& filepath, LevelData& outLevelData, ParseError* outError = nullptr);
+
+	// Single pass over an in-memory .data file. Reuses the capacity of outLevelData.
+	bool ParseBuffer(const char* data, size_t size, LevelData& outLevelData, ParseError* outError = nullptr);
+
+	std::string ToString(const ParseError& error);
+
 	bool Write(const LevelData& levelData, const std::string& filepath);
-}
\ No newline at end of file
+}
@@ -0,0 +1,273 @@
+#include "SaveGame.h"
+#include <filesystem>
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+
+#include "ByteIO.h"
+
+namespace Serialization
+{
+	namespace fs = std::filesystem;
+
+	static const uint8_t SAVE_GAME_MAGIC[4] = { 'F', 'U', 'T', 'S' };
+	static const char* const SAVE_GAME_TEMP_SUFFIX = ".tmp";
+
+	// Never 0 for a record of zeros, which is what a file cut short by a crash tends to end with.
+	static uint16_t ComputeRecordCheck(const uint8_t* record)
+	{
+		const uint32_t hash = HashBytes(record, 4);
+		return (uint16_t)(hash ^ (hash >> 16));
+	}
+
+	uint32_t ComputeLevelHash(const LevelData& levelData)
+	{
+		// Hashed in row-major order, so that a file listing the same givens and constraints in another
+		// order hashes the same as the board it loads into.
+		std::vector<LockedNumber> lockedCells = levelData.LockedCells;
+		std::sort(lockedCells.begin(), lockedCells.end(), [](const LockedNumber& a, const LockedNumber& b)
+		{
+			return a.Y != b.Y ? a.Y < b.Y : a.X < b.X;
+		});
+
+		std::vector<GreaterThanConstraint> constraints = levelData.GreaterThanConstraints;
+		std::sort(constraints.begin(), constraints.end(), [](const GreaterThanConstraint& a, const GreaterThanConstraint& b)
+		{
+			const uint8_t keyA[4] = { a.Y1, a.X1, a.Y2, a.X2 };
+			const uint8_t keyB[4] = { b.Y1, b.X1, b.Y2, b.X2 };
+			return std::lexicographical_compare(std::begin(keyA), std::end(keyA), std::begin(keyB), std::end(keyB));
+		});
+
+		uint32_t hash = HashBytes(&levelData.GridSize, 1);
+		for (const auto& lockedCell : lockedCells)
+		{
+			const uint8_t bytes[3] = { lockedCell.X, lockedCell.Y, lockedCell.Val };
+			hash = HashBytes(bytes, sizeof(bytes), hash);
+		}
+
+		for (const auto& constraint : constraints)
+		{
+			const uint8_t bytes[4] = { constraint.X1, constraint.Y1, constraint.X2, constraint.Y2 };
+			hash = HashBytes(bytes, sizeof(bytes), hash);
+		}
+
+		return hash;
+	}
+
+	bool ReadSaveGame(const std::string& filepath, SaveGameData& outSaveGame)
+	{
+		std::ifstream file(filepath, std::ifstream::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		const std::vector<uint8_t> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		const uint8_t* data = bytes.data();
+
+		if (bytes.size() < SAVE_GAME_HEADER_SIZE
+			|| !std::equal(std::begin(SAVE_GAME_MAGIC), std::end(SAVE_GAME_MAGIC), data)
+			|| data[4] != SAVE_GAME_VERSION)
+		{
+			return false;
+		}
+
+		const uint8_t gridSize = data[5];
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		const size_t journalSize = ReadUInt32(data + 12);
+		const size_t snapshotSize = SAVE_GAME_HEADER_SIZE + 3 * cellCount + journalSize;
+		if (gridSize == 0 || gridSize > BoardData::MAX_GRID_SIZE || bytes.size() < snapshotSize)
+		{
+			return false;
+		}
+
+		outSaveGame.GridSize = gridSize;
+		outSaveGame.LevelHash = ReadUInt32(data + 8);
+
+		const uint8_t* numbers = data + SAVE_GAME_HEADER_SIZE;
+		const uint8_t* guesses = numbers + cellCount;
+		const uint8_t* journal = guesses + 2 * cellCount;
+
+		outSaveGame.Numbers.assign(numbers, numbers + cellCount);
+		outSaveGame.Guesses.resize(cellCount);
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			if (outSaveGame.Numbers[cell] > gridSize)
+			{
+				return false;
+			}
+			outSaveGame.Guesses[cell] = ReadUInt16(guesses + 2 * cell);
+		}
+		outSaveGame.Journal.assign(journal, journal + journalSize);
+
+		// Records are replayed up to the first one that is cut short or does not check out.
+		size_t recordCount = 0;
+		for (const uint8_t* record = data + snapshotSize; record + SAVE_GAME_RECORD_SIZE <= data + bytes.size(); record += SAVE_GAME_RECORD_SIZE)
+		{
+			const uint8_t cell = record[0];
+			const uint8_t number = record[1];
+			if (ReadUInt16(record + 4) != ComputeRecordCheck(record) || cell >= cellCount || number > gridSize)
+			{
+				break;
+			}
+
+			outSaveGame.Numbers[cell] = number;
+			outSaveGame.Guesses[cell] = ReadUInt16(record + 2);
+			recordCount++;
+		}
+
+		if (recordCount > 0)
+		{
+			outSaveGame.Journal.clear();
+		}
+
+		return true;
+	}
+
+	SaveGameWriter::~SaveGameWriter()
+	{
+		Close();
+	}
+
+	bool SaveGameWriter::Open(const std::string& filepath, const SaveGameData& snapshot)
+	{
+		Close();
+
+		const uint8_t gridSize = snapshot.GridSize;
+		const size_t cellCount = (size_t)gridSize * gridSize;
+		if (gridSize == 0 || gridSize > BoardData::MAX_GRID_SIZE
+			|| snapshot.Numbers.size() != cellCount || snapshot.Guesses.size() != cellCount)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> bytes(SAVE_GAME_HEADER_SIZE + 3 * cellCount + snapshot.Journal.size(), 0);
+		std::copy(std::begin(SAVE_GAME_MAGIC), std::end(SAVE_GAME_MAGIC), bytes.data());
+		bytes[4] = SAVE_GAME_VERSION;
+		bytes[5] = gridSize;
+		WriteUInt32(bytes.data() + 8, snapshot.LevelHash);
+		WriteUInt32(bytes.data() + 12, (uint32_t)snapshot.Journal.size());
+
+		uint8_t* numbers = bytes.data() + SAVE_GAME_HEADER_SIZE;
+		uint8_t* guesses = numbers + cellCount;
+		std::copy(snapshot.Numbers.begin(), snapshot.Numbers.end(), numbers);
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			WriteUInt16(guesses + 2 * cell, snapshot.Guesses[cell]);
+		}
+		std::copy(snapshot.Journal.begin(), snapshot.Journal.end(), guesses + 2 * cellCount);
+
+		// The old file stays whole until the new one is complete.
+		const std::string tempPath = filepath + SAVE_GAME_TEMP_SUFFIX;
+		{
+			std::ofstream file(tempPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			file.write((const char*)bytes.data(), bytes.size());
+			if (!file.good())
+			{
+				return false;
+			}
+		}
+
+		std::error_code error;
+		fs::rename(tempPath, filepath, error);
+		if (error)
+		{
+			fs::remove(tempPath, error);
+			return false;
+		}
+
+		m_File.open(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::app);
+		if (!m_File.is_open())
+		{
+			return false;
+		}
+
+		m_Path = filepath;
+		m_GridSize = gridSize;
+		m_Numbers = snapshot.Numbers;
+		m_Guesses = snapshot.Guesses;
+		m_RecordCount = 0;
+		return true;
+	}
+
+	void SaveGameWriter::Close()
+	{
+		if (m_File.is_open())
+		{
+			m_File.close();
+		}
+		m_GridSize = 0;
+		m_RecordCount = 0;
+	}
+
+	bool SaveGameWriter::IsOpen() const
+	{
+		return m_File.is_open();
+	}
+
+	size_t SaveGameWriter::Append(const BoardData& board)
+	{
+		if (!IsOpen() || board.GridSize != m_GridSize)
+		{
+			return 0;
+		}
+
+		if (memcmp(board.Numbers.data(), m_Numbers.data(), m_Numbers.size()) == 0
+			&& memcmp(board.Guesses.data(), m_Guesses.data(), m_Guesses.size() * sizeof(uint16_t)) == 0)
+		{
+			return 0;
+		}
+
+		uint8_t records[BoardData::MAX_GRID_SIZE * BoardData::MAX_GRID_SIZE * SAVE_GAME_RECORD_SIZE];
+		size_t count = 0;
+		for (size_t cell = 0; cell < m_Numbers.size(); ++cell)
+		{
+			if (board.Numbers[cell] == m_Numbers[cell] && board.Guesses[cell] == m_Guesses[cell])
+			{
+				continue;
+			}
+
+			m_Numbers[cell] = board.Numbers[cell];
+			m_Guesses[cell] = board.Guesses[cell];
+
+			uint8_t* record = records + count * SAVE_GAME_RECORD_SIZE;
+			record[0] = (uint8_t)cell;
+			record[1] = m_Numbers[cell];
+			WriteUInt16(record + 2, m_Guesses[cell]);
+			WriteUInt16(record + 4, ComputeRecordCheck(record));
+			count++;
+		}
+
+		// One write per frame; the data is with the OS once flush returns, so a crash of the game cannot lose it.
+		m_File.write((const char*)records, count * SAVE_GAME_RECORD_SIZE);
+		m_File.flush();
+		if (!m_File.good())
+		{
+			Close();
+			return 0;
+		}
+
+		m_RecordCount += count;
+		return count;
+	}
+
+	bool SaveGameWriter::NeedsCompaction() const
+	{
+		return m_RecordCount >= COMPACT_RECORD_COUNT;
+	}
+
+	const std::string& SaveGameWriter::GetPath() const
+	{
+		return m_Path;
+	}
+
+	size_t SaveGameWriter::GetRecordCount() const
+	{
+		return m_RecordCount;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "LevelData.h"
+#include "BoardData.h"
+
+namespace Serialization
+{
+	// Progress on one level. Numbers and Guesses are row major, like BoardData.
+	struct SaveGameData
+	{
+		uint8_t GridSize = 0;
+		uint32_t LevelHash = 0;
+		std::vector<uint8_t> Numbers;
+		std::vector<uint16_t> Guesses;
+		std::vector<uint8_t> Journal; // Encoded undo history; empty when it was not saved
+	};
+
+	// Save game layout (all multi-byte values little endian):
+	//   0  char[4]  "FUTS"
+	//   4  uint8    version
+	//   5  uint8    grid size (1-16)
+	//   6  uint16   reserved
+	//   8  uint32   level hash, see ComputeLevelHash
+	//  12  uint32   journal size in bytes
+	//  16  numbers, one byte per cell
+	//      guesses, two bytes per cell
+	//      journal
+	//      cell records appended since the file was written, 6 bytes each:
+	//      uint8 cell, uint8 number, uint16 guesses, uint16 check
+	// The snapshot is only ever replaced through a rename, and a record whose check does not match
+	// ends the file, so a crash in the middle of a write loses at most the move being written.
+	static const uint8_t SAVE_GAME_VERSION = 1;
+	static const size_t SAVE_GAME_HEADER_SIZE = 16;
+	static const size_t SAVE_GAME_RECORD_SIZE = 6;
+
+	static const char* const SAVE_GAME_EXTENSION = ".save";
+
+	// FNV-1a of the grid size, locked cells and constraints, so that progress on a level that was
+	// edited since is not restored onto it. The order they are listed in does not change the hash.
+	uint32_t ComputeLevelHash(const LevelData& levelData);
+
+	// Reads the snapshot and replays the records after it. The journal is dropped when records
+	// follow it, as it no longer ends at the saved board.
+	bool ReadSaveGame(const std::string& filepath, SaveGameData& outSaveGame);
+
+	// Writes progress as a snapshot followed by one record per changed cell.
+	class SaveGameWriter
+	{
+	public:
+		// Records appended before Append asks for a new snapshot.
+		static const size_t COMPACT_RECORD_COUNT = 1024;
+
+		~SaveGameWriter();
+
+		// Writes the snapshot to a temporary file, renames it over filepath and keeps the file open
+		// for appending.
+		bool Open(const std::string& filepath, const SaveGameData& snapshot);
+		void Close();
+		bool IsOpen() const;
+
+		// Appends a record for every cell that differs from what was last written. Returns the number
+		// of records; the cost is a compare of the board when nothing changed.
+		size_t Append(const BoardData& board);
+
+		// Set once COMPACT_RECORD_COUNT records were appended; reopening writes a fresh snapshot.
+		bool NeedsCompaction() const;
+
+		const std::string& GetPath() const;
+		size_t GetRecordCount() const;
+
+	private:
+		std::string m_Path;
+		std::ofstream m_File;
+		uint8_t m_GridSize = 0;
+		std::vector<uint8_t> m_Numbers;
+		std::vector<uint16_t> m_Guesses;
+		size_t m_RecordCount = 0;
+	};
+}
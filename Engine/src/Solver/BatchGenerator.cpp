@@ -0,0 +1,135 @@
+#include "BatchGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <fmt/core.h>
+
+#include "WorkStealingQueue.h"
+#include "Serialization/Parser.h"
+
+namespace Solver
+{
+	struct PuzzleRange
+	{
+		size_t Begin;
+		size_t End;
+	};
+
+	// Small chunks keep the tail short when some puzzles need much more search than others.
+	static const size_t PUZZLES_PER_JOB = 4;
+
+	BatchStats GenerateBatch(const GeneratorSettings& settings, size_t count, size_t threadCount, std::vector<Serialization::LevelData>& outLevels)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		outLevels.clear();
+		outLevels.resize(count);
+
+		BatchStats stats;
+		stats.Threads = threadCount;
+
+		WorkStealingQueue<PuzzleRange> queue(threadCount);
+		size_t worker = 0;
+		for (size_t begin = 0; begin < count; begin += PUZZLES_PER_JOB)
+		{
+			queue.Push(worker, PuzzleRange{ begin, std::min(begin + PUZZLES_PER_JOB, count) });
+			worker = (worker + 1) % threadCount;
+		}
+
+		std::vector<GeneratorStats> workerStats(threadCount);
+		std::vector<size_t> workerSteals(threadCount, 0);
+
+		auto runWorker = [&](size_t workerIndex)
+		{
+			PuzzleGenerator generator;
+			PuzzleRange range;
+			while (true)
+			{
+				if (!queue.Pop(workerIndex, range))
+				{
+					if (!queue.Steal(workerIndex, range))
+					{
+						break;
+					}
+					workerSteals[workerIndex]++;
+				}
+
+				for (size_t puzzle = range.Begin; puzzle < range.End; ++puzzle)
+				{
+					generator.Generate(settings, puzzle, outLevels[puzzle]);
+				}
+			}
+
+			workerStats[workerIndex] = generator.GetStats();
+		};
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			threads.emplace_back(runWorker, i);
+		}
+		runWorker(0);
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		stats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			stats.Generator.Puzzles += workerStats[i].Puzzles;
+			stats.Generator.UniquenessChecks += workerStats[i].UniquenessChecks;
+			stats.Generator.SolverNodes += workerStats[i].SolverNodes;
+			stats.Steals += workerSteals[i];
+		}
+
+		return stats;
+	}
+
+	size_t GenerateLevels(const GeneratorSettings& settings, size_t count, const std::string& outputDirectory, size_t threadCount, BatchStats* outStats)
+	{
+		std::vector<Serialization::LevelData> levels;
+		const BatchStats stats = GenerateBatch(settings, count, threadCount, levels);
+
+		std::error_code error;
+		std::filesystem::create_directories(outputDirectory, error);
+
+		// Existing levels keep their files; new ones take the next free names, as levels saved from the editor do.
+		size_t written = 0;
+		size_t levelNumber = 1;
+		for (size_t i = 0; i < levels.size(); ++i)
+		{
+			if (!levels[i].GridSize)
+			{
+				continue;
+			}
+
+			std::string levelPath = fmt::format("{}Level{:03}.data", outputDirectory, levelNumber);
+			while (std::filesystem::exists(levelPath))
+			{
+				levelPath = fmt::format("{}Level{:03}.data", outputDirectory, ++levelNumber);
+			}
+
+			if (Serialization::Write(levels[i], levelPath))
+			{
+				written++;
+			}
+			levelNumber++;
+		}
+
+		if (outStats)
+		{
+			*outStats = stats;
+		}
+
+		return written;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "Generator.h"
+#include "Serialization/LevelData.h"
+
+namespace Solver
+{
+	struct BatchStats
+	{
+		GeneratorStats Generator;
+		size_t Threads = 0;
+		size_t Steals = 0;
+		double Seconds = 0.0;
+	};
+
+	// Generates puzzles [0, count) on threadCount workers (0 = one per hardware thread).
+	// Every worker owns its generator and solver scratch memory, and each puzzle seeds its own
+	// random stream from the master seed and its index, so outLevels[i] does not depend on
+	// the thread count.
+	BatchStats GenerateBatch(const GeneratorSettings& settings, size_t count, size_t threadCount, std::vector<Serialization::LevelData>& outLevels);
+
+	// Generates count levels and writes them to outputDirectory under the first free names of
+	// Level001.data, Level002.data, ...; existing files are never overwritten. Returns the number of levels written.
+	size_t GenerateLevels(const GeneratorSettings& settings, size_t count, const std::string& outputDirectory, size_t threadCount = 0, BatchStats* outStats = nullptr);
+}
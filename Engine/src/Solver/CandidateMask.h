@@ -0,0 +1,69 @@
+#pragma once
+#include <stdint.h>
+
+namespace Solver
+{
+	// Candidate sets for a cell. Digit n (1-based) is stored in bit (n - 1).
+	using CandidateMask = uint16_t;
+
+	inline constexpr CandidateMask FullMask(uint8_t gridSize)
+	{
+		return (CandidateMask)((1u << gridSize) - 1);
+	}
+
+	inline constexpr CandidateMask DigitMask(uint8_t digit)
+	{
+		return (CandidateMask)((1u << digit) >> 1);
+	}
+
+	inline constexpr bool IsSingle(CandidateMask mask)
+	{
+		return mask && !(mask & (mask - 1));
+	}
+
+	inline constexpr CandidateMask LowestBit(CandidateMask mask)
+	{
+		return (CandidateMask)(mask & (~mask + 1));
+	}
+
+	inline CandidateMask HighestBit(CandidateMask mask)
+	{
+		mask |= mask >> 1;
+		mask |= mask >> 2;
+		mask |= mask >> 4;
+		mask |= mask >> 8;
+		return (CandidateMask)(mask ^ (mask >> 1));
+	}
+
+	// Bounds from an inequality, for non-empty masks. The greater cell keeps the digits above the
+	// lesser cell's smallest candidate, the lesser cell the digits below the greater cell's largest one.
+	inline CandidateMask GreaterBound(CandidateMask lesser)
+	{
+		return (CandidateMask)~(((uint32_t)LowestBit(lesser) << 1) - 1);
+	}
+
+	inline CandidateMask LesserBound(CandidateMask greater)
+	{
+		return (CandidateMask)(HighestBit(greater) - 1);
+	}
+
+	inline uint8_t CountCandidates(CandidateMask mask)
+	{
+		uint32_t count = mask - ((mask >> 1) & 0x5555u);
+		count = (count & 0x3333u) + ((count >> 2) & 0x3333u);
+		count = (count + (count >> 4)) & 0x0F0Fu;
+		return (uint8_t)((count + (count >> 8)) & 0x1Fu);
+	}
+
+	// Returns the 1-based digit of a single-candidate mask.
+	inline uint8_t MaskToDigit(CandidateMask mask)
+	{
+		uint8_t digit = 1;
+		while (mask > 1)
+		{
+			mask >>= 1;
+			digit++;
+		}
+		return digit;
+	}
+}
@@ -0,0 +1,392 @@
+#include "DifficultyRater.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "WorkStealingQueue.h"
+
+namespace Solver
+{
+	const uint8_t DifficultyRater::TECHNIQUE_WEIGHTS[(size_t)Technique::COUNT] = { 1, 2, 3, 5, 20 };
+
+	Technique LevelRating::GetHardestTechnique() const
+	{
+		for (uint8_t technique = (uint8_t)Technique::COUNT; technique-- > 0;)
+		{
+			if (UsesTechnique((Technique)technique))
+			{
+				return (Technique)technique;
+			}
+		}
+		return Technique::NAKED_SINGLE;
+	}
+
+	bool DifficultyRater::Rate(const Serialization::LevelData& levelData, LevelRating& outRating)
+	{
+		outRating = LevelRating{};
+
+		m_GridSize = levelData.GridSize;
+		if (m_GridSize == 0 || m_GridSize > BoardSolver::MAX_GRID_SIZE)
+		{
+			return false;
+		}
+
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			if (constraint.X1 >= m_GridSize || constraint.Y1 >= m_GridSize || constraint.X2 >= m_GridSize || constraint.Y2 >= m_GridSize)
+			{
+				return false;
+			}
+		}
+
+		m_CellCount = (size_t)m_GridSize * m_GridSize;
+		m_FilledCount = 0;
+		m_Constraints = &levelData.GreaterThanConstraints;
+		m_Numbers.assign(m_CellCount, 0);
+		m_Candidates.assign(m_CellCount, FullMask(m_GridSize));
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (lockedCell.X >= m_GridSize || lockedCell.Y >= m_GridSize || lockedCell.Val == 0 || lockedCell.Val > m_GridSize
+				|| !Place(lockedCell.Y * m_GridSize + lockedCell.X, lockedCell.Val))
+			{
+				return false;
+			}
+		}
+
+		const size_t emptyCount = m_CellCount - m_FilledCount;
+		while (m_FilledCount < m_CellCount && !IsStuck())
+		{
+			Technique technique = Technique::SEARCH;
+			size_t steps = 1;
+
+			if ((steps = PlaceNakedSingles()) > 0)
+			{
+				technique = Technique::NAKED_SINGLE;
+			}
+			else if (PlaceHiddenSingle())
+			{
+				technique = Technique::HIDDEN_SINGLE;
+				steps = 1;
+			}
+			else if (ApplyInequalityBounds())
+			{
+				technique = Technique::INEQUALITY_BOUND;
+				steps = 1;
+			}
+			else if (EliminateNakedPairs())
+			{
+				technique = Technique::NAKED_PAIR;
+				steps = 1;
+			}
+			else
+			{
+				if (!Search(levelData, outRating))
+				{
+					return false;
+				}
+				break;
+			}
+
+			outRating.Steps[(size_t)technique] += (uint32_t)steps;
+			outRating.Techniques |= (uint8_t)(1 << (uint8_t)technique);
+		}
+
+		if (m_FilledCount < m_CellCount)
+		{
+			return false;
+		}
+
+		uint64_t effort = 0;
+		for (size_t technique = 0; technique < (size_t)Technique::SEARCH; ++technique)
+		{
+			effort += (uint64_t)outRating.Steps[technique] * TECHNIQUE_WEIGHTS[technique];
+		}
+
+		for (uint32_t guesses = outRating.Steps[(size_t)Technique::SEARCH]; guesses; guesses >>= 1)
+		{
+			effort += TECHNIQUE_WEIGHTS[(size_t)Technique::SEARCH];
+		}
+
+		outRating.Solved = true;
+		outRating.Difficulty = (uint16_t)std::clamp<uint64_t>(100 * effort / std::max<size_t>(emptyCount, 1), 1, UINT16_MAX);
+		return true;
+	}
+
+	// Fails when the digit is already used by the row or column.
+	bool DifficultyRater::Place(size_t cell, uint8_t digit)
+	{
+		const CandidateMask bit = DigitMask(digit);
+		if (m_Numbers[cell] != 0 || !(m_Candidates[cell] & bit))
+		{
+			return m_Numbers[cell] == digit;
+		}
+
+		const size_t x = cell % m_GridSize;
+		const size_t y = cell / m_GridSize;
+		for (size_t i = 0; i < m_GridSize; ++i)
+		{
+			m_Candidates[y * m_GridSize + i] &= ~bit;
+			m_Candidates[i * m_GridSize + x] &= ~bit;
+		}
+
+		m_Numbers[cell] = digit;
+		m_Candidates[cell] = bit;
+		m_FilledCount++;
+		return true;
+	}
+
+	bool DifficultyRater::IsStuck() const
+	{
+		for (size_t cell = 0; cell < m_CellCount; ++cell)
+		{
+			if (m_Candidates[cell] == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Every naked single on the board counts as its own step.
+	size_t DifficultyRater::PlaceNakedSingles()
+	{
+		size_t placed = 0;
+		for (size_t cell = 0; cell < m_CellCount; ++cell)
+		{
+			if (m_Numbers[cell] == 0 && IsSingle(m_Candidates[cell]))
+			{
+				placed += Place(cell, MaskToDigit(m_Candidates[cell]));
+			}
+		}
+		return placed;
+	}
+
+	bool DifficultyRater::PlaceHiddenSingle()
+	{
+		for (size_t line = 0; line < 2 * (size_t)m_GridSize; ++line)
+		{
+			const bool isColumn = line >= m_GridSize;
+			const size_t first = isColumn ? line - m_GridSize : line * m_GridSize;
+			const size_t step = isColumn ? m_GridSize : 1;
+
+			// Digits seen once, and digits seen more than once, among the line's empty cells.
+			CandidateMask once = 0;
+			CandidateMask twice = 0;
+			for (size_t i = 0; i < m_GridSize; ++i)
+			{
+				const size_t cell = first + i * step;
+				if (m_Numbers[cell] == 0)
+				{
+					twice |= once & m_Candidates[cell];
+					once |= m_Candidates[cell];
+				}
+			}
+
+			const CandidateMask hidden = once & ~twice;
+			if (!hidden)
+			{
+				continue;
+			}
+
+			const CandidateMask bit = LowestBit(hidden);
+			for (size_t i = 0; i < m_GridSize; ++i)
+			{
+				const size_t cell = first + i * step;
+				if (m_Numbers[cell] == 0 && (m_Candidates[cell] & bit))
+				{
+					return Place(cell, MaskToDigit(bit));
+				}
+			}
+		}
+
+		return false;
+	}
+
+	// One pass over the signs, narrowing both cells to GreaterBound and LesserBound.
+	bool DifficultyRater::ApplyInequalityBounds()
+	{
+		bool changed = false;
+		for (const auto& constraint : *m_Constraints)
+		{
+			CandidateMask& greater = m_Candidates[constraint.Y1 * m_GridSize + constraint.X1];
+			CandidateMask& lesser = m_Candidates[constraint.Y2 * m_GridSize + constraint.X2];
+			if (!greater || !lesser)
+			{
+				continue;
+			}
+
+			const CandidateMask newGreater = greater & GreaterBound(lesser);
+			const CandidateMask newLesser = lesser & LesserBound(greater);
+			changed |= newGreater != greater || newLesser != lesser;
+			greater = newGreater;
+			lesser = newLesser;
+		}
+		return changed;
+	}
+
+	bool DifficultyRater::EliminateNakedPairs()
+	{
+		for (size_t line = 0; line < 2 * (size_t)m_GridSize; ++line)
+		{
+			const bool isColumn = line >= m_GridSize;
+			const size_t first = isColumn ? line - m_GridSize : line * m_GridSize;
+			const size_t step = isColumn ? m_GridSize : 1;
+
+			for (size_t i = 0; i < m_GridSize; ++i)
+			{
+				const CandidateMask pair = m_Candidates[first + i * step];
+				if (m_Numbers[first + i * step] != 0 || CountCandidates(pair) != 2)
+				{
+					continue;
+				}
+
+				for (size_t j = i + 1; j < m_GridSize; ++j)
+				{
+					if (m_Numbers[first + j * step] != 0 || m_Candidates[first + j * step] != pair)
+					{
+						continue;
+					}
+
+					bool changed = false;
+					for (size_t k = 0; k < m_GridSize; ++k)
+					{
+						CandidateMask& candidates = m_Candidates[first + k * step];
+						if (k != i && k != j && m_Numbers[first + k * step] == 0 && (candidates & pair))
+						{
+							candidates &= ~pair;
+							changed = true;
+						}
+					}
+
+					if (changed)
+					{
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	// The solver takes over from the numbers placed so far; its guesses are the search steps.
+	bool DifficultyRater::Search(const Serialization::LevelData& levelData, LevelRating& rating)
+	{
+		m_Board.Resize(m_GridSize);
+		std::copy(m_Numbers.begin(), m_Numbers.end(), m_Board.Numbers.begin());
+
+		std::vector<uint8_t> solution;
+		if (!m_Solver.Load(m_Board, levelData.GreaterThanConstraints, true) || !m_Solver.Solve(solution))
+		{
+			return false;
+		}
+
+		rating.Steps[(size_t)Technique::SEARCH] += (uint32_t)std::max<uint64_t>(m_Solver.GetStats().Nodes, 1);
+		rating.Techniques |= (uint8_t)(1 << (uint8_t)Technique::SEARCH);
+
+		std::copy(solution.begin(), solution.end(), m_Numbers.begin());
+		m_FilledCount = m_CellCount;
+		return true;
+	}
+
+	struct LevelRange
+	{
+		size_t Begin;
+		size_t End;
+	};
+
+	// Most levels rate in microseconds; the ones that need search take much longer.
+	static const size_t LEVELS_PER_JOB = 16;
+
+	RatingBatchStats RateBatch(const std::vector<Serialization::LevelData>& levels, size_t threadCount, std::vector<LevelRating>& outRatings)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		const size_t count = levels.size();
+		outRatings.clear();
+		outRatings.resize(count);
+
+		RatingBatchStats stats;
+		stats.Threads = threadCount;
+
+		WorkStealingQueue<LevelRange> queue(threadCount);
+		size_t worker = 0;
+		for (size_t begin = 0; begin < count; begin += LEVELS_PER_JOB)
+		{
+			queue.Push(worker, LevelRange{ begin, std::min(begin + LEVELS_PER_JOB, count) });
+			worker = (worker + 1) % threadCount;
+		}
+
+		std::vector<size_t> workerRated(threadCount, 0);
+		std::vector<size_t> workerSteals(threadCount, 0);
+
+		auto runWorker = [&](size_t workerIndex)
+		{
+			DifficultyRater rater;
+			LevelRange range;
+			while (true)
+			{
+				if (!queue.Pop(workerIndex, range))
+				{
+					if (!queue.Steal(workerIndex, range))
+					{
+						break;
+					}
+					workerSteals[workerIndex]++;
+				}
+
+				for (size_t level = range.Begin; level < range.End; ++level)
+				{
+					workerRated[workerIndex] += rater.Rate(levels[level], outRatings[level]);
+				}
+			}
+		};
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			threads.emplace_back(runWorker, i);
+		}
+		runWorker(0);
+
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		stats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			stats.Rated += workerRated[i];
+			stats.Steals += workerSteals[i];
+		}
+
+		return stats;
+	}
+
+	const char* ToString(Technique technique)
+	{
+		switch (technique)
+		{
+		case Technique::NAKED_SINGLE:
+			return "Naked single";
+		case Technique::HIDDEN_SINGLE:
+			return "Hidden single";
+		case Technique::INEQUALITY_BOUND:
+			return "Inequality bound";
+		case Technique::NAKED_PAIR:
+			return "Naked pair";
+		case Technique::SEARCH:
+			return "Search";
+		default:
+			return "Unknown";
+		}
+	}
+}
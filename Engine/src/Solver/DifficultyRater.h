@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <array>
+
+#include "Solver.h"
+#include "CandidateMask.h"
+#include "Serialization/LevelData.h"
+
+namespace Solver
+{
+	// Rungs of the deduction ladder, cheapest first. The rater always takes the lowest rung that makes progress.
+	enum class Technique : uint8_t
+	{
+		NAKED_SINGLE,     // A cell has one candidate left
+		HIDDEN_SINGLE,    // A digit fits one cell of a row or column
+		INEQUALITY_BOUND, // Greater-than signs bound a cell by its neighbour's smallest or largest candidate
+		NAKED_PAIR,       // Two cells of a line share the same two candidates, which leave the rest of the line
+		SEARCH,           // Nothing above helps; the solver guesses
+
+		COUNT
+	};
+
+	struct LevelRating
+	{
+		uint16_t Difficulty = 0; // 100 x the average effort per empty cell; 0 when the level could not be rated
+		uint8_t Techniques = 0;  // Bit n is set when Technique n was needed
+		bool Solved = false;
+		std::array<uint32_t, (size_t)Technique::COUNT> Steps{}; // Steps taken per technique; guesses for SEARCH
+
+		bool UsesTechnique(Technique technique) const { return (Techniques >> (uint8_t)technique) & 1; }
+		Technique GetHardestTechnique() const;
+	};
+
+	// Solves a level the way a player would and records what it took. Scratch memory is kept
+	// between levels, so one rater per thread can rate any number of them.
+	class DifficultyRater
+	{
+	public:
+		// Effort of one step of each technique. Search effort grows with the log of the guesses, so that
+		// a level needing thousands of them does not swamp the scale.
+		static const uint8_t TECHNIQUE_WEIGHTS[(size_t)Technique::COUNT];
+
+		// Returns false, leaving the rating at 0, for malformed levels and levels without a solution.
+		bool Rate(const Serialization::LevelData& levelData, LevelRating& outRating);
+
+	private:
+		bool Place(size_t cell, uint8_t digit);
+		bool IsStuck() const;
+
+		size_t PlaceNakedSingles();
+		bool PlaceHiddenSingle();
+		bool ApplyInequalityBounds();
+		bool EliminateNakedPairs();
+		bool Search(const Serialization::LevelData& levelData, LevelRating& rating);
+
+	private:
+		uint8_t m_GridSize = 0;
+		size_t m_CellCount = 0;
+		size_t m_FilledCount = 0;
+
+		std::vector<uint8_t> m_Numbers;
+		std::vector<CandidateMask> m_Candidates;
+		const std::vector<Serialization::GreaterThanConstraint>* m_Constraints = nullptr;
+
+		BoardSolver m_Solver;
+		Serialization::BoardData m_Board;
+	};
+
+	struct RatingBatchStats
+	{
+		size_t Threads = 0;
+		size_t Steals = 0;
+		size_t Rated = 0;
+		double Seconds = 0.0;
+	};
+
+	// Rates levels on threadCount workers (0 = one per hardware thread), one rater per worker.
+	// outRatings[i] belongs to levels[i].
+	RatingBatchStats RateBatch(const std::vector<Serialization::LevelData>& levels, size_t threadCount, std::vector<LevelRating>& outRatings);
+
+	const char* ToString(Technique technique);
+}
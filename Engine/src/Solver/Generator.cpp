@@ -0,0 +1,196 @@
+#include "Generator.h"
+#include <limits>
+
+namespace Solver
+{
+	bool PuzzleGenerator::Generate(const GeneratorSettings& settings, size_t puzzleIndex, Serialization::LevelData& outLevelData)
+	{
+		if (settings.GridSize == 0 || settings.GridSize > BoardSolver::MAX_GRID_SIZE)
+		{
+			return false;
+		}
+
+		m_Random.State = DerivePuzzleSeed(settings.Seed, puzzleIndex);
+
+		switch (settings.TargetDifficulty)
+		{
+		case Difficulty::EASY:
+			m_MaxSearchNodes = 0;
+			break;
+		case Difficulty::MEDIUM:
+			m_MaxSearchNodes = settings.GridSize;
+			break;
+		default:
+			m_MaxSearchNodes = std::numeric_limits<uint64_t>::max();
+			break;
+		}
+
+		if (!BuildSolution(settings.GridSize))
+		{
+			return false;
+		}
+
+		BuildCandidateConstraints(settings.ConstraintDensity);
+
+		const size_t cellCount = (size_t)m_GridSize * m_GridSize;
+		m_GivenActive.assign(cellCount, 1);
+
+		m_RemovalOrder.resize(cellCount);
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			m_RemovalOrder[cell] = (uint16_t)cell;
+		}
+		m_Random.Shuffle(m_RemovalOrder.data(), m_RemovalOrder.size());
+
+		for (const uint16_t cell : m_RemovalOrder)
+		{
+			m_GivenActive[cell] = 0;
+			if (!IsAcceptable())
+			{
+				m_GivenActive[cell] = 1;
+			}
+		}
+
+		m_RemovalOrder.resize(m_Constraints.size());
+		for (size_t i = 0; i < m_Constraints.size(); ++i)
+		{
+			m_RemovalOrder[i] = (uint16_t)i;
+		}
+		m_Random.Shuffle(m_RemovalOrder.data(), m_RemovalOrder.size());
+
+		for (const uint16_t constraint : m_RemovalOrder)
+		{
+			m_ConstraintActive[constraint] = 0;
+			if (!IsAcceptable())
+			{
+				m_ConstraintActive[constraint] = 1;
+			}
+		}
+
+		BuildLevelData(outLevelData);
+		m_Stats.Puzzles++;
+		return true;
+	}
+
+	const GeneratorStats& PuzzleGenerator::GetStats() const
+	{
+		return m_Stats;
+	}
+
+	void PuzzleGenerator::ResetStats()
+	{
+		m_Stats = GeneratorStats{};
+	}
+
+	bool PuzzleGenerator::BuildSolution(uint8_t gridSize)
+	{
+		m_GridSize = gridSize;
+
+		m_Scratch.GridSize = gridSize;
+		m_Scratch.LockedCells.clear();
+		m_Scratch.GreaterThanConstraints.clear();
+
+		m_Solver.SetGuessSeed(m_Random.Next() | 1);
+		const bool solved = m_Solver.Load(m_Scratch) && m_Solver.Solve(m_Solution);
+		m_Solver.SetGuessSeed(0);
+
+		return solved;
+	}
+
+	void PuzzleGenerator::BuildCandidateConstraints(float constraintDensity)
+	{
+		const uint32_t RESOLUTION = 1000;
+		const uint32_t threshold = (uint32_t)(constraintDensity * RESOLUTION);
+
+		m_Constraints.clear();
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const uint8_t neighbours[2][2] = { { (uint8_t)(x + 1), y }, { x, (uint8_t)(y + 1) } };
+				for (const auto& neighbour : neighbours)
+				{
+					const uint8_t nx = neighbour[0];
+					const uint8_t ny = neighbour[1];
+					if (nx >= m_GridSize || ny >= m_GridSize || m_Random.Below(RESOLUTION) >= threshold)
+					{
+						continue;
+					}
+
+					if (m_Solution[y * m_GridSize + x] > m_Solution[ny * m_GridSize + nx])
+					{
+						m_Constraints.push_back({ x, y, nx, ny });
+					}
+					else
+					{
+						m_Constraints.push_back({ nx, ny, x, y });
+					}
+				}
+			}
+		}
+
+		m_ConstraintActive.assign(m_Constraints.size(), 1);
+	}
+
+	bool PuzzleGenerator::IsAcceptable()
+	{
+		BuildLevelData(m_Scratch);
+		m_Stats.UniquenessChecks++;
+
+		if (!m_Solver.Load(m_Scratch))
+		{
+			return false;
+		}
+
+		const Uniqueness uniqueness = m_Solver.CheckUniqueness();
+		m_Stats.SolverNodes += m_Solver.GetStats().Nodes;
+
+		return uniqueness == Uniqueness::UNIQUE && m_Solver.GetStats().Nodes <= m_MaxSearchNodes;
+	}
+
+	void PuzzleGenerator::BuildLevelData(Serialization::LevelData& outLevelData) const
+	{
+		outLevelData.GridSize = m_GridSize;
+		outLevelData.LockedCells.clear();
+		outLevelData.GreaterThanConstraints.clear();
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const size_t cell = y * m_GridSize + x;
+				if (m_GivenActive[cell])
+				{
+					outLevelData.LockedCells.push_back({ x, y, m_Solution[cell] });
+				}
+			}
+		}
+
+		for (size_t i = 0; i < m_Constraints.size(); ++i)
+		{
+			if (m_ConstraintActive[i])
+			{
+				outLevelData.GreaterThanConstraints.push_back(m_Constraints[i]);
+			}
+		}
+	}
+
+	uint64_t DerivePuzzleSeed(uint64_t masterSeed, size_t puzzleIndex)
+	{
+		Random random{ masterSeed ^ (0xD1B54A32D192ED03ull * (puzzleIndex + 1)) };
+		return random.Next();
+	}
+
+	const char* ToString(Difficulty difficulty)
+	{
+		switch (difficulty)
+		{
+		case Difficulty::EASY:
+			return "Easy";
+		case Difficulty::MEDIUM:
+			return "Medium";
+		default:
+			return "Hard";
+		}
+	}
+}
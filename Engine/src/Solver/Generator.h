@@ -0,0 +1,72 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "Solver.h"
+#include "Random.h"
+#include "Serialization/LevelData.h"
+
+namespace Solver
+{
+	// Limits how much searching the uniqueness check may need while givens and
+	// constraints are removed. EASY levels can be solved by propagation alone.
+	enum class Difficulty : uint8_t
+	{
+		EASY,
+		MEDIUM,
+		HARD,
+	};
+
+	struct GeneratorSettings
+	{
+		uint8_t GridSize = 5;
+		Difficulty TargetDifficulty = Difficulty::MEDIUM;
+		float ConstraintDensity = 0.35f; // Share of adjacent cell pairs that start with an inequality
+		uint64_t Seed = 1;               // Master seed; every puzzle index derives its own seed from it
+	};
+
+	struct GeneratorStats
+	{
+		size_t Puzzles = 0;
+		size_t UniquenessChecks = 0;
+		uint64_t SolverNodes = 0;
+	};
+
+	// Builds a random Latin square, adds inequalities, then strips givens and inequalities
+	// for as long as the solution stays unique. Scratch memory is reused between puzzles.
+	class PuzzleGenerator
+	{
+	public:
+		// The same settings and puzzle index always produce the same level.
+		bool Generate(const GeneratorSettings& settings, size_t puzzleIndex, Serialization::LevelData& outLevelData);
+
+		const GeneratorStats& GetStats() const;
+		void ResetStats();
+
+	private:
+		bool BuildSolution(uint8_t gridSize);
+		void BuildCandidateConstraints(float constraintDensity);
+		bool IsAcceptable();
+		void BuildLevelData(Serialization::LevelData& outLevelData) const;
+
+	private:
+		uint8_t m_GridSize = 0;
+		uint64_t m_MaxSearchNodes = 0;
+		Random m_Random;
+
+		BoardSolver m_Solver;
+		std::vector<uint8_t> m_Solution;
+		std::vector<uint8_t> m_GivenActive;
+		std::vector<uint16_t> m_RemovalOrder;
+		std::vector<Serialization::GreaterThanConstraint> m_Constraints;
+		std::vector<uint8_t> m_ConstraintActive;
+		Serialization::LevelData m_Scratch;
+
+		GeneratorStats m_Stats;
+	};
+
+	uint64_t DerivePuzzleSeed(uint64_t masterSeed, size_t puzzleIndex);
+
+	const char* ToString(Difficulty difficulty);
+}
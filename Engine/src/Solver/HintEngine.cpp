@@ -0,0 +1,433 @@
+#include "HintEngine.h"
+#include <algorithm>
+
+namespace Solver
+{
+	static const uint8_t CHAIN_UNVISITED = 0xFF;
+
+	const Hint& HintEngine::FindHint(const Serialization::BoardData& board, const std::vector<Serialization::GreaterThanConstraint>& constraints)
+	{
+		m_Board = &board;
+		m_Constraints = &constraints;
+		m_GridSize = board.GridSize;
+		m_Hint = Hint();
+
+		if (m_GridSize == 0 || m_GridSize > Serialization::BoardData::MAX_GRID_SIZE)
+		{
+			return m_Hint;
+		}
+
+		const size_t cellCount = board.GetCellCount();
+		m_LatinCandidates.resize(cellCount);
+		m_DirectCandidates.resize(cellCount);
+		m_Candidates.resize(cellCount);
+		m_ChainDepth.resize(cellCount);
+		m_ChainQueue.reserve(cellCount);
+
+		if (FindConflict())
+		{
+			return m_Hint;
+		}
+
+		ComputeLatinCandidates();
+		if (FindSingle(m_LatinCandidates.data(), HintRule::NONE))
+		{
+			return m_Hint;
+		}
+
+		// Each sign bounds its cells by the other's extreme candidate, once.
+		std::copy(m_LatinCandidates.begin(), m_LatinCandidates.end(), m_DirectCandidates.begin());
+		ApplyInequalityBounds(m_LatinCandidates.data(), m_DirectCandidates.data());
+		if (FindSingle(m_DirectCandidates.data(), HintRule::INEQUALITY_BOUND))
+		{
+			return m_Hint;
+		}
+
+		// Repeating until nothing changes carries the bounds along whole chains of signs.
+		std::copy(m_DirectCandidates.begin(), m_DirectCandidates.end(), m_Candidates.begin());
+		while (ApplyInequalityBounds(m_Candidates.data(), m_Candidates.data()))
+		{
+		}
+
+		if (FindSingle(m_Candidates.data(), HintRule::CHAIN_BOUND))
+		{
+			return m_Hint;
+		}
+
+		if (FindElimination(m_DirectCandidates.data(), m_LatinCandidates.data(), HintRule::INEQUALITY_BOUND))
+		{
+			return m_Hint;
+		}
+
+		FindElimination(m_Candidates.data(), m_DirectCandidates.data(), HintRule::CHAIN_BOUND);
+		return m_Hint;
+	}
+
+	const Hint& HintEngine::GetHint() const
+	{
+		return m_Hint;
+	}
+
+	bool HintEngine::FindConflict()
+	{
+		const uint8_t* numbers = m_Board->Numbers.data();
+		std::array<uint8_t, Serialization::BoardData::MAX_GRID_SIZE + 1> firstSeen;
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			firstSeen.fill(CHAIN_UNVISITED);
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const uint8_t number = numbers[y * m_GridSize + x];
+				if (number == 0 || number > m_GridSize)
+				{
+					continue;
+				}
+
+				if (firstSeen[number] != CHAIN_UNVISITED)
+				{
+					SetHint(HintRule::CONFLICT, x, y, 0);
+					AddReason(firstSeen[number], y);
+					return true;
+				}
+				firstSeen[number] = x;
+			}
+		}
+
+		for (uint8_t x = 0; x < m_GridSize; ++x)
+		{
+			firstSeen.fill(CHAIN_UNVISITED);
+			for (uint8_t y = 0; y < m_GridSize; ++y)
+			{
+				const uint8_t number = numbers[y * m_GridSize + x];
+				if (number == 0 || number > m_GridSize)
+				{
+					continue;
+				}
+
+				if (firstSeen[number] != CHAIN_UNVISITED)
+				{
+					SetHint(HintRule::CONFLICT, x, y, 0);
+					AddReason(x, firstSeen[number]);
+					return true;
+				}
+				firstSeen[number] = y;
+			}
+		}
+
+		for (const auto& constraint : *m_Constraints)
+		{
+			const uint8_t number1 = numbers[constraint.Y1 * m_GridSize + constraint.X1];
+			const uint8_t number2 = numbers[constraint.Y2 * m_GridSize + constraint.X2];
+			if (number1 != 0 && number2 != 0 && number1 <= number2)
+			{
+				SetHint(HintRule::CONFLICT, constraint.X1, constraint.Y1, 0);
+				AddReason(constraint.X2, constraint.Y2);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void HintEngine::ComputeLatinCandidates()
+	{
+		const uint8_t* numbers = m_Board->Numbers.data();
+		m_RowUsed.fill(0);
+		m_ColUsed.fill(0);
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const CandidateMask bit = DigitMask(numbers[y * m_GridSize + x]);
+				m_RowUsed[y] |= bit;
+				m_ColUsed[x] |= bit;
+			}
+		}
+
+		const CandidateMask full = FullMask(m_GridSize);
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const size_t cell = y * m_GridSize + x;
+				m_LatinCandidates[cell] = numbers[cell] ? DigitMask(numbers[cell]) : (CandidateMask)(full & ~(m_RowUsed[y] | m_ColUsed[x]));
+			}
+		}
+	}
+
+	// Narrows target by the bounds of the candidates in source.
+	bool HintEngine::ApplyInequalityBounds(const CandidateMask* source, CandidateMask* target) const
+	{
+		bool changed = false;
+		for (const auto& constraint : *m_Constraints)
+		{
+			const size_t greaterCell = constraint.Y1 * m_GridSize + constraint.X1;
+			const size_t lesserCell = constraint.Y2 * m_GridSize + constraint.X2;
+			const CandidateMask greater = source[greaterCell];
+			const CandidateMask lesser = source[lesserCell];
+			if (!greater || !lesser)
+			{
+				continue;
+			}
+
+			const CandidateMask newGreater = target[greaterCell] & GreaterBound(lesser);
+			const CandidateMask newLesser = target[lesserCell] & LesserBound(greater);
+			changed |= newGreater != target[greaterCell] || newLesser != target[lesserCell];
+			target[greaterCell] = newGreater;
+			target[lesserCell] = newLesser;
+		}
+		return changed;
+	}
+
+	bool HintEngine::FindSingle(const CandidateMask* candidates, HintRule boundRule)
+	{
+		const uint8_t* numbers = m_Board->Numbers.data();
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				const size_t cell = y * m_GridSize + x;
+				if (numbers[cell] != 0 || (candidates[cell] && !IsSingle(candidates[cell])))
+				{
+					continue;
+				}
+
+				if (candidates[cell] == 0)
+				{
+					SetHint(HintRule::DEAD_END, x, y, 0);
+				}
+				else
+				{
+					SetHint(boundRule == HintRule::NONE ? HintRule::NAKED_SINGLE : boundRule, x, y, MaskToDigit(candidates[cell]));
+				}
+
+				m_Hint.Candidates = candidates[cell];
+				AddChainReasons(x, y, boundRule);
+				AddLineReasons(x, y);
+				return true;
+			}
+		}
+
+		return FindHiddenSingle(candidates, boundRule, false) || FindHiddenSingle(candidates, boundRule, true);
+	}
+
+	bool HintEngine::FindHiddenSingle(const CandidateMask* candidates, HintRule boundRule, bool columns)
+	{
+		const uint8_t* numbers = m_Board->Numbers.data();
+		const CandidateMask full = FullMask(m_GridSize);
+		const size_t step = columns ? m_GridSize : 1;
+
+		for (uint8_t line = 0; line < m_GridSize; ++line)
+		{
+			const size_t first = columns ? line : (size_t)line * m_GridSize;
+			const CandidateMask missing = full & ~(columns ? m_ColUsed[line] : m_RowUsed[line]);
+
+			for (uint8_t digit = 1; digit <= m_GridSize; ++digit)
+			{
+				const CandidateMask bit = DigitMask(digit);
+				if (!(missing & bit))
+				{
+					continue;
+				}
+
+				uint8_t count = 0;
+				uint8_t position = 0;
+				for (uint8_t i = 0; i < m_GridSize && count < 2; ++i)
+				{
+					const size_t cell = first + i * step;
+					if (numbers[cell] == 0 && (candidates[cell] & bit))
+					{
+						count++;
+						position = i;
+					}
+				}
+
+				if (count != 1)
+				{
+					continue;
+				}
+
+				const uint8_t x = columns ? line : position;
+				const uint8_t y = columns ? position : line;
+				SetHint(boundRule != HintRule::NONE ? boundRule : (columns ? HintRule::HIDDEN_SINGLE_COL : HintRule::HIDDEN_SINGLE_ROW), x, y, digit);
+				m_Hint.Candidates = bit;
+
+				// Every other empty cell of the line is ruled out by the digit in its crossing line,
+				// or, failing that, by its own bounds.
+				for (uint8_t i = 0; i < m_GridSize; ++i)
+				{
+					const size_t cell = first + i * step;
+					if (i == position || numbers[cell] != 0)
+					{
+						continue;
+					}
+
+					const uint8_t otherX = columns ? line : i;
+					const uint8_t otherY = columns ? i : line;
+					bool blocked = false;
+					for (uint8_t j = 0; j < m_GridSize && !blocked; ++j)
+					{
+						const uint8_t crossX = columns ? j : otherX;
+						const uint8_t crossY = columns ? otherY : j;
+						if (numbers[crossY * m_GridSize + crossX] == digit)
+						{
+							AddReason(crossX, crossY);
+							blocked = true;
+						}
+					}
+
+					if (!blocked)
+					{
+						AddReason(otherX, otherY);
+					}
+				}
+
+				AddChainReasons(x, y, boundRule);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// The cell losing the most candidates, so the step is worth taking.
+	bool HintEngine::FindElimination(const CandidateMask* candidates, const CandidateMask* before, HintRule boundRule)
+	{
+		const uint8_t* numbers = m_Board->Numbers.data();
+		const size_t cellCount = m_Board->GetCellCount();
+
+		size_t bestCell = cellCount;
+		uint8_t bestCount = 0;
+		for (size_t cell = 0; cell < cellCount; ++cell)
+		{
+			const uint8_t count = CountCandidates(before[cell] & ~candidates[cell]);
+			if (numbers[cell] == 0 && count > bestCount)
+			{
+				bestCell = cell;
+				bestCount = count;
+			}
+		}
+
+		if (bestCell == cellCount)
+		{
+			return false;
+		}
+
+		const uint8_t x = (uint8_t)(bestCell % m_GridSize);
+		const uint8_t y = (uint8_t)(bestCell / m_GridSize);
+		SetHint(boundRule, x, y, 0);
+		m_Hint.Candidates = candidates[bestCell];
+		AddChainReasons(x, y, boundRule);
+		return true;
+	}
+
+	void HintEngine::SetHint(HintRule rule, uint8_t x, uint8_t y, uint8_t number)
+	{
+		m_Hint.Rule = rule;
+		m_Hint.Cell = { x, y };
+		m_Hint.Number = number;
+		m_Hint.ReasonCount = 0;
+	}
+
+	void HintEngine::AddReason(uint8_t x, uint8_t y)
+	{
+		if (m_Hint.ReasonCount >= Hint::MAX_REASONS || (x == m_Hint.Cell.X && y == m_Hint.Cell.Y))
+		{
+			return;
+		}
+
+		for (uint8_t i = 0; i < m_Hint.ReasonCount; ++i)
+		{
+			if (m_Hint.Reasons[i].X == x && m_Hint.Reasons[i].Y == y)
+			{
+				return;
+			}
+		}
+
+		m_Hint.Reasons[m_Hint.ReasonCount++] = { x, y };
+	}
+
+	// The filled cells sharing a row or column with the cell.
+	void HintEngine::AddLineReasons(uint8_t x, uint8_t y)
+	{
+		for (uint8_t i = 0; i < m_GridSize; ++i)
+		{
+			if (m_Board->GetNumber(i, y) != 0)
+			{
+				AddReason(i, y);
+			}
+
+			if (m_Board->GetNumber(x, i) != 0)
+			{
+				AddReason(x, i);
+			}
+		}
+	}
+
+	// Cells linked to the cell by greater-than signs: direct neighbours for a bound,
+	// everything reachable for a chain, nothing for a Latin rule.
+	void HintEngine::AddChainReasons(uint8_t x, uint8_t y, HintRule boundRule)
+	{
+		if (boundRule == HintRule::NONE)
+		{
+			return;
+		}
+
+		const uint8_t maxDepth = boundRule == HintRule::INEQUALITY_BOUND ? 1 : CHAIN_UNVISITED - 1;
+		std::fill(m_ChainDepth.begin(), m_ChainDepth.end(), CHAIN_UNVISITED);
+		m_ChainQueue.clear();
+
+		const size_t start = y * m_GridSize + x;
+		m_ChainDepth[start] = 0;
+		m_ChainQueue.push_back((uint16_t)start);
+
+		for (size_t head = 0; head < m_ChainQueue.size(); ++head)
+		{
+			const size_t cell = m_ChainQueue[head];
+			if (m_ChainDepth[cell] >= maxDepth)
+			{
+				continue;
+			}
+
+			for (const auto& constraint : *m_Constraints)
+			{
+				const size_t cell1 = constraint.Y1 * m_GridSize + constraint.X1;
+				const size_t cell2 = constraint.Y2 * m_GridSize + constraint.X2;
+				const size_t other = cell1 == cell ? cell2 : (cell2 == cell ? cell1 : cell);
+				if (other == cell || m_ChainDepth[other] != CHAIN_UNVISITED)
+				{
+					continue;
+				}
+
+				m_ChainDepth[other] = (uint8_t)(m_ChainDepth[cell] + 1);
+				m_ChainQueue.push_back((uint16_t)other);
+				AddReason((uint8_t)(other % m_GridSize), (uint8_t)(other / m_GridSize));
+			}
+		}
+	}
+
+	const char* ToString(HintRule rule)
+	{
+		switch (rule)
+		{
+		case HintRule::CONFLICT:
+			return "Conflict";
+		case HintRule::DEAD_END:
+			return "Dead end";
+		case HintRule::NAKED_SINGLE:
+			return "Naked single";
+		case HintRule::HIDDEN_SINGLE_ROW:
+			return "Hidden single in row";
+		case HintRule::HIDDEN_SINGLE_COL:
+			return "Hidden single in column";
+		case HintRule::INEQUALITY_BOUND:
+			return "Inequality bound";
+		case HintRule::CHAIN_BOUND:
+			return "Inequality chain";
+		default:
+			return "None";
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <array>
+
+#include "CandidateMask.h"
+#include "Serialization/BoardData.h"
+#include "Serialization/LevelData.h"
+
+namespace Solver
+{
+	// Ordered from the cheapest deduction to the most involved one.
+	enum class HintRule : uint8_t
+	{
+		NONE,              // No logical step found
+		CONFLICT,          // Entered numbers already break a rule
+		DEAD_END,          // An empty cell has no digit left, so an entered number is wrong
+		NAKED_SINGLE,      // Only one digit is missing from the cell's row and column
+		HIDDEN_SINGLE_ROW, // The digit fits nowhere else in the row
+		HIDDEN_SINGLE_COL, // The digit fits nowhere else in the column
+		INEQUALITY_BOUND,  // The min/max of a neighbour across a greater-than sign narrows the cell
+		CHAIN_BOUND,       // Bounds carried along a chain of greater-than signs narrow the cell
+	};
+
+	struct HintCell
+	{
+		uint8_t X;
+		uint8_t Y;
+	};
+
+	struct Hint
+	{
+		static const size_t MAX_REASONS = 32;
+
+		HintRule Rule = HintRule::NONE;
+		HintCell Cell{ 0, 0 };
+		uint8_t Number = 0;           // Digit the cell must hold; 0 when the step only removes candidates
+		CandidateMask Candidates = 0; // Digits left for the cell after the step
+		std::array<HintCell, MAX_REASONS> Reasons{}; // Cells the deduction relies on
+		uint8_t ReasonCount = 0;
+	};
+
+	// Human-style deductions on a board in play. Placements are preferred over eliminations,
+	// and within each the cheapest rule wins: Latin singles, then direct inequality bounds,
+	// then bounds carried along inequality chains. Scratch memory is kept between calls.
+	class HintEngine
+	{
+	public:
+		const Hint& FindHint(const Serialization::BoardData& board, const std::vector<Serialization::GreaterThanConstraint>& constraints);
+		const Hint& GetHint() const;
+
+	private:
+		bool FindConflict();
+		void ComputeLatinCandidates();
+		bool ApplyInequalityBounds(const CandidateMask* source, CandidateMask* target) const;
+		bool FindSingle(const CandidateMask* candidates, HintRule boundRule);
+		bool FindHiddenSingle(const CandidateMask* candidates, HintRule boundRule, bool columns);
+		bool FindElimination(const CandidateMask* candidates, const CandidateMask* before, HintRule boundRule);
+
+		void SetHint(HintRule rule, uint8_t x, uint8_t y, uint8_t number);
+		void AddReason(uint8_t x, uint8_t y);
+		void AddLineReasons(uint8_t x, uint8_t y);
+		void AddChainReasons(uint8_t x, uint8_t y, HintRule boundRule);
+
+	private:
+		const Serialization::BoardData* m_Board = nullptr;
+		const std::vector<Serialization::GreaterThanConstraint>* m_Constraints = nullptr;
+		uint8_t m_GridSize = 0;
+
+		std::array<CandidateMask, Serialization::BoardData::MAX_GRID_SIZE> m_RowUsed{};
+		std::array<CandidateMask, Serialization::BoardData::MAX_GRID_SIZE> m_ColUsed{};
+		std::vector<CandidateMask> m_LatinCandidates;
+		std::vector<CandidateMask> m_DirectCandidates;
+		std::vector<CandidateMask> m_Candidates;
+		std::vector<uint8_t> m_ChainDepth;
+		std::vector<uint16_t> m_ChainQueue;
+
+		Hint m_Hint;
+	};
+
+	const char* ToString(HintRule rule);
+}
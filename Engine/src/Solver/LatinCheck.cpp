@@ -0,0 +1,374 @@
+#include "LatinCheck.h"
+#include <string.h>
+#include <atomic>
+
+#include "CandidateMask.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define LATIN_CHECK_X64 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define LATIN_CHECK_TARGET_AVX2
+	#else
+		#define LATIN_CHECK_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#else
+	#define LATIN_CHECK_X64 0
+#endif
+
+namespace Solver
+{
+	static const uint8_t LATIN_MAX_GRID_SIZE = 16;
+
+	// Smallest grids each SIMD kernel runs on when the level is not forced. Below these sizes
+	// the kernels' setup costs more than the scalar loop over the whole board ("benchmark latin").
+	static const uint8_t LATIN_AVX2_MIN_GRID_SIZE = 6;
+	static const uint8_t LATIN_SSE2_MIN_GRID_SIZE = 12;
+
+	// Stored in the level state while the kernel is picked per grid size.
+	static const uint8_t LATIN_LEVEL_AUTO = 0xFF;
+
+	using LatinCheckFn = bool(*)(const uint8_t* numbers, uint8_t gridSize);
+
+	static bool IsLatinSquareScalar(const uint8_t* numbers, uint8_t gridSize)
+	{
+		const CandidateMask full = FullMask(gridSize);
+		CandidateMask colSeen[LATIN_MAX_GRID_SIZE] = { 0 };
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			CandidateMask rowSeen = 0;
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint8_t number = numbers[y * gridSize + x];
+				if (number > gridSize)
+				{
+					return false;
+				}
+
+				const CandidateMask bit = DigitMask(number);
+				rowSeen |= bit;
+				colSeen[x] |= bit;
+			}
+
+			// gridSize cells holding gridSize different digits: each digit exactly once.
+			if (rowSeen != full)
+			{
+				return false;
+			}
+		}
+
+		for (uint8_t x = 0; x < gridSize; ++x)
+		{
+			if (colSeen[x] != full)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+#if LATIN_CHECK_X64
+	// Row y in the low gridSize bytes, zeros above. Reads 16 bytes straight from the board where
+	// that stays inside it, and copies the last rows, which would read past its end.
+	static __m128i LoadRow(const uint8_t* numbers, uint8_t gridSize, uint8_t y, __m128i laneMask)
+	{
+		const size_t offset = (size_t)y * gridSize;
+		if (offset + 16 <= (size_t)gridSize * gridSize)
+		{
+			return _mm_and_si128(_mm_loadu_si128((const __m128i*)(numbers + offset)), laneMask);
+		}
+
+		alignas(16) uint8_t row[LATIN_MAX_GRID_SIZE] = { 0 };
+		memcpy(row, numbers + offset, gridSize);
+		return _mm_load_si128((const __m128i*)row);
+	}
+
+	// Bytes 0..gridSize-1 set.
+	static __m128i GetLaneMask(uint8_t gridSize)
+	{
+		alignas(16) static const uint8_t ones[2 * LATIN_MAX_GRID_SIZE] = {
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+		return _mm_loadu_si128((const __m128i*)(ones + LATIN_MAX_GRID_SIZE - gridSize));
+	}
+
+	// One-hot masks from the float exponent: (number + 126) << 23 is the float 2^(number - 1), which
+	// truncates to the integer with bit (number - 1) set. An empty cell gives 0.5, which truncates to 0,
+	// and numbers above 16 give bits outside any full mask, or none at all.
+	static void OneHotSse2(__m128i row, __m128i* outMasks)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bias = _mm_set1_epi32(126);
+
+		const __m128i low = _mm_unpacklo_epi8(row, zero);
+		const __m128i high = _mm_unpackhi_epi8(row, zero);
+		const __m128i numbers[4] = {
+			_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+			_mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero) };
+
+		for (int i = 0; i < 4; ++i)
+		{
+			outMasks[i] = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(numbers[i], bias), 23)));
+		}
+	}
+
+	// 32-bit masks, four cells per register: column masks are ORed across rows, and each
+	// row's masks are ORed together across its registers and lanes.
+	static bool IsLatinSquareSse2(const uint8_t* numbers, uint8_t gridSize)
+	{
+		const __m128i laneMask = GetLaneMask(gridSize);
+		const int vectorCount = (gridSize + 3) / 4;
+		const CandidateMask full = FullMask(gridSize);
+
+		__m128i columns[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			__m128i masks[4];
+			OneHotSse2(LoadRow(numbers, gridSize, y, laneMask), masks);
+
+			__m128i row = _mm_setzero_si128();
+			for (int i = 0; i < vectorCount; ++i)
+			{
+				columns[i] = _mm_or_si128(columns[i], masks[i]);
+				row = _mm_or_si128(row, masks[i]);
+			}
+
+			row = _mm_or_si128(row, _mm_shuffle_epi32(row, _MM_SHUFFLE(1, 0, 3, 2)));
+			row = _mm_or_si128(row, _mm_shuffle_epi32(row, _MM_SHUFFLE(2, 3, 0, 1)));
+			if ((uint32_t)_mm_cvtsi128_si32(row) != full)
+			{
+				return false;
+			}
+		}
+
+		const __m128i fullVector = _mm_set1_epi32(full);
+		uint32_t fullColumns = 0;
+		for (int i = 0; i < vectorCount; ++i)
+		{
+			fullColumns |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(columns[i], fullVector))) << (4 * i);
+		}
+
+		return (fullColumns & full) == full;
+	}
+
+	// One-hot masks from a byte shuffle on (number - 1): digits 1-8 land in the low byte plane,
+	// 9-16 in the high one, and empty cells (index 0xFF) in neither. Column masks are ORed
+	// across rows, row masks are ORed across the lanes of each row.
+	LATIN_CHECK_TARGET_AVX2
+	static bool IsLatinSquareAvx2(const uint8_t* numbers, uint8_t gridSize)
+	{
+		const __m128i laneMask = GetLaneMask(gridSize);
+
+		const __m256i lowTable = _mm256_setr_epi8(
+			1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+			1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i highTable = _mm256_setr_epi8(
+			0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128,
+			0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+
+		const CandidateMask full = FullMask(gridSize);
+		const __m256i lowFull = _mm256_set1_epi8((char)(full & 0xFF));
+		const __m256i highFull = _mm256_set1_epi8((char)(full >> 8));
+		const __m256i one = _mm256_set1_epi8(1);
+		const __m256i limit = _mm256_set1_epi8((char)gridSize);
+
+		__m256i inRange = _mm256_set1_epi8(-1);
+		__m256i colLow = _mm256_setzero_si256();
+		__m256i colHigh = _mm256_setzero_si256();
+
+		for (uint8_t y = 0; y < gridSize; y += 2)
+		{
+			// Rows y and y + 1, one per 128-bit lane. With an odd size the second is zeros.
+			const __m128i firstRow = LoadRow(numbers, gridSize, y, laneMask);
+			const __m128i secondRow = y + 1 < gridSize ? LoadRow(numbers, gridSize, y + 1, laneMask) : _mm_setzero_si128();
+			const __m256i cells = _mm256_inserti128_si256(_mm256_castsi128_si256(firstRow), secondRow, 1);
+			inRange = _mm256_and_si256(inRange, _mm256_cmpeq_epi8(_mm256_max_epu8(cells, limit), limit));
+
+			const __m256i index = _mm256_sub_epi8(cells, one);
+			const __m256i low = _mm256_shuffle_epi8(lowTable, index);
+			const __m256i high = _mm256_shuffle_epi8(highTable, index);
+			colLow = _mm256_or_si256(colLow, low);
+			colHigh = _mm256_or_si256(colHigh, high);
+
+			__m256i rowLow = low;
+			__m256i rowHigh = high;
+			rowLow = _mm256_or_si256(rowLow, _mm256_srli_si256(rowLow, 8));
+			rowHigh = _mm256_or_si256(rowHigh, _mm256_srli_si256(rowHigh, 8));
+			rowLow = _mm256_or_si256(rowLow, _mm256_srli_si256(rowLow, 4));
+			rowHigh = _mm256_or_si256(rowHigh, _mm256_srli_si256(rowHigh, 4));
+			rowLow = _mm256_or_si256(rowLow, _mm256_srli_si256(rowLow, 2));
+			rowHigh = _mm256_or_si256(rowHigh, _mm256_srli_si256(rowHigh, 2));
+			rowLow = _mm256_or_si256(rowLow, _mm256_srli_si256(rowLow, 1));
+			rowHigh = _mm256_or_si256(rowHigh, _mm256_srli_si256(rowHigh, 1));
+
+			const __m256i rowFull = _mm256_and_si256(_mm256_cmpeq_epi8(rowLow, lowFull), _mm256_cmpeq_epi8(rowHigh, highFull));
+			const uint32_t rowBits = (uint32_t)_mm256_movemask_epi8(rowFull);
+			const uint32_t needed = (y + 1 < gridSize) ? 0x10001u : 0x1u;
+			if ((rowBits & needed) != needed)
+			{
+				return false;
+			}
+		}
+
+		if ((uint32_t)_mm256_movemask_epi8(inRange) != 0xFFFFFFFFu)
+		{
+			return false;
+		}
+
+		const __m128i columnLow = _mm_or_si128(_mm256_castsi256_si128(colLow), _mm256_extracti128_si256(colLow, 1));
+		const __m128i columnHigh = _mm_or_si128(_mm256_castsi256_si128(colHigh), _mm256_extracti128_si256(colHigh, 1));
+		const __m128i colFull = _mm_and_si128(
+			_mm_cmpeq_epi8(columnLow, _mm256_castsi256_si128(lowFull)),
+			_mm_cmpeq_epi8(columnHigh, _mm256_castsi256_si128(highFull)));
+
+		const uint32_t lanes = full;
+		return ((uint32_t)_mm_movemask_epi8(colFull) & lanes) == lanes;
+	}
+#endif
+
+	static SimdLevel DetectSimdLevel()
+	{
+#if LATIN_CHECK_X64
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		const bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+		if (maxLeaf >= 7 && osSavesAvx)
+		{
+			__cpuidex(info, 7, 0);
+			if (info[1] & (1 << 5))
+			{
+				return SimdLevel::AVX2;
+			}
+		}
+		return SimdLevel::SSE2;
+	#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+	#endif
+#else
+		return SimdLevel::SCALAR;
+#endif
+	}
+
+	static LatinCheckFn GetKernel(SimdLevel level)
+	{
+		switch (level)
+		{
+#if LATIN_CHECK_X64
+		case SimdLevel::AVX2:
+			return IsLatinSquareAvx2;
+		case SimdLevel::SSE2:
+			return IsLatinSquareSse2;
+#endif
+		default:
+			return IsLatinSquareScalar;
+		}
+	}
+
+	static std::atomic<uint8_t>& GetLevelState()
+	{
+		static std::atomic<uint8_t> s_Level(LATIN_LEVEL_AUTO);
+		return s_Level;
+	}
+
+	static SimdLevel PickLevel(uint8_t gridSize)
+	{
+		const uint8_t forced = GetLevelState().load(std::memory_order_relaxed);
+		if (forced != LATIN_LEVEL_AUTO)
+		{
+			return (SimdLevel)forced;
+		}
+
+		const SimdLevel supported = GetSupportedSimdLevel();
+		if (supported == SimdLevel::AVX2 && gridSize >= LATIN_AVX2_MIN_GRID_SIZE)
+		{
+			return SimdLevel::AVX2;
+		}
+		if (supported != SimdLevel::SCALAR && gridSize >= LATIN_SSE2_MIN_GRID_SIZE)
+		{
+			return SimdLevel::SSE2;
+		}
+		return SimdLevel::SCALAR;
+	}
+
+	bool IsLatinSquare(const uint8_t* numbers, uint8_t gridSize)
+	{
+		if (gridSize == 0 || gridSize > LATIN_MAX_GRID_SIZE)
+		{
+			return false;
+		}
+
+		return GetKernel(PickLevel(gridSize))(numbers, gridSize);
+	}
+
+	size_t CheckLatinSquares(const uint8_t* boards, uint8_t gridSize, size_t boardCount, uint8_t* outValid)
+	{
+		if (gridSize == 0 || gridSize > LATIN_MAX_GRID_SIZE)
+		{
+			if (outValid)
+			{
+				memset(outValid, 0, boardCount);
+			}
+			return 0;
+		}
+
+		const LatinCheckFn check = GetKernel(PickLevel(gridSize));
+		const size_t cellCount = (size_t)gridSize * gridSize;
+
+		size_t validCount = 0;
+		for (size_t i = 0; i < boardCount; ++i)
+		{
+			const bool valid = check(boards + i * cellCount, gridSize);
+			validCount += valid;
+			if (outValid)
+			{
+				outValid[i] = valid;
+			}
+		}
+
+		return validCount;
+	}
+
+	SimdLevel GetLatinCheckLevel(uint8_t gridSize)
+	{
+		return PickLevel(gridSize);
+	}
+
+	SimdLevel SetLatinCheckLevel(SimdLevel level)
+	{
+		const SimdLevel supported = GetSupportedSimdLevel();
+		const SimdLevel used = (uint8_t)level <= (uint8_t)supported ? level : supported;
+		GetLevelState().store((uint8_t)used, std::memory_order_relaxed);
+		return used;
+	}
+
+	void ResetLatinCheckLevel()
+	{
+		GetLevelState().store(LATIN_LEVEL_AUTO, std::memory_order_relaxed);
+	}
+
+	SimdLevel GetSupportedSimdLevel()
+	{
+		static const SimdLevel s_Supported = DetectSimdLevel();
+		return s_Supported;
+	}
+
+	const char* ToString(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::SSE2:
+			return "SSE2";
+		case SimdLevel::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Solver
+{
+	enum class SimdLevel : uint8_t
+	{
+		SCALAR,
+		SSE2,
+		AVX2,
+	};
+
+	// True when every row and column of the board holds each digit 1..gridSize exactly once.
+	// numbers is row major, gridSize * gridSize bytes, with 0 for an empty cell.
+	bool IsLatinSquare(const uint8_t* numbers, uint8_t gridSize);
+
+	// Checks boardCount boards stored back to back. outValid[i] is set to 1 or 0 when given.
+	// Returns the number of valid boards.
+	size_t CheckLatinSquares(const uint8_t* boards, uint8_t gridSize, size_t boardCount, uint8_t* outValid = nullptr);
+
+	// By default the kernel is picked per grid size from the CPU's features: small boards use the
+	// scalar loop, which beats the SIMD kernels there. Setting a level forces that kernel at every
+	// size, falling back to the best one the CPU supports; returns the level in use. Reset goes back
+	// to picking per grid size.
+	SimdLevel GetLatinCheckLevel(uint8_t gridSize);
+	SimdLevel SetLatinCheckLevel(SimdLevel level);
+	void ResetLatinCheckLevel();
+	SimdLevel GetSupportedSimdLevel();
+
+	const char* ToString(SimdLevel level);
+}
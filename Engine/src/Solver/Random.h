@@ -0,0 +1,38 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Solver
+{
+	// SplitMix64. Used instead of <random> distributions so that a seed produces the same
+	// sequence with every standard library.
+	struct Random
+	{
+		uint64_t State = 0;
+
+		uint64_t Next()
+		{
+			uint64_t z = (State += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		uint32_t Below(uint32_t bound)
+		{
+			return (uint32_t)(Next() % bound);
+		}
+
+		template<typename T>
+		void Shuffle(T* items, size_t count)
+		{
+			for (size_t i = count; i > 1; --i)
+			{
+				const size_t j = Below((uint32_t)i);
+				T temp = items[i - 1];
+				items[i - 1] = items[j];
+				items[j] = temp;
+			}
+		}
+	};
+}
@@ -0,0 +1,510 @@
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Solver
+{
+	bool BoardSolver::Load(const Serialization::LevelData& levelData)
+	{
+		CandidateMask* root = BeginLoad(levelData.GridSize);
+		if (!root)
+		{
+			return false;
+		}
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (lockedCell.X >= m_GridSize || lockedCell.Y >= m_GridSize
+				|| lockedCell.Val == 0 || lockedCell.Val > m_GridSize)
+			{
+				return false;
+			}
+
+			root[lockedCell.Y * m_GridSize + lockedCell.X] &= DigitMask(lockedCell.Val);
+		}
+
+		return AddInequalities(levelData.GreaterThanConstraints) && FinishLoad();
+	}
+
+	bool BoardSolver::Load(const Serialization::BoardData& board, const std::vector<Serialization::GreaterThanConstraint>& constraints, bool includeEntered)
+	{
+		CandidateMask* root = BeginLoad(board.GridSize);
+		if (!root)
+		{
+			return false;
+		}
+
+		for (uint8_t y = 0; y < m_GridSize; ++y)
+		{
+			const uint8_t* numbers = board.Numbers.data() + (size_t)y * m_GridSize;
+			const uint16_t givenRow = includeEntered ? 0xFFFF : board.LockedRows[y];
+			for (uint8_t x = 0; x < m_GridSize; ++x)
+			{
+				if (numbers[x] == 0 || !((givenRow >> x) & 1))
+				{
+					continue;
+				}
+
+				if (numbers[x] > m_GridSize)
+				{
+					return false;
+				}
+
+				root[y * m_GridSize + x] &= DigitMask(numbers[x]);
+			}
+		}
+
+		return AddInequalities(constraints) && FinishLoad();
+	}
+
+	// Resets the search and returns the root candidates, all digits open, or nullptr for an unsupported size.
+	CandidateMask* BoardSolver::BeginLoad(uint8_t gridSize)
+	{
+		m_Stats = SolverStats{};
+		m_Stack.clear();
+		m_FirstSolution.clear();
+		m_SolutionCount = 0;
+		m_SearchFinished = true;
+		m_Inequalities.clear();
+		m_IsConsistent = false;
+
+		if (gridSize == 0 || gridSize > MAX_GRID_SIZE)
+		{
+			m_GridSize = 0;
+			m_CellCount = 0;
+			return nullptr;
+		}
+
+		if (m_GridSize != gridSize)
+		{
+			m_GridSize = gridSize;
+			m_CellCount = (size_t)m_GridSize * m_GridSize;
+
+			m_Units.resize(2 * m_CellCount);
+			for (uint8_t i = 0; i < m_GridSize; ++i)
+			{
+				for (uint8_t j = 0; j < m_GridSize; ++j)
+				{
+					m_Units[i * m_GridSize + j] = (uint16_t)(i * m_GridSize + j);
+					m_Units[m_CellCount + i * m_GridSize + j] = (uint16_t)(j * m_GridSize + i);
+				}
+			}
+
+			m_Masks.resize((m_CellCount + 1) * m_CellCount);
+		}
+
+		CandidateMask* root = GetLevel(0);
+		std::fill(root, root + m_CellCount, FullMask(m_GridSize));
+		return root;
+	}
+
+	bool BoardSolver::AddInequalities(const std::vector<Serialization::GreaterThanConstraint>& constraints)
+	{
+		for (const auto& constraint : constraints)
+		{
+			if (constraint.X1 >= m_GridSize || constraint.Y1 >= m_GridSize
+				|| constraint.X2 >= m_GridSize || constraint.Y2 >= m_GridSize)
+			{
+				return false;
+			}
+
+			Inequality& inequality = m_Inequalities.emplace_back();
+			inequality.Greater = (uint16_t)(constraint.Y1 * m_GridSize + constraint.X1);
+			inequality.Lesser = (uint16_t)(constraint.Y2 * m_GridSize + constraint.X2);
+		}
+
+		return true;
+	}
+
+	bool BoardSolver::FinishLoad()
+	{
+		m_IsConsistent = Propagate(GetLevel(0));
+		return m_IsConsistent;
+	}
+
+	bool BoardSolver::Solve(std::vector<uint8_t>& outSolution)
+	{
+		BeginSearch(1);
+		ContinueSearch();
+
+		if (m_SolutionCount == 0)
+		{
+			return false;
+		}
+
+		outSolution = m_FirstSolution;
+		return true;
+	}
+
+	size_t BoardSolver::CountSolutions(size_t solutionLimit)
+	{
+		BeginSearch(solutionLimit);
+		ContinueSearch();
+		return m_SolutionCount;
+	}
+
+	Uniqueness BoardSolver::CheckUniqueness()
+	{
+		CountSolutions(2);
+		return GetUniqueness();
+	}
+
+	void BoardSolver::SetGuessSeed(uint64_t seed)
+	{
+		m_RandomizeGuesses = seed != 0;
+		m_GuessRandom.State = seed;
+	}
+
+	uint8_t BoardSolver::GetGridSize() const
+	{
+		return m_GridSize;
+	}
+
+	const SolverStats& BoardSolver::GetStats() const
+	{
+		return m_Stats;
+	}
+
+	void BoardSolver::BeginSearch(size_t solutionLimit)
+	{
+		m_Stack.clear();
+		m_FirstSolution.clear();
+		m_SolutionLimit = solutionLimit;
+		m_SolutionCount = 0;
+		m_SearchFinished = true;
+
+		if (!m_IsConsistent || solutionLimit == 0)
+		{
+			return;
+		}
+
+		const CandidateMask* root = GetLevel(0);
+		const int rootCell = SelectCell(root);
+		if (rootCell < 0)
+		{
+			StoreSolution(root, m_FirstSolution);
+			m_SolutionCount = 1;
+			return;
+		}
+
+		m_Stack.push_back(SearchFrame{ (uint16_t)rootCell, root[rootCell] });
+		m_SearchFinished = false;
+	}
+
+	bool BoardSolver::ContinueSearch(float timeBudgetMs)
+	{
+		// Reading the clock is not free, so it is only checked every few guesses.
+		const uint32_t CLOCK_CHECK_INTERVAL = 32;
+
+		const auto start = std::chrono::steady_clock::now();
+		uint32_t guessesSinceClockCheck = 0;
+
+		while (!m_Stack.empty())
+		{
+			if (timeBudgetMs > 0.0f && ++guessesSinceClockCheck == CLOCK_CHECK_INTERVAL)
+			{
+				guessesSinceClockCheck = 0;
+				const std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+				if (elapsed.count() >= timeBudgetMs)
+				{
+					return false;
+				}
+			}
+
+			const size_t depth = m_Stack.size() - 1;
+			SearchFrame& frame = m_Stack.back();
+			if (frame.Remaining == 0)
+			{
+				m_Stack.pop_back();
+				continue;
+			}
+
+			const CandidateMask guess = PickGuess(frame.Remaining);
+			frame.Remaining &= ~guess;
+
+			const CandidateMask* current = GetLevel(depth);
+			CandidateMask* next = GetLevel(depth + 1);
+			std::copy(current, current + m_CellCount, next);
+			next[frame.Cell] = guess;
+			m_Stats.Nodes++;
+
+			if (!Propagate(next))
+			{
+				m_Stats.Backtracks++;
+				continue;
+			}
+
+			const int nextCell = SelectCell(next);
+			if (nextCell < 0)
+			{
+				m_SolutionCount++;
+				if (m_SolutionCount == 1)
+				{
+					StoreSolution(next, m_FirstSolution);
+				}
+
+				if (m_SolutionCount >= m_SolutionLimit)
+				{
+					m_Stack.clear();
+				}
+				continue;
+			}
+
+			m_Stack.push_back(SearchFrame{ (uint16_t)nextCell, next[nextCell] });
+		}
+
+		m_SearchFinished = true;
+		return true;
+	}
+
+	bool BoardSolver::IsSearchFinished() const
+	{
+		return m_SearchFinished;
+	}
+
+	size_t BoardSolver::GetSolutionCount() const
+	{
+		return m_SolutionCount;
+	}
+
+	Uniqueness BoardSolver::GetUniqueness() const
+	{
+		if (!m_SearchFinished && m_SolutionCount < 2)
+		{
+			return Uniqueness::UNKNOWN;
+		}
+
+		switch (m_SolutionCount)
+		{
+		case 0:
+			return Uniqueness::NO_SOLUTION;
+		case 1:
+			return m_SolutionLimit > 1 ? Uniqueness::UNIQUE : Uniqueness::UNKNOWN;
+		default:
+			return Uniqueness::MULTIPLE;
+		}
+	}
+
+	const std::vector<uint8_t>& BoardSolver::GetFirstSolution() const
+	{
+		return m_FirstSolution;
+	}
+
+	bool BoardSolver::Propagate(CandidateMask* masks)
+	{
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+
+			for (size_t unit = 0; unit < 2 * (size_t)m_GridSize; ++unit)
+			{
+				if (!PropagateUnit(masks, &m_Units[unit * m_GridSize], changed))
+				{
+					return false;
+				}
+			}
+
+			if (!PropagateInequalities(masks, changed))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool BoardSolver::PropagateUnit(CandidateMask* masks, const uint16_t* unit, bool& changed)
+	{
+		// fixed: digits already placed, once/twice: digits possible in at least one/two cells.
+		CandidateMask fixed = 0, once = 0, twice = 0;
+		for (uint8_t i = 0; i < m_GridSize; ++i)
+		{
+			const CandidateMask mask = masks[unit[i]];
+			if (mask == 0)
+			{
+				return false;
+			}
+
+			if (IsSingle(mask))
+			{
+				if (fixed & mask)
+				{
+					return false;
+				}
+				fixed |= mask;
+			}
+
+			twice |= once & mask;
+			once |= mask;
+		}
+
+		if (once != FullMask(m_GridSize))
+		{
+			return false;
+		}
+
+		// Digits with exactly one possible cell left in this unit
+		const CandidateMask hiddenSingles = once & ~twice & ~fixed;
+
+		for (uint8_t i = 0; i < m_GridSize; ++i)
+		{
+			CandidateMask& mask = masks[unit[i]];
+			if (IsSingle(mask))
+			{
+				continue;
+			}
+
+			CandidateMask narrowed = mask & ~fixed;
+			const CandidateMask hidden = narrowed & hiddenSingles;
+			if (hidden)
+			{
+				if (!IsSingle(hidden))
+				{
+					return false;
+				}
+				narrowed = hidden;
+			}
+
+			if (narrowed != mask)
+			{
+				if (narrowed == 0)
+				{
+					return false;
+				}
+
+				mask = narrowed;
+				changed = true;
+				m_Stats.Propagations++;
+			}
+		}
+
+		return true;
+	}
+
+	bool BoardSolver::PropagateInequalities(CandidateMask* masks, bool& changed)
+	{
+		for (const auto& inequality : m_Inequalities)
+		{
+			CandidateMask& greater = masks[inequality.Greater];
+			CandidateMask& lesser = masks[inequality.Lesser];
+
+			// greater > min(lesser) and lesser < max(greater)
+			const CandidateMask greaterNarrowed = greater & GreaterBound(lesser);
+			const CandidateMask lesserNarrowed = lesser & LesserBound(greaterNarrowed);
+
+			if (greaterNarrowed == 0 || lesserNarrowed == 0)
+			{
+				return false;
+			}
+
+			if (greaterNarrowed != greater)
+			{
+				greater = greaterNarrowed;
+				changed = true;
+				m_Stats.Propagations++;
+			}
+
+			if (lesserNarrowed != lesser)
+			{
+				lesser = lesserNarrowed;
+				changed = true;
+				m_Stats.Propagations++;
+			}
+		}
+
+		return true;
+	}
+
+	int BoardSolver::SelectCell(const CandidateMask* masks) const
+	{
+		int bestCell = -1;
+		uint8_t bestCount = MAX_GRID_SIZE + 1;
+		for (size_t cell = 0; cell < m_CellCount; ++cell)
+		{
+			const uint8_t count = CountCandidates(masks[cell]);
+			if (count > 1 && count < bestCount)
+			{
+				bestCell = (int)cell;
+				bestCount = count;
+				if (count == 2)
+				{
+					break;
+				}
+			}
+		}
+
+		return bestCell;
+	}
+
+	CandidateMask BoardSolver::PickGuess(CandidateMask remaining)
+	{
+		if (!m_RandomizeGuesses)
+		{
+			return LowestBit(remaining);
+		}
+
+		uint32_t skip = m_GuessRandom.Below(CountCandidates(remaining));
+		while (skip--)
+		{
+			remaining &= remaining - 1;
+		}
+
+		return LowestBit(remaining);
+	}
+
+	CandidateMask* BoardSolver::GetLevel(size_t depth)
+	{
+		return &m_Masks[depth * m_CellCount];
+	}
+
+	void BoardSolver::StoreSolution(const CandidateMask* masks, std::vector<uint8_t>& outSolution) const
+	{
+		outSolution.resize(m_CellCount);
+		for (size_t cell = 0; cell < m_CellCount; ++cell)
+		{
+			outSolution[cell] = MaskToDigit(masks[cell]);
+		}
+	}
+
+	bool Solve(const Serialization::LevelData& levelData, std::vector<uint8_t>& outSolution, SolverStats* outStats)
+	{
+		BoardSolver solver;
+		const bool solved = solver.Load(levelData) && solver.Solve(outSolution);
+
+		if (outStats)
+		{
+			*outStats = solver.GetStats();
+		}
+
+		return solved;
+	}
+
+	size_t CountSolutions(const Serialization::LevelData& levelData, size_t solutionLimit, SolverStats* outStats)
+	{
+		BoardSolver solver;
+		const size_t solutionCount = solver.Load(levelData) ? solver.CountSolutions(solutionLimit) : 0;
+
+		if (outStats)
+		{
+			*outStats = solver.GetStats();
+		}
+
+		return solutionCount;
+	}
+
+	const char* ToString(Uniqueness uniqueness)
+	{
+		switch (uniqueness)
+		{
+		case Uniqueness::NO_SOLUTION:
+			return "No Solution";
+		case Uniqueness::UNIQUE:
+			return "Unique";
+		case Uniqueness::MULTIPLE:
+			return "Multiple Solutions";
+		default:
+			return "Checking...";
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "CandidateMask.h"
+#include "Random.h"
+#include "Serialization/LevelData.h"
+#include "Serialization/BoardData.h"
+
+namespace Solver
+{
+	struct SolverStats
+	{
+		uint64_t Nodes = 0;        // Guesses made by the search
+		uint64_t Propagations = 0; // Candidate masks narrowed by propagation
+		uint64_t Backtracks = 0;   // Guesses that ran into a contradiction
+	};
+
+	enum class Uniqueness : uint8_t
+	{
+		UNKNOWN,
+		NO_SOLUTION,
+		UNIQUE,
+		MULTIPLE,
+	};
+
+	// Candidate-bitmask solver: all-different and inequality propagation, MRV-ordered backtracking.
+	// Scratch memory is kept between calls, so reusing one instance avoids allocations.
+	class BoardSolver
+	{
+	public:
+		static const uint8_t MAX_GRID_SIZE = 16;
+
+		// Returns false if the level data is malformed or contradicts itself.
+		bool Load(const Serialization::LevelData& levelData);
+
+		// Givens are the board's locked cells, plus its other numbers when includeEntered is set.
+		bool Load(const Serialization::BoardData& board, const std::vector<Serialization::GreaterThanConstraint>& constraints, bool includeEntered = false);
+
+		// outSolution is filled row major with GridSize * GridSize numbers.
+		bool Solve(std::vector<uint8_t>& outSolution);
+
+		// Counts solutions, stopping as soon as solutionLimit of them have been found.
+		size_t CountSolutions(size_t solutionLimit);
+		Uniqueness CheckUniqueness();
+
+		// Resumable search, so long searches can be spread over several frames.
+		// ContinueSearch returns true once the search has finished; a budget <= 0 runs to completion.
+		void BeginSearch(size_t solutionLimit);
+		bool ContinueSearch(float timeBudgetMs = 0.0f);
+		bool IsSearchFinished() const;
+		size_t GetSolutionCount() const;
+		Uniqueness GetUniqueness() const;
+		const std::vector<uint8_t>& GetFirstSolution() const;
+
+		// A non-zero seed makes the search try candidates in a random order instead of lowest first.
+		void SetGuessSeed(uint64_t seed);
+
+		uint8_t GetGridSize() const;
+		const SolverStats& GetStats() const;
+
+	private:
+		struct Inequality
+		{
+			uint16_t Greater;
+			uint16_t Lesser;
+		};
+
+		struct SearchFrame
+		{
+			uint16_t Cell;
+			CandidateMask Remaining;
+		};
+
+		CandidateMask* BeginLoad(uint8_t gridSize);
+		bool AddInequalities(const std::vector<Serialization::GreaterThanConstraint>& constraints);
+		bool FinishLoad();
+
+		bool Propagate(CandidateMask* masks);
+		bool PropagateUnit(CandidateMask* masks, const uint16_t* unit, bool& changed);
+		bool PropagateInequalities(CandidateMask* masks, bool& changed);
+		int SelectCell(const CandidateMask* masks) const;
+
+		CandidateMask PickGuess(CandidateMask remaining);
+		CandidateMask* GetLevel(size_t depth);
+		void StoreSolution(const CandidateMask* masks, std::vector<uint8_t>& outSolution) const;
+
+	private:
+		uint8_t m_GridSize = 0;
+		size_t m_CellCount = 0;
+		bool m_IsConsistent = false;
+
+		std::vector<uint16_t> m_Units; // GridSize rows followed by GridSize columns
+		std::vector<Inequality> m_Inequalities;
+		std::vector<CandidateMask> m_Masks; // One board of candidates per search depth
+		std::vector<SearchFrame> m_Stack;
+
+		size_t m_SolutionLimit = 0;
+		size_t m_SolutionCount = 0;
+		bool m_SearchFinished = true;
+		std::vector<uint8_t> m_FirstSolution;
+
+		bool m_RandomizeGuesses = false;
+		Random m_GuessRandom;
+
+		SolverStats m_Stats;
+	};
+
+	bool Solve(const Serialization::LevelData& levelData, std::vector<uint8_t>& outSolution, SolverStats* outStats = nullptr);
+	size_t CountSolutions(const Serialization::LevelData& levelData, size_t solutionLimit, SolverStats* outStats = nullptr);
+
+	const char* ToString(Uniqueness uniqueness);
+}
@@ -0,0 +1,204 @@
+#include "Verify.h"
+
+#include "CandidateMask.h"
+#include "LatinCheck.h"
+
+namespace Solver
+{
+	static void MarkBit(uint16_t& mask, uint8_t bit)
+	{
+		mask |= (uint16_t)(1u << bit);
+	}
+
+	static bool IsLevelValid(const Serialization::LevelData& levelData)
+	{
+		const uint8_t gridSize = levelData.GridSize;
+		if (gridSize == 0 || gridSize > VERIFY_MAX_GRID_SIZE)
+		{
+			return false;
+		}
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (lockedCell.X >= gridSize || lockedCell.Y >= gridSize || lockedCell.Val == 0 || lockedCell.Val > gridSize)
+			{
+				return false;
+			}
+		}
+
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			if (constraint.X1 >= gridSize || constraint.Y1 >= gridSize || constraint.X2 >= gridSize || constraint.Y2 >= gridSize)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Duplicates are marked as the grid marks them; empty and out-of-range cells are marked on top.
+	static void CheckLatinProperty(const uint8_t* board, uint8_t gridSize, VerifyResult& result)
+	{
+		CandidateMask colSeen[VERIFY_MAX_GRID_SIZE] = { 0 };
+		CandidateMask colDuplicates[VERIFY_MAX_GRID_SIZE] = { 0 };
+		CandidateMask rowDuplicates[VERIFY_MAX_GRID_SIZE] = { 0 };
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			CandidateMask rowSeen = 0;
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint8_t number = board[y * gridSize + x];
+				if (number == 0)
+				{
+					result.Errors |= (uint8_t)VerifyError::INCOMPLETE;
+					MarkBit(result.CellErrors[y], x);
+					continue;
+				}
+
+				if (number > gridSize)
+				{
+					result.Errors |= (uint8_t)VerifyError::OUT_OF_RANGE;
+					MarkBit(result.CellErrors[y], x);
+					continue;
+				}
+
+				const CandidateMask bit = DigitMask(number);
+				rowDuplicates[y] |= rowSeen & bit;
+				rowSeen |= bit;
+				colDuplicates[x] |= colSeen[x] & bit;
+				colSeen[x] |= bit;
+			}
+		}
+
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			if (rowDuplicates[y])
+			{
+				MarkBit(result.RowErrors, y);
+			}
+
+			if (colDuplicates[y])
+			{
+				MarkBit(result.ColErrors, y);
+			}
+		}
+
+		if (result.RowErrors == 0 && result.ColErrors == 0)
+		{
+			return;
+		}
+
+		result.Errors |= (uint8_t)VerifyError::DUPLICATE;
+		for (uint8_t y = 0; y < gridSize; ++y)
+		{
+			for (uint8_t x = 0; x < gridSize; ++x)
+			{
+				const uint8_t number = board[y * gridSize + x];
+				if (number <= gridSize && ((rowDuplicates[y] | colDuplicates[x]) & DigitMask(number)))
+				{
+					MarkBit(result.CellErrors[y], x);
+				}
+			}
+		}
+	}
+
+	static VerifyResult VerifyBoard(const Serialization::LevelData& levelData, const uint8_t* board)
+	{
+		VerifyResult result;
+		const uint8_t gridSize = levelData.GridSize;
+
+		for (const auto& lockedCell : levelData.LockedCells)
+		{
+			if (board[lockedCell.Y * gridSize + lockedCell.X] != lockedCell.Val)
+			{
+				result.Errors |= (uint8_t)VerifyError::GIVEN_CHANGED;
+				MarkBit(result.CellErrors[lockedCell.Y], lockedCell.X);
+			}
+		}
+
+		// Empty cells satisfy a constraint, as they do on the grid; they are reported as incomplete instead.
+		for (const auto& constraint : levelData.GreaterThanConstraints)
+		{
+			const uint8_t number1 = board[constraint.Y1 * gridSize + constraint.X1];
+			const uint8_t number2 = board[constraint.Y2 * gridSize + constraint.X2];
+			if (number1 == 0 || number2 == 0 || number1 > number2)
+			{
+				continue;
+			}
+
+			result.Errors |= (uint8_t)VerifyError::CONSTRAINT_VIOLATED;
+			MarkBit(result.CellErrors[constraint.Y1], constraint.X1);
+			MarkBit(result.CellErrors[constraint.Y2], constraint.X2);
+
+			if (constraint.Y1 == constraint.Y2)
+			{
+				MarkBit(result.RowErrors, constraint.Y1);
+			}
+
+			if (constraint.X1 == constraint.X2)
+			{
+				MarkBit(result.ColErrors, constraint.X1);
+			}
+		}
+
+		// Most submissions are solutions, for which the vectorised check is all that is needed.
+		if (!IsLatinSquare(board, gridSize))
+		{
+			CheckLatinProperty(board, gridSize, result);
+		}
+
+		return result;
+	}
+
+	static VerifyResult InvalidLevelResult()
+	{
+		VerifyResult result;
+		result.Errors = (uint8_t)VerifyError::INVALID_LEVEL;
+		return result;
+	}
+
+	VerifyResult Verify(const Serialization::LevelData& levelData, const uint8_t* board)
+	{
+		if (!board || !IsLevelValid(levelData))
+		{
+			return InvalidLevelResult();
+		}
+
+		return VerifyBoard(levelData, board);
+	}
+
+	size_t VerifyBatch(const VerifyRequest* requests, size_t requestCount, VerifyResult* outResults)
+	{
+		size_t validCount = 0;
+		for (size_t i = 0; i < requestCount; ++i)
+		{
+			const VerifyResult result = Verify(*requests[i].Level, requests[i].Board);
+			validCount += result.IsValid();
+			if (outResults)
+			{
+				outResults[i] = result;
+			}
+		}
+		return validCount;
+	}
+
+	size_t VerifyBatch(const Serialization::LevelData& levelData, const uint8_t* boards, size_t boardCount, VerifyResult* outResults)
+	{
+		const size_t cellCount = (size_t)levelData.GridSize * levelData.GridSize;
+		const bool levelValid = boards && IsLevelValid(levelData);
+
+		size_t validCount = 0;
+		for (size_t i = 0; i < boardCount; ++i)
+		{
+			const VerifyResult result = levelValid ? VerifyBoard(levelData, boards + i * cellCount) : InvalidLevelResult();
+			validCount += result.IsValid();
+			if (outResults)
+			{
+				outResults[i] = result;
+			}
+		}
+		return validCount;
+	}
+}
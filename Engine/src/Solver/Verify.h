@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+
+#include "Serialization/LevelData.h"
+
+namespace Solver
+{
+	static const uint8_t VERIFY_MAX_GRID_SIZE = 16;
+
+	// Bits of VerifyResult::Errors.
+	enum class VerifyError : uint8_t
+	{
+		NONE = 0,
+		INVALID_LEVEL = 1 << 0,        // Grid size, a given or a constraint is out of range; nothing else is checked
+		INCOMPLETE = 1 << 1,           // Empty cells
+		OUT_OF_RANGE = 1 << 2,         // Numbers above the grid size
+		GIVEN_CHANGED = 1 << 3,        // A locked cell holds another number
+		DUPLICATE = 1 << 4,            // A digit repeats in a row or column
+		CONSTRAINT_VIOLATED = 1 << 5,  // A greater-than constraint does not hold
+	};
+
+	// Error locations use the grid's layout: one bit per row, per column, and per cell of each row.
+	// Duplicates and violated constraints are marked exactly as the grid marks them while playing;
+	// empty, out-of-range and changed given cells are marked on top.
+	struct VerifyResult
+	{
+		uint8_t Errors = 0;
+		uint16_t RowErrors = 0;
+		uint16_t ColErrors = 0;
+		std::array<uint16_t, VERIFY_MAX_GRID_SIZE> CellErrors{};
+
+		bool IsValid() const { return Errors == 0; }
+		bool HasError(VerifyError error) const { return (Errors & (uint8_t)error) != 0; }
+		bool CheckRowHasError(uint8_t row) const { return (RowErrors >> row) & 1; }
+		bool CheckColHasError(uint8_t col) const { return (ColErrors >> col) & 1; }
+		bool CheckCellHasError(uint8_t x, uint8_t y) const { return (CellErrors[y] >> x) & 1; }
+	};
+
+	struct VerifyRequest
+	{
+		const Serialization::LevelData* Level;
+		const uint8_t* Board; // Row major, GridSize * GridSize numbers
+	};
+
+	// Checks a submitted board against its level: givens, greater-than constraints and
+	// the Latin property. Stateless and allocation free, so it can run on any thread.
+	VerifyResult Verify(const Serialization::LevelData& levelData, const uint8_t* board);
+
+	// outResults, when given, receives one result per request. Returns the number of valid boards.
+	size_t VerifyBatch(const VerifyRequest* requests, size_t requestCount, VerifyResult* outResults = nullptr);
+
+	// Many boards for one level, stored back to back.
+	size_t VerifyBatch(const Serialization::LevelData& levelData, const uint8_t* boards, size_t boardCount, VerifyResult* outResults = nullptr);
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <stddef.h>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace Solver
+{
+	// One deque per worker. Workers take jobs from the back of their own deque and,
+	// once it is empty, steal from the front of the others'.
+	template<typename Job>
+	class WorkStealingQueue
+	{
+	public:
+		explicit WorkStealingQueue(size_t workerCount)
+		{
+			for (size_t i = 0; i < workerCount; ++i)
+			{
+				m_Deques.push_back(std::make_unique<WorkerDeque>());
+			}
+		}
+
+		void Push(size_t worker, const Job& job)
+		{
+			WorkerDeque& deque = *m_Deques[worker];
+			std::lock_guard<std::mutex> lock(deque.Mutex);
+			deque.Jobs.push_back(job);
+		}
+
+		bool Pop(size_t worker, Job& outJob)
+		{
+			WorkerDeque& deque = *m_Deques[worker];
+			std::lock_guard<std::mutex> lock(deque.Mutex);
+			if (deque.Jobs.empty())
+			{
+				return false;
+			}
+
+			outJob = deque.Jobs.back();
+			deque.Jobs.pop_back();
+			return true;
+		}
+
+		bool Steal(size_t thief, Job& outJob)
+		{
+			for (size_t offset = 1; offset < m_Deques.size(); ++offset)
+			{
+				WorkerDeque& deque = *m_Deques[(thief + offset) % m_Deques.size()];
+				std::lock_guard<std::mutex> lock(deque.Mutex);
+				if (!deque.Jobs.empty())
+				{
+					outJob = deque.Jobs.front();
+					deque.Jobs.pop_front();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		size_t GetWorkerCount() const
+		{
+			return m_Deques.size();
+		}
+
+	private:
+		struct WorkerDeque
+		{
+			std::mutex Mutex;
+			std::deque<Job> Jobs;
+		};
+
+		std::vector<std::unique_ptr<WorkerDeque>> m_Deques;
+	};
+}